@@ -1,20 +1,44 @@
+#include <ccsd/mpi/communicator.h>
+#include <ccsd/mpi/rma_window.h>
 #include <ccsd/solver/ccsd_solver.h>
+#include <util/memory/memory_registry.h>
 #include <util/timing/percentile.h>
+#include <util/timing/phase_profile.h>
+#include <util/timing/stats.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <string>
+#include <vector>
 
 namespace {
 
 struct Args {
     int         batch  = 100;
     int         warmup = 10;
+    int         groups = 1;   // independent solves running side by side
+    std::size_t chunk_doubles = ccsd::constants::mpi_chunk_doubles;
+    bool        counters = false;   // hardware counters per phase (perf_event_open)
+    std::vector<ccsd::Method> methods;   // --methods mp2,ccd,...: cost of each, after the CCSD batch
+    double      screening = 0.0;         // --screening THR: also time a screened CCSD batch
     std::string report;
 };
 
+std::vector<ccsd::Method> parse_methods(const std::string& list) {
+    std::vector<ccsd::Method> out;
+    std::size_t begin = 0;
+    while (begin <= list.size()) {
+        const std::size_t end = std::min(list.find(',', begin), list.size());
+        if (end > begin) out.push_back(ccsd::parse_method(list.substr(begin, end - begin)));
+        begin = end + 1;
+    }
+    return out;
+}
+
 Args parse_args(int argc, char** argv) {
     Args a;
     for (int i = 1; i < argc; ++i) {
@@ -22,6 +46,16 @@ Args parse_args(int argc, char** argv) {
             a.batch = std::atoi(argv[++i]);
         } else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
             a.warmup = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--groups") == 0 && i + 1 < argc) {
+            a.groups = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--chunk-doubles") == 0 && i + 1 < argc) {
+            a.chunk_doubles = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--counters") == 0) {
+            a.counters = true;
+        } else if (std::strcmp(argv[i], "--screening") == 0 && i + 1 < argc) {
+            a.screening = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--methods") == 0 && i + 1 < argc) {
+            a.methods = parse_methods(argv[++i]);
         } else if (std::strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
             a.report = argv[++i];
         }
@@ -29,48 +63,310 @@ Args parse_args(int argc, char** argv) {
     return a;
 }
 
-void attach_session(CcsdSolver& solver, const ccsd::MpiSession& session) {
-    solver.attach(session);
-}
-
-void run_warmup(const ccsd::MpiSession& session, int k) {
+void run_warmup(MPI_Comm comm, ccsd::mpi::RmaWindow& window, const Args& args, int k) {
     for (int i = 0; i < k; ++i) {
         CcsdSolver solver;
-        attach_session(solver, session);
+        solver.attach(comm, &window);
+        solver.orchestrator.transfer.chunk_doubles = args.chunk_doubles;
         solver.run();
     }
 }
 
-void run_timed(const ccsd::MpiSession& session, int n,
-               ccsd::timing::PercentileAccumulator& acc) {
+void run_timed(MPI_Comm comm, ccsd::mpi::RmaWindow& window, const Args& args, int n,
+               ccsd::timing::PercentileAccumulator& acc,
+               ccsd::timing::PhaseProfile& phases,
+               ccsd::memory::MemoryRegistry& tensors, double& e_corr) {
     for (int i = 0; i < n; ++i) {
         CcsdSolver solver;
-        attach_session(solver, session);
+        solver.attach(comm, &window);
+        solver.orchestrator.transfer.chunk_doubles = args.chunk_doubles;
+        solver.profile = &phases;
+        acc.start();
+        solver.run();
+        acc.stop();
+        tensors = solver.memory();
+        e_corr  = solver.result().e_corr;
+    }
+}
+
+// Cost of one method over its own batch: wall time per solve, and the
+// analytic flops of one solve summed over the ranks.
+struct MethodCost {
+    ccsd::Method method = ccsd::Method::ccsd;
+    ccsd::timing::SampleStats run;
+    double flops      = 0.0;
+    int    iterations = 0;
+    double e_corr     = 0.0;
+    ccsd::ScreeningStats screening;   // of the last solve
+};
+
+MethodCost time_method(MPI_Comm comm, ccsd::mpi::RmaWindow& window, const Args& args, ccsd::Method method,
+                       double screening = 0.0) {
+    ccsd::timing::PercentileAccumulator acc;
+    ccsd::timing::PhaseProfile phases(ccsd::solver_phase_names());
+    MethodCost cost;
+    cost.method = method;
+    for (int i = 0; i < args.batch; ++i) {
+        CcsdSolver solver;
+        solver.attach(comm, &window);
+        solver.orchestrator.transfer.chunk_doubles = args.chunk_doubles;
+        solver.method = method;
+        solver.screening_threshold = screening;
+        solver.verbose = false;
+        solver.profile = &phases;
         acc.start();
         solver.run();
         acc.stop();
+        cost.iterations = solver.result().iterations;
+        cost.e_corr     = solver.result().e_corr;
+        cost.screening  = solver.result().screening;
+    }
+    for (std::size_t i = 0; i < phases.size(); ++i) cost.flops += phases.work(i);
+    MPI_Allreduce(MPI_IN_PLACE, &cost.flops, 1, MPI_DOUBLE, MPI_SUM, comm);
+    cost.flops /= std::max(args.batch, 1);
+    cost.run = acc.summary();
+    return cost;
+}
+
+void print_methods(const std::vector<MethodCost>& costs) {
+    std::printf("  %-8s %12s %6s %14s %16s\n", "method", "p50 us", "iters", "flops", "E(corr)");
+    for (const MethodCost& c : costs)
+        std::printf("  %-8s %12.0f %6d %14.0f %16.10f\n", ccsd::method_name(c.method),
+                    c.run.p50, c.iterations, c.flops, c.e_corr);
+}
+
+// The screened batch against the unscreened CCSD batch of the same run.
+void print_screening(double threshold, const MethodCost& c, double p50_full, double e_full) {
+    std::printf("  screening %.1e: p50=%.0f us (%.0f unscreened)  skipped %.1f%% of the screened work"
+                "  energy error %.3e\n",
+                threshold, c.run.p50, p50_full, 100.0 * c.screening.fraction(), c.e_corr - e_full);
+}
+
+// Per-rank tensor bytes and peak RSS, gathered over all world ranks.
+struct MemoryReport {
+    ccsd::memory::MemoryRegistry tensors;     // rank 0's breakdown
+    std::vector<unsigned long long> tensor_bytes;   // per world rank
+    std::vector<unsigned long long> peak_rss;       // per world rank
+};
+
+MemoryReport gather_memory(const ccsd::memory::MemoryRegistry& tensors, MPI_Comm comm) {
+    int size = 0;
+    MPI_Comm_size(comm, &size);
+    MemoryReport m;
+    m.tensors = tensors;
+    m.tensor_bytes.resize(static_cast<std::size_t>(size));
+    m.peak_rss.resize(static_cast<std::size_t>(size));
+    const unsigned long long local[2] = {tensors.total_bytes(), ccsd::memory::peak_rss_bytes()};
+    MPI_Gather(&local[0], 1, MPI_UNSIGNED_LONG_LONG, m.tensor_bytes.data(), 1, MPI_UNSIGNED_LONG_LONG, 0, comm);
+    MPI_Gather(&local[1], 1, MPI_UNSIGNED_LONG_LONG, m.peak_rss.data(), 1, MPI_UNSIGNED_LONG_LONG, 0, comm);
+    return m;
+}
+
+// Replaces each phase sample on rank 0 of `comm` by its maximum over ranks,
+// i.e. the critical-path time of that phase in that run.
+void reduce_phases_max(ccsd::timing::PhaseProfile& phases, MPI_Comm comm) {
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+    for (std::size_t i = 0; i < phases.size(); ++i) {
+        auto& v = phases.phase(i).samples();
+        if (rank == 0)
+            MPI_Reduce(MPI_IN_PLACE, v.data(), static_cast<int>(v.size()), MPI_DOUBLE, MPI_MAX, 0, comm);
+        else
+            MPI_Reduce(v.data(), nullptr, static_cast<int>(v.size()), MPI_DOUBLE, MPI_MAX, 0, comm);
+    }
+}
+
+// Per-phase hardware counters and analytic flops, summed over the ranks of
+// `comm`. `available` is true only if every rank opened its counters.
+struct PhaseCounters {
+    bool                                   available = false;
+    std::vector<ccsd::timing::PerfSample>  hw;
+    std::vector<double>                    flops;
+};
+
+PhaseCounters reduce_counters_sum(const ccsd::timing::PhaseProfile& phases, MPI_Comm comm) {
+    PhaseCounters out;
+    const std::size_t n = phases.size();
+    int ok = phases.counters() != nullptr ? 1 : 0;
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+    out.available = ok != 0;
+
+    std::vector<std::uint64_t> hw(4 * n);
+    out.flops.assign(n, 0.0);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& s = phases.hw(i);
+        hw[4 * i + 0] = s.cycles;
+        hw[4 * i + 1] = s.instructions;
+        hw[4 * i + 2] = s.llc_misses;
+        hw[4 * i + 3] = s.fp_ops;
+        out.flops[i]  = phases.work(i);
     }
+    MPI_Allreduce(MPI_IN_PLACE, hw.data(), static_cast<int>(hw.size()), MPI_UINT64_T, MPI_SUM, comm);
+    MPI_Allreduce(MPI_IN_PLACE, out.flops.data(), static_cast<int>(n), MPI_DOUBLE, MPI_SUM, comm);
+    out.hw.assign(n, {});
+    for (std::size_t i = 0; i < n; ++i)
+        out.hw[i] = {hw[4 * i + 0], hw[4 * i + 1], hw[4 * i + 2], hw[4 * i + 3]};
+    return out;
+}
+
+// Derived roofline coordinates of one phase. Bytes are approximated by LLC
+// misses × 64 B lines; time is the sum of the per-run critical-path samples.
+struct Roofline {
+    double ipc = 0.0, flops_per_byte = 0.0, gflops = 0.0;
+};
+
+Roofline roofline(const ccsd::timing::PerfSample& hw, double flops, double phase_us) {
+    constexpr double line_bytes = 64.0;
+    Roofline r;
+    if (hw.cycles > 0) r.ipc = static_cast<double>(hw.instructions) / static_cast<double>(hw.cycles);
+    if (hw.llc_misses > 0) r.flops_per_byte = flops / (static_cast<double>(hw.llc_misses) * line_bytes);
+    if (phase_us > 0.0) r.gflops = flops / (phase_us * 1.0e3);
+    return r;
+}
+
+double phase_total_us(const ccsd::timing::PhaseProfile& phases, std::size_t i) {
+    double sum = 0.0;
+    for (double us : phases.phase(i).samples()) sum += us;
+    return sum;
 }
 
-void print_human_report(int np, const Args& args,
-                        const ccsd::timing::PercentileAccumulator::Snapshot& snap) {
-    std::printf("ccsd_bench: np=%d batch=%d warmup=%d\n", np, args.batch, args.warmup);
+void print_human_report(int np, const Args& args, const ccsd::timing::SampleStats& run,
+                        double total_seconds, const ccsd::timing::PhaseProfile& phases) {
+    std::printf("ccsd_bench: np=%d groups=%d batch=%d warmup=%d\n",
+                np, args.groups, args.batch, args.warmup);
     std::printf("  per-iter mean=%.0f us  p50=%.0f us  p99=%.0f us  total=%.3f s\n",
-                snap.mean, snap.p50, snap.p99, snap.total_seconds);
+                run.mean, run.p50, run.p99, total_seconds);
+    std::printf("  p50 95%% CI=[%.1f, %.1f] us  outliers=%zu\n",
+                run.ci95_lo, run.ci95_hi, run.outliers);
+    std::printf("  %-8s %12s %25s %9s\n", "phase", "p50 us", "95% CI us", "outliers");
+    for (std::size_t i = 0; i < phases.size(); ++i) {
+        const auto st = phases.phase(i).summary();
+        std::printf("  %-8s %12.3f   [%10.3f, %10.3f] %9zu\n", phases.name(i).c_str(),
+                    st.p50, st.ci95_lo, st.ci95_hi, st.outliers);
+    }
+}
+
+void print_memory(const MemoryReport& m) {
+    const auto max_rss = *std::max_element(m.peak_rss.begin(), m.peak_rss.end());
+    const auto max_tns = *std::max_element(m.tensor_bytes.begin(), m.tensor_bytes.end());
+    std::printf("  memory: tensors max=%s/rank  peak RSS max=%s/rank\n",
+                ccsd::memory::format_bytes(max_tns).c_str(),
+                ccsd::memory::format_bytes(max_rss).c_str());
+}
+
+void write_u64_list(std::ofstream& out, const std::vector<unsigned long long>& v) {
+    out << "[";
+    for (std::size_t i = 0; i < v.size(); ++i) out << (i ? ", " : "") << v[i];
+    out << "]";
+}
+
+void print_counters(const ccsd::timing::PhaseProfile& phases, const PhaseCounters& pc) {
+    if (!pc.available) {
+        std::printf("  counters: unavailable (perf_event_open denied; see perf_event_paranoid)\n");
+        return;
+    }
+    std::printf("  %-8s %14s %14s %6s %12s %14s %10s %8s\n", "phase", "cycles", "instructions",
+                "ipc", "llc_misses", "flops", "flops/B", "GF/s");
+    for (std::size_t i = 0; i < phases.size(); ++i) {
+        const auto& hw = pc.hw[i];
+        const auto  r  = roofline(hw, pc.flops[i], phase_total_us(phases, i));
+        std::printf("  %-8s %14llu %14llu %6.2f %12llu %14.0f %10.3f %8.3f\n", phases.name(i).c_str(),
+                    static_cast<unsigned long long>(hw.cycles),
+                    static_cast<unsigned long long>(hw.instructions), r.ipc,
+                    static_cast<unsigned long long>(hw.llc_misses), pc.flops[i],
+                    r.flops_per_byte, r.gflops);
+    }
+}
+
+void write_stats(std::ofstream& out, const ccsd::timing::SampleStats& st) {
+    out << "{\"mean\": " << st.mean
+        << ", \"p50\": " << st.p50
+        << ", \"p99\": " << st.p99
+        << ", \"stddev\": " << st.stddev
+        << ", \"min\": " << st.min
+        << ", \"max\": " << st.max
+        << ", \"ci95\": [" << st.ci95_lo << ", " << st.ci95_hi << "]"
+        << ", \"outliers\": " << st.outliers
+        << ", \"count\": " << st.count << "}";
 }
 
 void write_json_report(const std::string& path, int np, const Args& args,
-                       const ccsd::timing::PercentileAccumulator::Snapshot& snap) {
+                       const ccsd::timing::SampleStats& run, double total_seconds,
+                       const ccsd::timing::PhaseProfile& phases, const MemoryReport& mem,
+                       const PhaseCounters* pc, const std::vector<MethodCost>& methods,
+                       const MethodCost* screened, double e_full) {
     std::ofstream out(path);
+    out.precision(9);
     out << "{\n";
     out << "  \"np\": " << np << ",\n";
+    out << "  \"groups\": " << args.groups << ",\n";
+    out << "  \"chunk_doubles\": " << args.chunk_doubles << ",\n";
     out << "  \"batch\": " << args.batch << ",\n";
     out << "  \"warmup\": " << args.warmup << ",\n";
-    out << "  \"wall_seconds\": " << snap.total_seconds << ",\n";
-    out << "  \"per_iter_us\": {\"mean\": " << snap.mean
-        << ", \"p50\": " << snap.p50
-        << ", \"p99\": " << snap.p99 << "}\n";
-    out << "}\n";
+    out << "  \"wall_seconds\": " << total_seconds << ",\n";
+    out << "  \"per_iter_us\": ";
+    write_stats(out, run);
+    out << ",\n";
+    out << "  \"phase_reduction\": \"max_over_ranks\",\n";
+    out << "  \"phases_us\": {\n";
+    for (std::size_t i = 0; i < phases.size(); ++i) {
+        out << "    \"" << phases.name(i) << "\": ";
+        write_stats(out, phases.phase(i).summary());
+        out << (i + 1 < phases.size() ? ",\n" : "\n");
+    }
+    out << "  },\n";
+    out << "  \"memory\": {\n";
+    out << "    \"tensors\": {";
+    const auto& entries = mem.tensors.entries();
+    for (std::size_t i = 0; i < entries.size(); ++i)
+        out << (i ? ", " : "") << "\"" << entries[i].name << "\": " << entries[i].bytes;
+    out << "},\n";
+    out << "    \"tensor_bytes_per_rank\": ";
+    write_u64_list(out, mem.tensor_bytes);
+    out << ",\n    \"peak_rss_bytes_per_rank\": ";
+    write_u64_list(out, mem.peak_rss);
+    out << "\n  }";
+    if (pc) {
+        out << ",\n  \"counters\": {\n";
+        out << "    \"available\": " << (pc->available ? "true" : "false") << ",\n";
+        out << "    \"reduction\": \"sum_over_ranks\",\n";
+        out << "    \"phases\": {\n";
+        for (std::size_t i = 0; i < phases.size(); ++i) {
+            const auto& hw = pc->hw[i];
+            const auto  r  = roofline(hw, pc->flops[i], phase_total_us(phases, i));
+            out << "      \"" << phases.name(i) << "\": {"
+                << "\"cycles\": " << hw.cycles
+                << ", \"instructions\": " << hw.instructions
+                << ", \"ipc\": " << r.ipc
+                << ", \"llc_misses\": " << hw.llc_misses
+                << ", \"fp_ops\": " << hw.fp_ops
+                << ", \"flops\": " << pc->flops[i]
+                << ", \"flops_per_byte\": " << r.flops_per_byte
+                << ", \"gflops\": " << r.gflops << "}"
+                << (i + 1 < phases.size() ? ",\n" : "\n");
+        }
+        out << "    }\n  }";
+    }
+    if (screened) {
+        out << ",\n  \"screening\": {\"threshold\": " << args.screening << ", \"per_run_us\": ";
+        write_stats(out, screened->run);
+        out << ", \"skipped_fraction\": " << screened->screening.fraction()
+            << ", \"energy_error\": " << screened->e_corr - e_full << "}";
+    }
+    if (!methods.empty()) {
+        out << ",\n  \"methods\": {\n";
+        for (std::size_t i = 0; i < methods.size(); ++i) {
+            const MethodCost& c = methods[i];
+            out << "    \"" << ccsd::method_name(c.method) << "\": {\"per_run_us\": ";
+            write_stats(out, c.run);
+            out << ", \"flops\": " << c.flops
+                << ", \"iterations\": " << c.iterations
+                << ", \"e_corr\": " << c.e_corr << "}"
+                << (i + 1 < methods.size() ? ",\n" : "\n");
+        }
+        out << "  }";
+    }
+    out << "\n}\n";
 }
 
 }  // namespace
@@ -79,16 +375,43 @@ int main(int argc, char** argv) {
     Args              args = parse_args(argc, argv);
     ccsd::MpiSession  session(&argc, &argv);
 
-    run_warmup(session, args.warmup);
+    // Each group runs its own batch on a sub-communicator; the report is
+    // taken from group 0 (which contains world rank 0). The groups' solves
+    // share one RMA window, created over the world before they start.
+    args.groups = std::clamp(args.groups, 1, session.size());
+    auto group  = ccsd::mpi::split_groups(session.comm(), args.groups);
+    ccsd::mpi::RmaWindow window(session.comm());
+
+    run_warmup(group.get(), window, args, args.warmup);
 
     ccsd::timing::PercentileAccumulator acc;
-    run_timed(session, args.batch, acc);
+    ccsd::timing::PhaseProfile phases(ccsd::solver_phase_names());
+    // Opened after the warmup, so the counters are set up per OpenMP worker
+    // already running (and inherited by any started later).
+    if (args.counters) phases.enable_counters();
+    ccsd::memory::MemoryRegistry tensors;
+    double e_corr = 0.0;
+    run_timed(group.get(), window, args, args.batch, acc, phases, tensors, e_corr);
+    reduce_phases_max(phases, group.get());
+    const MemoryReport mem = gather_memory(tensors, session.comm());
+    PhaseCounters counters;
+    if (args.counters) counters = reduce_counters_sum(phases, group.get());
+    std::vector<MethodCost> methods;
+    for (const ccsd::Method m : args.methods) methods.push_back(time_method(group.get(), window, args, m));
+    MethodCost screened;
+    if (args.screening > 0.0) screened = time_method(group.get(), window, args, ccsd::Method::ccsd, args.screening);
 
     if (session.rank() == 0) {
-        auto snap = acc.snapshot();
-        print_human_report(session.size(), args, snap);
+        const auto run = acc.summary();
+        print_human_report(session.size(), args, run, acc.total_seconds(), phases);
+        print_memory(mem);
+        if (args.counters) print_counters(phases, counters);
+        if (args.screening > 0.0) print_screening(args.screening, screened, run.p50, e_corr);
+        if (!methods.empty()) print_methods(methods);
         if (!args.report.empty()) {
-            write_json_report(args.report, session.size(), args, snap);
+            write_json_report(args.report, session.size(), args, run, acc.total_seconds(), phases, mem,
+                              args.counters ? &counters : nullptr, methods,
+                              args.screening > 0.0 ? &screened : nullptr, e_corr);
         }
     }
     return 0;
@@ -1,9 +1,187 @@
+#include <ccsd/config/load_config.h>
+#include <ccsd/kernels/ccsd_eom.h>
+#include <ccsd/kernels/ccsd_symmetry.h>
+#include <ccsd/mpi/trace_export.h>
+#include <ccsd/solver/autotune.h>
 #include <ccsd/solver/ccsd_solver.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// `--config PATH` selects the input (JSON or FCIDUMP; default ./config.json).
+// `--method NAME` solves for mp2, mp3, cc2, ccd or ccsd (default).
+// `--triples` adds the perturbative (T) correction.
+// `--eom N [--eom-irrep G]` adds the N lowest EOM-EE-CCSD excited states
+// whose excitation lies in 0-based irrep G (default 0, totally symmetric).
+// `--cholesky TOL` / `--cholesky-file PATH` switch to the Cholesky integral
+// backend (vectors built to TOL, or read from a binary file).
+// `--screening THR` skips contraction blocks whose integral/amplitude block
+// norms multiply to less than THR, and reports the fraction skipped.
+// `--scratch DIR` keeps W_abef out of core: <ab||ef> slabs stream from DIR.
+// `--distribute-W-abef` keeps those slabs in memory instead, each rank only
+// the rows of its own T2 tile, so no rank stores the whole W_abef.
+// `--incremental THR [--rebuild-every N]` updates F/W from amplitude changes
+// above THR, rebuilding them in full every N iterations (default 8).
+// `--fno THR` drops virtuals with MP2 natural occupation <= THR (plus an MP2
+// correction for them).
+// `--autotune` times candidate thread counts, W_abef layouts and MPI
+// transfer settings for this shape and CPU when the tuning cache has no entry
+// yet, and records the winner. `--tuning-cache PATH` (default
+// ./ccsd_tuning.json) is consulted on every run: a matching entry is applied.
+// `--static-tiles` gives each rank one fixed T2 and (T) tile instead of
+// claiming tiles from the shared task counter (the default).
+// `--trace PATH` records every solver phase and MPI transfer on each rank and
+// writes the merged timeline as Chrome trace JSON (ui.perfetto.dev).
+// `--frozen-core N` excludes the N lowest spatial orbitals from correlation
+// (default: the config's "frozen_core", else none).
+// `--dry-run [--dim N] [--nelec M]`: print the per-rank memory plan and exit
+// before anything is allocated. dim/Nelec are the full system and default to
+// the config; frozen core orbitals are removed from both.
+struct Args {
+    std::string config  = "./config.json";
+    bool        dry_run = false;
+    ccsd::Method method = ccsd::Method::ccsd;
+    bool        triples = false;
+    int         eom_roots = 0;
+    int         eom_irrep = 0;
+    int         frozen_core = -1;
+    double      cholesky = 0.0;
+    std::string cholesky_file;
+    std::string scratch;
+    bool        distribute_W_abef = false;
+    double      screening = 0.0;
+    double      fno = 0.0;
+    double      incremental = 0.0;
+    int         rebuild_every = 8;
+    bool        autotune = false;
+    std::string tuning_cache = "./ccsd_tuning.json";
+    std::string trace;
+    bool        static_tiles = false;
+    int         dim     = 0;
+    int         nelec   = 0;
+};
+
+Args parse_args(int argc, char** argv) {
+    Args d;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+            d.config = argv[++i];
+        } else if (std::strcmp(argv[i], "--method") == 0 && i + 1 < argc) {
+            d.method = ccsd::parse_method(argv[++i]);
+        } else if (std::strcmp(argv[i], "--triples") == 0) {
+            d.triples = true;
+        } else if (std::strcmp(argv[i], "--eom") == 0 && i + 1 < argc) {
+            d.eom_roots = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--eom-irrep") == 0 && i + 1 < argc) {
+            d.eom_irrep = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--cholesky") == 0 && i + 1 < argc) {
+            d.cholesky = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--cholesky-file") == 0 && i + 1 < argc) {
+            d.cholesky_file = argv[++i];
+        } else if (std::strcmp(argv[i], "--screening") == 0 && i + 1 < argc) {
+            d.screening = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--scratch") == 0 && i + 1 < argc) {
+            d.scratch = argv[++i];
+        } else if (std::strcmp(argv[i], "--distribute-W-abef") == 0) {
+            d.distribute_W_abef = true;
+        } else if (std::strcmp(argv[i], "--incremental") == 0 && i + 1 < argc) {
+            d.incremental = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--rebuild-every") == 0 && i + 1 < argc) {
+            d.rebuild_every = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--autotune") == 0) {
+            d.autotune = true;
+        } else if (std::strcmp(argv[i], "--tuning-cache") == 0 && i + 1 < argc) {
+            d.tuning_cache = argv[++i];
+        } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            d.trace = argv[++i];
+        } else if (std::strcmp(argv[i], "--static-tiles") == 0) {
+            d.static_tiles = true;
+        } else if (std::strcmp(argv[i], "--fno") == 0 && i + 1 < argc) {
+            d.fno = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--frozen-core") == 0 && i + 1 < argc) {
+            d.frozen_core = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--dry-run") == 0) {
+            d.dry_run = true;
+        } else if (std::strcmp(argv[i], "--dim") == 0 && i + 1 < argc) {
+            d.dim = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--nelec") == 0 && i + 1 < argc) {
+            d.nelec = std::atoi(argv[++i]);
+        }
+    }
+    return d;
+}
+
+void print_memory_plan(Args d, int np) {
+    std::vector<int> orbsym;   // active orbitals' irreps, when the config is read
+    if (d.dim <= 0 || d.nelec <= 0) {
+        const ParameterClass p = ccsd::load_config(d.config);
+        if (d.dim <= 0)         d.dim   = p.n_spatial_orbitals + p.frozen_core;
+        if (d.nelec <= 0)       d.nelec = p.n_occupied + 2 * p.frozen_core;
+        if (d.frozen_core < 0)  d.frozen_core = p.frozen_core;
+        orbsym = p.orbital_symmetry;
+        const auto drop = static_cast<std::size_t>(std::max(d.frozen_core - p.frozen_core, 0));
+        if (orbsym.size() >= drop) orbsym.erase(orbsym.begin(), orbsym.begin() + static_cast<std::ptrdiff_t>(drop));
+    }
+    d.frozen_core = std::max(d.frozen_core, 0);
+    const int  n_so = 2 * (d.dim - d.frozen_core);
+    const int  occ  = d.nelec - 2 * d.frozen_core;
+    if (static_cast<int>(orbsym.size()) * 2 != n_so) orbsym.clear();
+    auto plan = ccsd::CcsdState::plan(n_so, occ, ccsd::SpinOrbitalSymmetry::labels(orbsym, n_so));
+    if (d.eom_roots > 0) {
+        const auto o = static_cast<std::size_t>(occ), v = static_cast<std::size_t>(n_so - occ);
+        plan.record("EOM blocks", ccsd::EomKernels::block_bytes(o, v));
+        plan.record("EOM scratch", ccsd::EomKernels::scratch_bytes(o, v));
+    }
+    std::cout << "Memory plan: dim=" << d.dim << " Nelec=" << d.nelec;
+    if (d.frozen_core > 0) std::cout << " frozen core=" << d.frozen_core;
+    std::cout << " (spin orbitals=" << n_so << ", occ=" << occ
+              << ", virt=" << n_so - occ << "), per rank\n";
+    ccsd::memory::write_table(std::cout, plan);
+    std::cout << "  x " << np << " ranks = "
+              << ccsd::memory::format_bytes(plan.total_bytes() * static_cast<std::size_t>(np))
+              << std::endl;
+}
+
+}  // namespace
+
 int main(int argc, char** argv) {
+    const Args args = parse_args(argc, argv);
     ccsd::MpiSession session(&argc, &argv);
+    if (args.dry_run) {
+        if (session.rank() == 0) print_memory_plan(args, session.size());
+        return 0;
+    }
     ccsd::CcsdSolver solver;
+    solver.config_path = args.config;
+    solver.method = args.method;
+    solver.perturbative_triples = args.triples;
+    solver.eom_roots = args.eom_roots;
+    solver.eom_irrep = args.eom_irrep;
+    solver.frozen_core = args.frozen_core;
+    solver.cholesky_threshold = args.cholesky;
+    solver.cholesky_path = args.cholesky_file;
+    solver.scratch_dir = args.scratch;
+    solver.distributed_W_abef = args.distribute_W_abef;
+    solver.screening_threshold = args.screening;
+    solver.fno_threshold = args.fno;
+    solver.dynamic_tiles = !args.static_tiles;
+    solver.incremental_threshold = args.incremental;
+    solver.full_rebuild_interval = args.rebuild_every;
     solver.attach(session);
+    ccsd::apply_cached_tuning(solver, args.tuning_cache, args.autotune);
+    ccsd::timing::TraceRecorder trace;
+    if (!args.trace.empty()) solver.trace = &trace;
     solver.run();
+    if (!args.trace.empty()) {
+        ccsd::mpi::write_chrome_trace(trace, args.trace, 0, session.comm());
+        if (session.rank() == 0) std::cout << "Trace written to " << args.trace << std::endl;
+    }
     return 0;
 }
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""Compare a ccsd_bench JSON report against a stored baseline.
+
+A metric (whole run, or one phase from "phases_us") is a regression when
+both hold:
+  * its median slowed down by more than --min-effect (relative), and
+  * the 95% CIs of the two medians do not overlap (current lower bound is
+    above the baseline upper bound).
+The CI test rejects noise; the effect floor rejects statistically real but
+irrelevant shifts. Exits 1 if any metric regressed, 0 otherwise.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import sys
+from pathlib import Path
+
+
+def parse_args() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description="Gate a bench report against a baseline.")
+    parser.add_argument("--baseline", required=True, type=Path)
+    parser.add_argument("--current", required=True, type=Path)
+    parser.add_argument(
+        "--min-effect", type=float, default=0.05,
+        help="Relative median slowdown below which a change is ignored (default 0.05).",
+    )
+    parser.add_argument(
+        "--min-us", type=float, default=1.0,
+        help="Ignore phases whose baseline median is below this many microseconds.",
+    )
+    return parser.parse_args()
+
+
+def metrics(report: dict) -> dict[str, dict]:
+    out = {"run": report["per_iter_us"]}
+    for name, stats in report.get("phases_us", {}).items():
+        out[name] = stats
+    return out
+
+
+def classify(base: dict, cur: dict, min_effect: float) -> str:
+    if "ci95" not in base or "ci95" not in cur:
+        return "no-ci"
+    ratio = cur["p50"] / base["p50"] if base["p50"] > 0 else 1.0
+    if cur["ci95"][0] > base["ci95"][1] and ratio - 1.0 > min_effect:
+        return "REGRESSION"
+    if cur["ci95"][1] < base["ci95"][0] and 1.0 - ratio > min_effect:
+        return "improved"
+    return "ok"
+
+
+def main() -> int:
+    args = parse_args()
+    base = metrics(json.loads(args.baseline.read_text()))
+    cur = metrics(json.loads(args.current.read_text()))
+
+    regressions = 0
+    print(f"{'metric':<8} {'base p50 us':>12} {'cur p50 us':>12} {'ratio':>7}  verdict")
+    for name, b in base.items():
+        c = cur.get(name)
+        if c is None:
+            print(f"{name:<8} {'':>12} {'missing':>12}")
+            continue
+        if name != "run" and b["p50"] < args.min_us:
+            continue
+        verdict = classify(b, c, args.min_effect)
+        ratio = c["p50"] / b["p50"] if b["p50"] > 0 else float("nan")
+        print(f"{name:<8} {b['p50']:>12.3f} {c['p50']:>12.3f} {ratio:>6.2f}x  {verdict}")
+        regressions += verdict == "REGRESSION"
+
+    if regressions:
+        print(f"bench_gate: {regressions} statistically significant regression(s)", file=sys.stderr)
+        return 1
+    print("bench_gate: no significant regressions")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
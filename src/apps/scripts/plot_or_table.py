@@ -1,7 +1,8 @@
 #!/usr/bin/env python3
 """Collate raw bench JSONs into the markdown report.
 
-Per (preset, np, threads): keep the best-of-N median across repetitions.
+Per (preset, np, threads): report the repetition with the median p50 (median
+of medians, not the optimistic best-of-N) together with its 95% CI.
 Speedups computed against the row labelled "release" with np=4 threads=1
 (the canonical baseline pinned in P05).
 """
@@ -21,7 +22,7 @@ def main() -> None:
     raw_dir = Path(sys.argv[1])
     out_md = Path(sys.argv[2])
 
-    # group rows by (preset, np, threads); keep the best p50 across reps
+    # group rows by (preset, np, threads); keep the median-p50 repetition
     grouped: dict[tuple[str, int, int], list[dict]] = defaultdict(list)
     for p in sorted(raw_dir.glob("*.json")):
         d = json.load(open(p))
@@ -30,8 +31,8 @@ def main() -> None:
 
     rows = []
     for key, entries in sorted(grouped.items()):
-        best = min(entries, key=lambda e: e["per_iter_us"]["p50"])
-        rows.append((key, best))
+        ranked = sorted(entries, key=lambda e: e["per_iter_us"]["p50"])
+        rows.append((key, ranked[(len(ranked) - 1) // 2]))
 
     # Baseline: release / np=4 / threads=1. Falls back to any release if absent.
     baseline_p50 = None
@@ -48,15 +49,17 @@ def main() -> None:
     lines = [
         "# Pass-2 Benchmark Results",
         "",
-        "Updated automatically by `benchmarks/plot_or_table.py`. Best of 3 medians per row.",
+        "Updated automatically by `benchmarks/plot_or_table.py`. Median of the repetition medians per row.",
         "",
-        "| Preset | np | threads | per-iter μs (p50) | speedup vs baseline |",
-        "|--------|----|---------|-------------------|---------------------|",
+        "| Preset | np | threads | per-iter μs (p50) | 95% CI μs | speedup vs baseline |",
+        "|--------|----|---------|-------------------|-----------|---------------------|",
     ]
     for (preset, np, t), best in rows:
         p50 = best["per_iter_us"]["p50"]
         speedup = (baseline_p50 / p50) if baseline_p50 else float("nan")
-        lines.append(f"| {preset} | {np} | {t} | {p50:.0f} | {speedup:.2f}× |")
+        ci = best["per_iter_us"].get("ci95")
+        ci_txt = f"{ci[0]:.0f}–{ci[1]:.0f}" if ci else "—"
+        lines.append(f"| {preset} | {np} | {t} | {p50:.0f} | {ci_txt} | {speedup:.2f}× |")
 
     out_md.write_text("\n".join(lines) + "\n")
 
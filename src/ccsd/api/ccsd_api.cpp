@@ -0,0 +1,133 @@
+#include <ccsd/api/ccsd_api.h>
+#include <ccsd/solver/ccsd_solver.h>
+
+#include <exception>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+struct ccsd_solver {
+    MPI_Comm comm = MPI_COMM_WORLD;
+    std::unique_ptr<ccsd::CcsdSolver> solver;   // last solve; null before the first
+    std::string error;
+};
+
+namespace {
+
+// Wraps the caller's buffers without copying the integrals.
+ccsd::CcsdConfig config_from(const ccsd_input& in) {
+    if (in.n_orbitals <= 0) throw std::runtime_error("n_orbitals must be > 0");
+    if (!in.orbital_energies || !in.eri) throw std::runtime_error("orbital_energies and eri are required");
+    const int n = in.n_orbitals;
+    const auto N = static_cast<std::size_t>(n);
+
+    ccsd::CcsdConfig c{ccsd::CcsdConfig::direct_init{}};
+    c.n_spatial_orbitals = n;
+    c.n_occupied         = in.n_electrons;
+    c.nuclear_repulsion  = in.nuclear_repulsion;
+    c.hf_energy          = in.hf_energy;
+    c.orbital_energies.assign(in.orbital_energies, in.orbital_energies + N);
+    if (in.orbital_symmetry) c.orbital_symmetry.assign(in.orbital_symmetry, in.orbital_symmetry + N);
+
+    switch (in.eri_layout) {
+    case CCSD_ERI_DENSE: {
+        auto view = ccsd::TensorView<4>::row_major(in.eri, {n, n, n, n});
+        if (in.eri_strides[0] || in.eri_strides[1] || in.eri_strides[2] || in.eri_strides[3])
+            for (std::size_t d = 0; d < 4; ++d) view.strides[d] = in.eri_strides[d];
+        c.external_integrals = ccsd::IntegralView::from_dense(view);
+        break;
+    }
+    case CCSD_ERI_PACKED:
+        c.external_integrals = ccsd::IntegralView::from_packed(in.eri, n);
+        break;
+    default:
+        throw std::runtime_error("unknown eri_layout");
+    }
+    c.validate();
+    return c;
+}
+
+template <std::size_t Rank>
+ccsd_tensor_view to_c(const ccsd::TensorView<Rank>& v) {
+    ccsd_tensor_view out{};
+    out.data = v.data;
+    out.rank = static_cast<int>(Rank);
+    for (std::size_t d = 0; d < Rank; ++d) {
+        out.extents[d] = v.extents[d];
+        out.strides[d] = v.strides[d];
+    }
+    return out;
+}
+
+}  // namespace
+
+extern "C" {
+
+ccsd_options ccsd_default_options(void) {
+    ccsd_options o{};
+    o.verbose = 1;
+    return o;
+}
+
+ccsd_solver* ccsd_solver_create(MPI_Comm comm) {
+    auto* s = new (std::nothrow) ccsd_solver;
+    if (s) s->comm = comm;
+    return s;
+}
+
+void ccsd_solver_destroy(ccsd_solver* solver) {
+    delete solver;
+}
+
+int ccsd_solve(ccsd_solver* solver, const ccsd_input* input, const ccsd_options* options,
+               ccsd_result* out) {
+    if (!solver) return 1;
+    solver->error.clear();
+    try {
+        if (!input) throw std::runtime_error("input is required");
+        const ccsd_options opt = options ? *options : ccsd_default_options();
+        auto s = std::make_unique<ccsd::CcsdSolver>();
+        s->p = config_from(*input);
+        if (opt.frozen_core > 0) s->frozen_core = opt.frozen_core;
+        s->perturbative_triples = opt.triples != 0;
+        s->fno_threshold        = opt.fno_threshold;
+        s->cholesky_threshold   = opt.cholesky_threshold;
+        s->verbose              = opt.verbose != 0;
+        s->attach(solver->comm);
+        solver->solver.reset();   // release the previous solve's tensors first
+        s->run();
+        solver->solver = std::move(s);
+
+        if (out) {
+            const ccsd::CcsdResult& r = solver->solver->result();
+            out->e_corr          = r.e_corr;
+            out->e_total         = r.e_total;
+            out->e_triples       = r.e_triples;
+            out->fno_correction  = r.fno_correction;
+            out->iterations      = r.iterations;
+            out->n_occupied      = solver->solver->p.n_occupied;
+            out->n_spin_orbitals = 2 * solver->solver->p.n_spatial_orbitals;
+        }
+        return 0;
+    } catch (const std::exception& ex) {
+        solver->error = ex.what();
+    } catch (...) {
+        solver->error = "unknown error";
+    }
+    return 1;
+}
+
+const char* ccsd_last_error(const ccsd_solver* solver) {
+    return solver ? solver->error.c_str() : "null solver";
+}
+
+ccsd_tensor_view ccsd_t1(const ccsd_solver* solver) {
+    return solver && solver->solver ? to_c(solver->solver->t1()) : ccsd_tensor_view{};
+}
+
+ccsd_tensor_view ccsd_t2(const ccsd_solver* solver) {
+    return solver && solver->solver ? to_c(solver->solver->t2()) : ccsd_tensor_view{};
+}
+
+}  // extern "C"
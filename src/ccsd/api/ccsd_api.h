@@ -0,0 +1,88 @@
+#ifndef CCSD_API_H
+#define CCSD_API_H
+
+/* C interface for embedding the CCSD solver in another program (an SCF
+ * code, a workflow driver) without going through config files. Integrals
+ * are read in place from the caller's buffer; converged amplitudes are
+ * returned as views into solver storage.
+ *
+ * Every call taking a ccsd_solver is collective over the communicator the
+ * solver was created on, and every rank must pass the same input. */
+
+#include <mpi.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    CCSD_ERI_DENSE  = 0, /* every (pq|rs) at eri_strides */
+    CCSD_ERI_PACKED = 1  /* 8-fold unique values at compound index pq(pq+1)/2 + rs, pq >= rs, pq = p(p+1)/2 + q, p >= q */
+} ccsd_eri_layout;
+
+/* Closed-shell canonical HF reference. Pointers are caller-owned; `eri` is
+ * never copied and must stay valid until ccsd_solve() returns. */
+typedef struct {
+    int n_orbitals;                  /* spatial orbitals */
+    int n_electrons;                 /* even */
+    const double* orbital_energies;  /* n_orbitals */
+    const int* orbital_symmetry;     /* n_orbitals Abelian irreps 1..8 (D2h numbering), or NULL */
+    const double* eri;               /* spatial (pq|rs), chemist notation, 0-based */
+    ccsd_eri_layout eri_layout;
+    ptrdiff_t eri_strides[4];        /* dense: element strides of p, q, r, s; all 0 = C order */
+    double nuclear_repulsion;
+    double hf_energy;
+} ccsd_input;
+
+typedef struct {
+    int triples;                /* nonzero: add the (T) correction */
+    int frozen_core;            /* lowest spatial orbitals left uncorrelated */
+    double fno_threshold;       /* > 0: frozen natural orbitals */
+    double cholesky_threshold;  /* > 0: Cholesky integral backend */
+    int verbose;                /* nonzero: rank 0 prints the energies */
+} ccsd_options;
+
+typedef struct {
+    double e_corr;           /* includes fno_correction */
+    double e_total;          /* e_corr + nuclear repulsion + HF energy */
+    double e_triples;
+    double fno_correction;
+    int iterations;
+    int n_occupied;          /* correlated occupied spin orbitals */
+    int n_spin_orbitals;     /* correlated spin orbitals */
+} ccsd_result;
+
+/* Read-only strided view; unused trailing dimensions have extent 0. */
+typedef struct {
+    const double* data;
+    int rank;
+    int extents[4];
+    ptrdiff_t strides[4];    /* in elements */
+} ccsd_tensor_view;
+
+typedef struct ccsd_solver ccsd_solver;
+
+ccsd_options ccsd_default_options(void);
+
+/* Collective. Returns NULL on allocation failure. */
+ccsd_solver* ccsd_solver_create(MPI_Comm comm);
+void ccsd_solver_destroy(ccsd_solver* solver);
+
+/* Runs a full solve. Returns 0 on success; otherwise nonzero, with the
+ * message available from ccsd_last_error(). `out` may be NULL. */
+int ccsd_solve(ccsd_solver* solver, const ccsd_input* input, const ccsd_options* options,
+               ccsd_result* out);
+const char* ccsd_last_error(const ccsd_solver* solver);
+
+/* Converged t1(a,i) and t2(a,b,i,j) over spin orbitals (occupied first,
+ * even = alpha), identical on every rank. Valid until the next ccsd_solve()
+ * or ccsd_solver_destroy(); data is NULL before the first solve. */
+ccsd_tensor_view ccsd_t1(const ccsd_solver* solver);
+ccsd_tensor_view ccsd_t2(const ccsd_solver* solver);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CCSD_API_H */
@@ -0,0 +1,146 @@
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <ccsd/api/ccsd_api.h>
+#include <ccsd/config/load_config.h>
+#include <ccsd/mpi/session.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using Catch::Approx;
+
+namespace {
+
+// HeH+ from the build directory's config.json, as caller-owned buffers.
+struct Buffers {
+    ccsd::CcsdConfig cfg = ccsd::load_config("config.json");
+    int n = cfg.n_spatial_orbitals;
+    std::vector<double> dense;     // C order
+    std::vector<double> fortran;   // Fortran order
+    std::vector<double> packed;
+
+    Buffers() {
+        const auto N = static_cast<std::size_t>(n);
+        dense.resize(N * N * N * N);
+        fortran.resize(dense.size());
+        const std::size_t P = N * (N + 1) / 2;
+        packed.resize(P * (P + 1) / 2);
+        for (int p = 0; p < n; ++p)
+            for (int q = 0; q < n; ++q)
+                for (int r = 0; r < n; ++r)
+                    for (int s = 0; s < n; ++s) {
+                        const double v = cfg.eri(p + 1, q + 1, r + 1, s + 1);
+                        const auto u = [](int x) { return static_cast<std::size_t>(x); };
+                        dense[((u(p) * N + u(q)) * N + u(r)) * N + u(s)]   = v;
+                        fortran[((u(s) * N + u(r)) * N + u(q)) * N + u(p)] = v;
+                        packed[static_cast<std::size_t>(ccsd::compound_index(p, q, r, s))] = v;
+                    }
+    }
+
+    [[nodiscard]] ccsd_input input(const std::vector<double>& eri, ccsd_eri_layout layout) const {
+        ccsd_input in{};
+        in.n_orbitals        = n;
+        in.n_electrons       = cfg.n_occupied;
+        in.orbital_energies  = cfg.orbital_energies.data();
+        in.eri               = eri.data();
+        in.eri_layout        = layout;
+        in.nuclear_repulsion = cfg.nuclear_repulsion;
+        in.hf_energy         = cfg.hf_energy;
+        return in;
+    }
+};
+
+double at(const ccsd_tensor_view& v, int i, int j, int k = 0, int l = 0) {
+    return v.data[i * v.strides[0] + j * v.strides[1] + k * v.strides[2] + l * v.strides[3]];
+}
+
+ccsd_options quiet() {
+    ccsd_options o = ccsd_default_options();
+    o.verbose = 0;
+    return o;
+}
+
+}  // namespace
+
+TEST_CASE("ccsd_solve on caller-owned dense integrals reproduces HeH+", "[api]") {
+    const Buffers b;
+    ccsd_solver* s = ccsd_solver_create(MPI_COMM_WORLD);
+    REQUIRE(s != nullptr);
+    REQUIRE(ccsd_t1(s).data == nullptr);
+
+    const ccsd_input in = b.input(b.dense, CCSD_ERI_DENSE);
+    const ccsd_options opt = quiet();
+    ccsd_result r{};
+    REQUIRE(ccsd_solve(s, &in, &opt, &r) == 0);
+    REQUIRE(r.e_corr == Approx(-0.008225832259).epsilon(1e-9));
+    REQUIRE(r.e_total == Approx(-2.862598243).epsilon(1e-9));
+    REQUIRE(r.iterations > 1);
+    REQUIRE(r.n_occupied == 2);
+    REQUIRE(r.n_spin_orbitals == 4);
+
+    // E = ¼ Σ <ij||ab> t2 + ½ Σ <ij||ab> t1 t1 from the returned views.
+    const ccsd_tensor_view t1 = ccsd_t1(s), t2 = ccsd_t2(s);
+    REQUIRE(t1.rank == 2);
+    REQUIRE(t2.rank == 4);
+    REQUIRE(t2.extents[0] == 4);
+    auto anti = [&](int p, int q, int rr, int ss) {   // <pq||rs> from the spatial buffer
+        auto g = [&](int w, int x, int y, int z) {
+            return b.dense[static_cast<std::size_t>(((w * b.n + x) * b.n + y) * b.n + z)];
+        };
+        const double direct   = (p % 2 == rr % 2 && q % 2 == ss % 2) ? g(p / 2, rr / 2, q / 2, ss / 2) : 0.0;
+        const double exchange = (p % 2 == ss % 2 && q % 2 == rr % 2) ? g(p / 2, ss / 2, q / 2, rr / 2) : 0.0;
+        return direct - exchange;
+    };
+    double e = 0.0;
+    for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 2; ++j)
+            for (int a = 2; a < 4; ++a)
+                for (int bb = 2; bb < 4; ++bb)
+                    e += anti(i, j, a, bb) * (0.25 * at(t2, a, bb, i, j) + 0.5 * at(t1, a, i) * at(t1, bb, j));
+    REQUIRE(e == Approx(r.e_corr).epsilon(1e-10));
+
+    ccsd_solver_destroy(s);
+}
+
+TEST_CASE("ccsd_solve reads Fortran-order and packed integrals in place", "[api]") {
+    const Buffers b;
+    ccsd_solver* s = ccsd_solver_create(MPI_COMM_WORLD);
+    const ccsd_options opt = quiet();
+
+    ccsd_input fortran = b.input(b.fortran, CCSD_ERI_DENSE);
+    const std::ptrdiff_t n = b.n;
+    fortran.eri_strides[0] = 1;
+    fortran.eri_strides[1] = n;
+    fortran.eri_strides[2] = n * n;
+    fortran.eri_strides[3] = n * n * n;
+    ccsd_result r_f{};
+    REQUIRE(ccsd_solve(s, &fortran, &opt, &r_f) == 0);
+
+    const ccsd_input packed = b.input(b.packed, CCSD_ERI_PACKED);
+    ccsd_result r_p{};
+    REQUIRE(ccsd_solve(s, &packed, &opt, &r_p) == 0);
+
+    REQUIRE(r_f.e_corr == Approx(-0.008225832259).epsilon(1e-9));
+    REQUIRE(r_p.e_corr == Approx(r_f.e_corr).epsilon(1e-12));
+    ccsd_solver_destroy(s);
+}
+
+TEST_CASE("ccsd_solve reports invalid input instead of throwing", "[api]") {
+    const Buffers b;
+    ccsd_solver* s = ccsd_solver_create(MPI_COMM_WORLD);
+    ccsd_input in = b.input(b.dense, CCSD_ERI_DENSE);
+    in.n_electrons = 3;
+    const ccsd_options opt = quiet();
+    REQUIRE(ccsd_solve(s, &in, &opt, nullptr) != 0);
+    REQUIRE(std::string(ccsd_last_error(s)) == "n_occupied must be even (restricted HF)");
+    REQUIRE(ccsd_t2(s).data == nullptr);
+    ccsd_solver_destroy(s);
+}
+
+int main(int argc, char** argv) {
+    ccsd::MpiSession session(&argc, &argv);
+    return Catch::Session().run(argc, argv);
+}
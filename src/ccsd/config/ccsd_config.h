@@ -1,15 +1,112 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
-#include <map>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <nlohmann/json.hpp>
 
+#include <ccsd/config/integral_table.h>
+#include <ccsd/config/integral_view.h>
+
 namespace ccsd {
 
+class CcsdConfig;
+
+namespace detail {
+
+// SAX handler for the config schema: fills CcsdConfig fields while the file
+// streams through, so no DOM is built and "ttmo" goes straight into the flat
+// IntegralTable. Unknown keys (and anything nested in them) are skipped.
+class ConfigSax final : public nlohmann::json_sax<nlohmann::json> {
+public:
+    explicit ConfigSax(CcsdConfig& c) : c_(c) {}
+
+    bool null() override { return scalar_type_error(); }
+    bool boolean(bool) override { return scalar_type_error(); }
+    bool number_integer(number_integer_t v) override { return number(static_cast<double>(v)); }
+    bool number_unsigned(number_unsigned_t v) override { return number(static_cast<double>(v)); }
+    bool number_float(number_float_t v, const string_t&) override { return number(v); }
+    bool string(string_t&) override { return scalar_type_error(); }
+    bool binary(binary_t&) override { return scalar_type_error(); }
+
+    bool start_object(std::size_t) override {
+        if (depth_ == 1 && is_known(field_)) return fail("\"" + field_ + "\" has the wrong type");
+        ++depth_;
+        return true;
+    }
+    bool end_object() override { --depth_; return true; }
+    bool key(string_t& k) override {
+        if (depth_ == 1) field_ = k;
+        return true;
+    }
+    bool start_array(std::size_t) override {
+        if (depth_ == 0) return fail("top level must be an object");
+        if (depth_ == 1) {
+            if (field_ == "orbital_energy") seen_ |= k_orbital_energy;
+            else if (field_ == "ttmo")      seen_ |= k_ttmo;
+            else if (field_ == "orbsym")    seen_ |= k_orbsym;
+            else if (is_known(field_))      return fail("\"" + field_ + "\" has the wrong type");
+        }
+        ++depth_;
+        return true;
+    }
+    bool end_array() override { --depth_; return true; }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        return fail(ex.what());
+    }
+
+    // Throws if parsing failed or a required key was absent.
+    void finish() const {
+        if (!error_.empty()) throw std::runtime_error("config: " + error_);
+        static constexpr const char* names[] = {"dim", "Nelec", "orbital_energy", "ENUC", "EN", "ttmo"};
+        for (unsigned i = 0; i < std::size(names); ++i)
+            if (!(seen_ & (1u << i))) throw std::runtime_error(std::string("config: missing key \"") + names[i] + "\"");
+    }
+
+private:
+    enum : unsigned {
+        k_dim = 1u << 0, k_nelec = 1u << 1, k_orbital_energy = 1u << 2,
+        k_enuc = 1u << 3, k_en = 1u << 4, k_ttmo = 1u << 5,
+        k_frozen_core = 1u << 6, k_orbsym = 1u << 7   // optional
+    };
+
+    CcsdConfig& c_;
+    int         depth_ = 0;
+    std::string field_;
+    unsigned    seen_ = 0;
+    bool        have_key_ = false;   // ttmo: a key is waiting for its value
+    double      pending_key_ = 0.0;
+    std::string error_;
+
+    static bool is_known(const std::string& f) {
+        return f == "dim" || f == "Nelec" || f == "orbital_energy" || f == "ENUC" || f == "EN" || f == "ttmo"
+            || f == "frozen_core" || f == "orbsym";
+    }
+
+    bool fail(std::string msg) {
+        if (error_.empty()) error_ = std::move(msg);
+        return false;
+    }
+
+    bool scalar_type_error() {
+        if (depth_ == 1 && is_known(field_)) return fail("\"" + field_ + "\" has the wrong type");
+        if (depth_ == 2 && (field_ == "orbital_energy" || field_ == "ttmo" || field_ == "orbsym"))
+            return fail("\"" + field_ + "\" must contain only numbers");
+        return true;
+    }
+
+    bool number(double v);   // defined after CcsdConfig
+};
+
+}  // namespace detail
+
 // Molecular Hamiltonian parameters loaded from a JSON config file.
 // JSON key → C++ field mapping:
 //   "dim"          → n_spatial_orbitals
@@ -18,14 +115,33 @@ namespace ccsd {
 //   "ENUC"         → nuclear_repulsion
 //   "EN"           → hf_energy
 //   "ttmo"         → two_electron_mos
+//   "frozen_core"  → optional, passed to freeze_core() after loading
+//   "orbsym"       → optional orbital_symmetry
+// Embedding callers fill the fields directly and point `external_integrals`
+// at their own buffer instead of filling two_electron_mos.
 class CcsdConfig {
 public:
     int n_spatial_orbitals = 0;
     int n_occupied         = 0;   // electron count = occupied spin-orbital count
+    int frozen_core        = 0;   // core spatial orbitals already removed by freeze_core()
     std::vector<double> orbital_energies;
     double nuclear_repulsion = 0.0;
     double hf_energy         = 0.0;
-    std::map<double, double> two_electron_mos;
+    IntegralTable two_electron_mos;
+    // Abelian irrep of each spatial orbital, 1-based as in FCIDUMP ORBSYM
+    // (D2h and subgroups: 1..8, products by XOR of label - 1). Empty means
+    // no point-group symmetry is used.
+    std::vector<int> orbital_symmetry;
+    // When set, replaces two_electron_mos: integrals are read in place from
+    // the caller's buffer (see IntegralView). Never broadcast or copied.
+    IntegralView external_integrals;
+
+    // (ab|cd) of active orbitals, 1-based as in the compound keys.
+    [[nodiscard]] double eri(int a, int b, int c, int d) const {
+        if (!external_integrals.empty()) return external_integrals(a - 1, b - 1, c - 1, d - 1);
+        const double* v = two_electron_mos.find(compound_index(a, b, c, d));
+        return v ? *v : 0.0;
+    }
 
     // Constructs with all fields at their zero-defaults — no file is loaded.
     // Use this only when populating fields programmatically (e.g., unit tests).
@@ -33,28 +149,101 @@ public:
     struct direct_init {};
     explicit CcsdConfig(direct_init) noexcept {}
 
+    // Streams the file through detail::ConfigSax: memory beyond the parsed
+    // fields is bounded by the parser's token buffer, not the file size.
     explicit CcsdConfig(const std::string& path = "./config.json") {
-        std::ifstream in(path);
+        std::ifstream in(path, std::ios::binary);
         if (!in) throw std::runtime_error("Cannot open " + path);
-        nlohmann::json j;
-        in >> j;
+        detail::ConfigSax sax(*this);
+        nlohmann::json::sax_parse(in, &sax);
+        sax.finish();
+        two_electron_mos.finalize();
 
-        n_spatial_orbitals = j.at("dim").get<int>();
-        n_occupied         = j.at("Nelec").get<int>();
+        validate();
+        freeze_core(std::exchange(frozen_core, 0));
+    }
 
-        const auto& oe = j.at("orbital_energy");
-        orbital_energies.resize(oe.size());
-        for (std::size_t i = 0; i < oe.size(); ++i)
-            orbital_energies[i] = oe[i].get<double>();
+    // Drops the lowest n active spatial orbitals from the correlated space:
+    // orbitals are renumbered from 1, their energies and two-electron
+    // integrals kept, n_occupied reduced by 2n. For canonical HF orbitals
+    // the Fock diagonal and hf_energy are unchanged, so the kernels need no
+    // other change and every o-dependent loop and tensor shrinks.
+    void freeze_core(int n) {
+        if (n == 0) return;
+        if (n < 0) throw std::runtime_error("frozen_core must be >= 0");
+        if (2 * n >= n_occupied)
+            throw std::runtime_error("frozen_core must leave at least one occupied orbital");
+        if (!external_integrals.empty()) {   // the view skips the core; nothing is copied
+            external_integrals.first += n;
+            drop_core_orbitals(n);
+            return;
+        }
 
-        nuclear_repulsion = j.at("ENUC").get<double>();
-        hf_energy         = j.at("EN").get<double>();
+        // Visiting canonical (ab|cd) in compound-index order yields sorted keys.
+        const int m = n_spatial_orbitals - n;
+        std::vector<std::pair<int, int>> pairs;   // a >= b, in increasing ab
+        for (int a = 1; a <= m; ++a)
+            for (int b = 1; b <= a; ++b) pairs.emplace_back(a, b);
+        IntegralTable active;
+        for (std::size_t x = 0; x < pairs.size(); ++x) {
+            const auto [a, b] = pairs[x];
+            for (std::size_t y = 0; y <= x; ++y) {
+                const auto [c, d] = pairs[y];
+                if (const double* v = two_electron_mos.find(compound_index(a + n, b + n, c + n, d + n)))
+                    active.insert(compound_index(a, b, c, d), *v);
+            }
+        }
+        active.finalize();
 
-        const auto& flat = j.at("ttmo");
-        for (std::size_t i = 0; i + 1 < flat.size(); i += 2)
-            two_electron_mos.emplace(flat[i].get<double>(), flat[i + 1].get<double>());
+        two_electron_mos = std::move(active);
+        drop_core_orbitals(n);
+    }
 
-        validate();
+    // Scalars, orbital energies and irreps as a binary blob (native byte order) for
+    // shipping a parsed config to other ranks; the integrals are moved
+    // separately, straight from two_electron_mos' arrays.
+    [[nodiscard]] std::vector<std::byte> header_blob() const {
+        const BlobHeader h{n_spatial_orbitals, n_occupied, frozen_core,
+                           static_cast<std::int64_t>(orbital_energies.size()),
+                           static_cast<std::int64_t>(orbital_symmetry.size()),
+                           static_cast<std::int64_t>(two_electron_mos.size()),
+                           nuclear_repulsion, hf_energy};
+        const std::size_t oe_bytes = orbital_energies.size() * sizeof(double);
+        std::vector<std::byte> blob(sizeof(h) + oe_bytes + orbital_symmetry.size() * sizeof(int));
+        std::memcpy(blob.data(), &h, sizeof(h));
+        if (!orbital_energies.empty())
+            std::memcpy(blob.data() + sizeof(h), orbital_energies.data(), oe_bytes);
+        if (!orbital_symmetry.empty())
+            std::memcpy(blob.data() + sizeof(h) + oe_bytes, orbital_symmetry.data(),
+                        orbital_symmetry.size() * sizeof(int));
+        return blob;
+    }
+
+    // Inverse of header_blob(). Sizes two_electron_mos for the integrals
+    // that follow and returns their count.
+    std::size_t read_header_blob(const std::vector<std::byte>& blob) {
+        BlobHeader h{};
+        if (blob.size() < sizeof(h)) throw std::runtime_error("config blob: truncated header");
+        std::memcpy(&h, blob.data(), sizeof(h));
+        const auto n_oe  = static_cast<std::size_t>(h.n_orbital_energies);
+        const auto n_sym = static_cast<std::size_t>(h.n_orbital_symmetry);
+        if (blob.size() != sizeof(h) + n_oe * sizeof(double) + n_sym * sizeof(int))
+            throw std::runtime_error("config blob: size mismatch");
+        n_spatial_orbitals = static_cast<int>(h.dim);
+        n_occupied         = static_cast<int>(h.nelec);
+        frozen_core        = static_cast<int>(h.frozen_core);
+        nuclear_repulsion  = h.enuc;
+        hf_energy          = h.en;
+        orbital_energies.resize(n_oe);
+        if (n_oe > 0)
+            std::memcpy(orbital_energies.data(), blob.data() + sizeof(h), n_oe * sizeof(double));
+        orbital_symmetry.resize(n_sym);
+        if (n_sym > 0)
+            std::memcpy(orbital_symmetry.data(), blob.data() + sizeof(h) + n_oe * sizeof(double),
+                        n_sym * sizeof(int));
+        const auto n_tei = static_cast<std::size_t>(h.n_integrals);
+        two_electron_mos.resize(n_tei);
+        return n_tei;
     }
 
     void validate() const {
@@ -66,9 +255,57 @@ public:
             throw std::runtime_error("n_occupied exceeds 2 * n_spatial_orbitals");
         if (static_cast<int>(orbital_energies.size()) != n_spatial_orbitals)
             throw std::runtime_error("orbital_energies size mismatch");
+        if (!orbital_symmetry.empty()) {
+            if (static_cast<int>(orbital_symmetry.size()) != n_spatial_orbitals)
+                throw std::runtime_error("orbital_symmetry size mismatch");
+            for (int g : orbital_symmetry)
+                if (g < 1 || g > 8) throw std::runtime_error("orbital_symmetry labels must be in 1..8");
+        }
+        if (!external_integrals.empty() && external_integrals.n_active() != n_spatial_orbitals)
+            throw std::runtime_error("external integrals do not match n_spatial_orbitals");
+    }
+
+private:
+    struct BlobHeader {
+        std::int64_t dim, nelec, frozen_core, n_orbital_energies, n_orbital_symmetry, n_integrals;
+        double       enuc, en;
+    };
+
+    // freeze_core() bookkeeping once the integrals have been dealt with.
+    void drop_core_orbitals(int n) {
+        orbital_energies.erase(orbital_energies.begin(), orbital_energies.begin() + n);
+        if (!orbital_symmetry.empty())
+            orbital_symmetry.erase(orbital_symmetry.begin(), orbital_symmetry.begin() + n);
+        n_spatial_orbitals -= n;
+        n_occupied -= 2 * n;
+        frozen_core += n;
+        validate();
     }
 };
 
+inline bool detail::ConfigSax::number(double v) {
+    if (depth_ == 1) {
+        if      (field_ == "dim")   { c_.n_spatial_orbitals = static_cast<int>(v); seen_ |= k_dim; }
+        else if (field_ == "Nelec") { c_.n_occupied = static_cast<int>(v);         seen_ |= k_nelec; }
+        else if (field_ == "ENUC")  { c_.nuclear_repulsion = v;                    seen_ |= k_enuc; }
+        else if (field_ == "EN")    { c_.hf_energy = v;                            seen_ |= k_en; }
+        else if (field_ == "frozen_core") { c_.frozen_core = static_cast<int>(v);  seen_ |= k_frozen_core; }
+        else if (is_known(field_))  return fail("\"" + field_ + "\" must be an array");
+    } else if (depth_ == 2) {
+        if (field_ == "orbital_energy") {
+            c_.orbital_energies.push_back(v);
+        } else if (field_ == "orbsym") {
+            c_.orbital_symmetry.push_back(static_cast<int>(v));
+        } else if (field_ == "ttmo") {
+            // Flat [key0, value0, key1, value1, ...]; a trailing key is ignored.
+            if (have_key_) c_.two_electron_mos.insert(pending_key_, v);
+            else           pending_key_ = v;
+            have_key_ = !have_key_;
+        }
+    }
+    return true;
+}
+
 }  // namespace ccsd
 
 // Backwards-compat alias: existing code uses unqualified ParameterClass.
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ccsd/config/integral_table.h>
+
+namespace ccsd {
+
+// Three-index Cholesky vectors of the spatial two-electron integrals,
+//   (pq|rs) ≈ Σ_Q L^Q_pq L^Q_rs,
+// over packed orbital pairs pq (p >= q, 0-based). Stored pair-major
+// ([pq][Q]) so one integral is a contiguous dot product of length
+// n_vectors(). Memory is n(n+1)/2 · N_Q doubles instead of the n^4 of a
+// dense <pq||rs>.
+class CholeskyVectors {
+public:
+    CholeskyVectors() = default;
+    CholeskyVectors(int n_orbitals, int n_vectors, std::vector<double> pair_major)
+        : n_(n_orbitals), n_vec_(n_vectors), data_(std::move(pair_major)) {
+        if (data_.size() != n_pairs() * static_cast<std::size_t>(n_vec_))
+            throw std::runtime_error("cholesky: vector data size mismatch");
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return n_ == 0; }
+    [[nodiscard]] int n_orbitals() const noexcept { return n_; }
+    [[nodiscard]] int n_vectors() const noexcept { return n_vec_; }
+    [[nodiscard]] std::size_t n_pairs() const noexcept {
+        const auto n = static_cast<std::size_t>(n_);
+        return n * (n + 1) / 2;
+    }
+    [[nodiscard]] std::size_t bytes() const noexcept { return data_.size() * sizeof(double); }
+
+    [[nodiscard]] static std::size_t pair(int p, int q) noexcept {
+        const auto hi = static_cast<std::size_t>(std::max(p, q));
+        const auto lo = static_cast<std::size_t>(std::min(p, q));
+        return hi * (hi + 1) / 2 + lo;
+    }
+
+    // L^Q_pq for Q = 0..n_vectors()-1.
+    [[nodiscard]] const double* row(std::size_t pq) const noexcept {
+        return data_.data() + pq * static_cast<std::size_t>(n_vec_);
+    }
+
+    // (pq|rs), chemist notation, 0-based spatial indices.
+    [[nodiscard]] double eri(int p, int q, int r, int s) const noexcept {
+        const double* x = row(pair(p, q));
+        const double* y = row(pair(r, s));
+        double v = 0.0;
+        for (int k = 0; k < n_vec_; ++k) v += x[k] * y[k];
+        return v;
+    }
+
+    [[nodiscard]] const std::vector<double>& data() const noexcept { return data_; }
+
+private:
+    int n_ = 0;
+    int n_vec_ = 0;
+    std::vector<double> data_;
+};
+
+// Pivoted (incomplete) Cholesky of the pair matrix V_{pq,rs} = (pq|rs),
+// with eri(a, b, c, d) returning (ab|cd) for 1-based spatial indices
+// (n orbitals). Stops once every remaining diagonal error is <= tol, so
+// max |(pq|rs) - Σ L L| <= tol. Each new vector costs one column of V,
+// n(n+1)/2 integral reads.
+template <class Eri>
+    requires std::invocable<Eri&, int, int, int, int>
+CholeskyVectors cholesky_decompose(Eri&& eri, int n, double tol) {
+    const std::size_t m = static_cast<std::size_t>(n) * static_cast<std::size_t>(n + 1) / 2;
+    std::vector<std::pair<int, int>> orb(m);
+    for (int p = 0; p < n; ++p)
+        for (int q = 0; q <= p; ++q) orb[CholeskyVectors::pair(p, q)] = {p, q};
+    auto V = [&](std::size_t x, std::size_t y) -> double {
+        return eri(orb[x].first + 1, orb[x].second + 1, orb[y].first + 1, orb[y].second + 1);
+    };
+
+    std::vector<double> diag(m);
+    for (std::size_t x = 0; x < m; ++x) diag[x] = V(x, x);
+
+    std::vector<std::vector<double>> cols;   // vector-major while building
+    while (cols.size() < m) {
+        const auto piv = static_cast<std::size_t>(std::max_element(diag.begin(), diag.end()) - diag.begin());
+        if (!(diag[piv] > tol)) break;
+        const double scale = 1.0 / std::sqrt(diag[piv]);
+        std::vector<double> l(m);
+        for (std::size_t x = 0; x < m; ++x) {
+            double v = V(x, piv);
+            for (const auto& c : cols) v -= c[x] * c[piv];
+            l[x] = v * scale;
+        }
+        for (std::size_t x = 0; x < m; ++x) diag[x] -= l[x] * l[x];
+        diag[piv] = 0.0;   // exact by construction; keeps round-off from re-picking it
+        cols.push_back(std::move(l));
+    }
+
+    const std::size_t nq = cols.size();
+    std::vector<double> pair_major(m * nq);
+    for (std::size_t k = 0; k < nq; ++k)
+        for (std::size_t x = 0; x < m; ++x) pair_major[x * nq + k] = cols[k][x];
+    return {n, static_cast<int>(nq), std::move(pair_major)};
+}
+
+// The same, reading `tei` (1-based compound keys).
+inline CholeskyVectors cholesky_decompose(const IntegralTable& tei, int n, double tol) {
+    return cholesky_decompose([&](int a, int b, int c, int d) {
+        const double* v = tei.find(compound_index(a, b, c, d));
+        return v ? *v : 0.0;
+    }, n, tol);
+}
+
+// Binary Cholesky file: the 8-byte magic "CCSDCHV1", int64 n_orbitals,
+// int64 n_vectors, then n(n+1)/2 · n_vectors doubles, pair-major as in
+// CholeskyVectors, all in native byte order.
+namespace cholesky_file {
+inline constexpr char magic[8] = {'C', 'C', 'S', 'D', 'C', 'H', 'V', '1'};
+}  // namespace cholesky_file
+
+inline void write_cholesky(const std::string& path, const CholeskyVectors& L) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) throw std::runtime_error("Cannot open " + path);
+    const std::int64_t dims[2] = {L.n_orbitals(), L.n_vectors()};
+    out.write(cholesky_file::magic, sizeof(cholesky_file::magic));
+    out.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+    out.write(reinterpret_cast<const char*>(L.data().data()), static_cast<std::streamsize>(L.bytes()));
+    if (!out) throw std::runtime_error("cholesky " + path + ": write failed");
+}
+
+inline CholeskyVectors read_cholesky(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Cannot open " + path);
+    char magic[sizeof(cholesky_file::magic)] = {};
+    std::int64_t dims[2] = {0, 0};
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(dims), sizeof(dims));
+    if (!in || std::memcmp(magic, cholesky_file::magic, sizeof(magic)) != 0)
+        throw std::runtime_error("cholesky " + path + ": not a Cholesky vector file");
+    if (dims[0] <= 0 || dims[1] < 0)
+        throw std::runtime_error("cholesky " + path + ": bad dimensions");
+    const auto n = static_cast<std::size_t>(dims[0]);
+    std::vector<double> data(n * (n + 1) / 2 * static_cast<std::size_t>(dims[1]));
+    in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(double)));
+    if (!in) throw std::runtime_error("cholesky " + path + ": truncated");
+    return {static_cast<int>(dims[0]), static_cast<int>(dims[1]), std::move(data)};
+}
+
+}  // namespace ccsd
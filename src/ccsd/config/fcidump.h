@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ccsd/config/ccsd_config.h>
+#include <ccsd/config/integral_table.h>
+
+namespace ccsd {
+
+// FCIDUMP (Knowles & Handy) reader. The file is a Fortran namelist header
+//   &FCI NORB=n, NELEC=m, MS2=0, ORBSYM=..., ISYM=1, &END
+// followed by "value i j k l" lines with 1-based spatial indices:
+//   i j k l > 0      (ij|kl), chemist notation, one per 8-fold class
+//   i j > 0, k=l=0   h_ij, one-electron integral
+//   i > 0, j=k=l=0   orbital energy eps_i (optional)
+//   0 0 0 0          core energy → nuclear_repulsion
+namespace fcidump {
+
+struct Header {
+    int              norb  = 0;
+    int              nelec = 0;
+    int              ms2   = 0;
+    int              isym  = 1;
+    std::vector<int> orbsym;
+};
+
+// Integrals parsed from one slice of the body.
+struct Chunk {
+    std::vector<double>                 keys, values;   // (ij|kl)
+    std::vector<std::pair<int, double>> h_diag;         // h_ii
+    std::vector<std::pair<int, double>> eps;            // eps_i
+    std::optional<double>               core;
+    std::string                         error;          // first malformed line
+};
+
+namespace detail {
+
+inline bool is_space(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+// std::from_chars plus Fortran "1.0D-01" exponents.
+inline const char* parse_double(const char* first, const char* last, double& v) {
+    auto [p, ec] = std::from_chars(first, last, v);
+    if (ec != std::errc{}) return nullptr;
+    if (p != last && (*p == 'D' || *p == 'd')) {
+        std::string tok(first, p);
+        tok += 'E';
+        const char* q = p + 1;
+        while (q != last && !is_space(*q) && *q != '\n') tok += *q++;
+        auto [pp, ec2] = std::from_chars(tok.data(), tok.data() + tok.size(), v);
+        if (ec2 != std::errc{} || pp != tok.data() + tok.size()) return nullptr;
+        return q;
+    }
+    return p;
+}
+
+inline const char* skip_space(const char* p, const char* last) {
+    while (p != last && is_space(*p)) ++p;
+    return p;
+}
+
+// Parses the lines of [first, last), which starts and ends on line boundaries.
+inline void parse_body(const char* first, const char* last, int norb, Chunk& out) {
+    const char* p = first;
+    while (p != last) {
+        const char* eol = std::find(p, last, '\n');
+        const char* q   = skip_space(p, eol);
+        if (q != eol) {
+            double v   = 0.0;
+            int    idx[4] = {0, 0, 0, 0};
+            q = parse_double(q, eol, v);
+            for (int n = 0; q && n < 4; ++n) {
+                q = skip_space(q, eol);
+                auto [r, ec] = std::from_chars(q, eol, idx[n]);
+                q = (ec == std::errc{} && idx[n] >= 0 && idx[n] <= norb) ? r : nullptr;
+            }
+            if (q) q = skip_space(q, eol);
+            if (!q || q != eol) {
+                if (out.error.empty()) out.error = "malformed line \"" + std::string(p, eol) + "\"";
+            } else if (idx[0] == 0) {
+                out.core = v;
+            } else if (idx[1] == 0) {
+                out.eps.emplace_back(idx[0], v);
+            } else if (idx[2] == 0) {
+                if (idx[0] == idx[1]) out.h_diag.emplace_back(idx[0], v);
+            } else {
+                out.keys.push_back(compound_index(idx[0], idx[1], idx[2], idx[3]));
+                out.values.push_back(v);
+            }
+        }
+        p = eol == last ? last : eol + 1;
+    }
+}
+
+inline std::string upper(std::string_view s) {
+    std::string u(s);
+    for (auto& c : u) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return u;
+}
+
+}  // namespace detail
+
+// Parses the namelist and returns it; `body` receives the offset of the first
+// integral line.
+inline Header parse_header(std::string_view text, std::size_t& body) {
+    const std::string up = detail::upper(text.substr(0, std::min<std::size_t>(text.size(), 1 << 20)));
+    const std::size_t begin = up.find("&FCI");
+    if (begin == std::string::npos) throw std::runtime_error("FCIDUMP: missing &FCI header");
+    std::size_t end = up.find("&END", begin);
+    std::size_t stop = end == std::string::npos ? std::string::npos : end + 4;
+    if (end == std::string::npos) {                  // F90 "/" terminator
+        end = up.find('/', begin);
+        if (end == std::string::npos) throw std::runtime_error("FCIDUMP: unterminated header");
+        stop = end + 1;
+    }
+    const std::size_t eol = up.find('\n', stop);
+    body = eol == std::string::npos ? text.size() : eol + 1;
+
+    // NAME=v1,v2,... pairs; commas and newlines are separators.
+    std::string nl = up.substr(begin + 4, end - begin - 4);
+    for (auto& c : nl)
+        if (c == ',' || c == '\n' || c == '\r' || c == '\t') c = ' ';
+    Header h;
+    std::string name;
+    std::size_t i = 0;
+    while (i < nl.size()) {
+        while (i < nl.size() && nl[i] == ' ') ++i;
+        std::size_t j = i;
+        while (j < nl.size() && nl[j] != ' ' && nl[j] != '=') ++j;
+        const std::string tok = nl.substr(i, j - i);
+        std::size_t k = j;
+        while (k < nl.size() && nl[k] == ' ') ++k;
+        if (k < nl.size() && nl[k] == '=') {
+            name = tok;
+            i = k + 1;
+            continue;
+        }
+        if (!tok.empty()) {
+            int v = 0;
+            auto [p, ec] = std::from_chars(tok.data(), tok.data() + tok.size(), v);
+            if (ec != std::errc{} || p != tok.data() + tok.size())
+                throw std::runtime_error("FCIDUMP: bad value \"" + tok + "\" for " + name);
+            if      (name == "NORB")   h.norb = v;
+            else if (name == "NELEC")  h.nelec = v;
+            else if (name == "MS2")    h.ms2 = v;
+            else if (name == "ISYM")   h.isym = v;
+            else if (name == "ORBSYM") h.orbsym.push_back(v);
+        }
+        i = j;
+    }
+    if (h.norb <= 0) throw std::runtime_error("FCIDUMP: NORB missing or not positive");
+    return h;
+}
+
+// Splits the body into up to n_threads slices on line boundaries and parses
+// them concurrently; results come back in file order.
+inline std::vector<Chunk> parse_body(std::string_view text, std::size_t body, int norb,
+                                     unsigned n_threads) {
+    constexpr std::size_t min_slice = 1 << 16;   // below this a thread costs more than it saves
+    const std::size_t n = text.size() - body;
+    if (n_threads == 0) n_threads = std::max(1u, std::thread::hardware_concurrency());
+    const auto slices = static_cast<std::size_t>(
+        std::clamp<std::size_t>(n / min_slice, 1, n_threads));
+
+    std::vector<std::size_t> cut(slices + 1, text.size());
+    cut[0] = body;
+    for (std::size_t s = 1; s < slices; ++s) {
+        const std::size_t at = text.find('\n', body + s * n / slices);
+        cut[s] = at == std::string_view::npos ? text.size() : at + 1;
+        cut[s] = std::max(cut[s], cut[s - 1]);
+    }
+
+    std::vector<Chunk> chunks(slices);
+    auto work = [&](std::size_t s) {
+        detail::parse_body(text.data() + cut[s], text.data() + cut[s + 1], norb, chunks[s]);
+    };
+    std::vector<std::thread> pool;
+    for (std::size_t s = 1; s < slices; ++s) pool.emplace_back(work, s);
+    work(0);
+    for (auto& t : pool) t.join();
+    return chunks;
+}
+
+inline bool looks_like(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char buf[64] = {};
+    in.read(buf, sizeof(buf));
+    const std::string head = detail::upper(std::string_view(buf, static_cast<std::size_t>(in.gcount())));
+    const std::size_t p = head.find_first_not_of(" \t\r\n");
+    return p != std::string::npos && head.compare(p, 4, "&FCI") == 0;
+}
+
+}  // namespace fcidump
+
+// Builds a CcsdConfig from an FCIDUMP file. Orbital energies are taken from
+// the eps_i lines when present, otherwise from the RHF Fock diagonal
+// f_pp = h_pp + sum_i [2(pp|ii) - (pi|ip)] over the NELEC/2 occupied
+// orbitals. EN is the RHF electronic energy sum_i (h_ii + f_ii); the core
+// energy becomes ENUC and ORBSYM becomes orbital_symmetry. `n_threads` = 0 uses every hardware thread.
+inline CcsdConfig read_fcidump(const std::string& path, unsigned n_threads = 0) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) throw std::runtime_error("Cannot open " + path);
+    std::string text(static_cast<std::size_t>(in.tellg()), '\0');
+    in.seekg(0);
+    in.read(text.data(), static_cast<std::streamsize>(text.size()));
+
+    std::size_t body = 0;
+    const fcidump::Header h = fcidump::parse_header(text, body);
+    auto chunks = fcidump::parse_body(text, body, h.norb, n_threads);
+
+    CcsdConfig c{CcsdConfig::direct_init{}};
+    c.n_spatial_orbitals = h.norb;
+    c.n_occupied         = h.nelec;
+    c.orbital_symmetry   = h.orbsym;
+
+    const auto n = static_cast<std::size_t>(h.norb);
+    std::vector<double> h_diag(n, 0.0), eps(n, 0.0);
+    std::vector<bool>   have_h(n, false), have_eps(n, false);
+    std::size_t n_tei = 0;
+    for (const auto& ch : chunks) {
+        if (!ch.error.empty()) throw std::runtime_error("FCIDUMP " + path + ": " + ch.error);
+        n_tei += ch.keys.size();
+    }
+    c.two_electron_mos.reserve(n_tei);
+    for (auto& ch : chunks) {
+        for (std::size_t i = 0; i < ch.keys.size(); ++i)
+            c.two_electron_mos.insert(ch.keys[i], ch.values[i]);
+        for (auto [p, v] : ch.h_diag) { h_diag[static_cast<std::size_t>(p - 1)] = v; have_h[static_cast<std::size_t>(p - 1)] = true; }
+        for (auto [p, v] : ch.eps)    { eps[static_cast<std::size_t>(p - 1)] = v;    have_eps[static_cast<std::size_t>(p - 1)] = true; }
+        if (ch.core) c.nuclear_repulsion = *ch.core;
+        ch = {};   // release the slice before the next one is merged
+    }
+    c.two_electron_mos.finalize();
+
+    for (std::size_t p = 0; p < n; ++p)
+        if (!have_h[p])
+            throw std::runtime_error("FCIDUMP " + path + ": no h_ii for orbital " + std::to_string(p + 1));
+
+    const int n_docc = h.nelec / 2;
+    auto g = [&](int a, int b, int cc, int d) {
+        const double* v = c.two_electron_mos.find(compound_index(a, b, cc, d));
+        return v ? *v : 0.0;
+    };
+    const bool all_eps = std::all_of(have_eps.begin(), have_eps.end(), [](bool b) { return b; });
+    c.orbital_energies.resize(n);
+    for (std::size_t p = 0; p < n; ++p) {
+        if (all_eps) {
+            c.orbital_energies[p] = eps[p];
+            continue;
+        }
+        const int pp = static_cast<int>(p) + 1;
+        double f = h_diag[p];
+        for (int i = 1; i <= n_docc; ++i) f += 2.0 * g(pp, pp, i, i) - g(pp, i, i, pp);
+        c.orbital_energies[p] = f;
+    }
+    c.hf_energy = 0.0;
+    for (std::size_t i = 0; i < static_cast<std::size_t>(std::max(n_docc, 0)) && i < n; ++i)
+        c.hf_energy += h_diag[i] + c.orbital_energies[i];
+
+    c.validate();
+    return c;
+}
+
+}  // namespace ccsd
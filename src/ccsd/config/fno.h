@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <ccsd/config/ccsd_config.h>
+#include <util/linalg/symmetric_eigen.h>
+
+namespace ccsd {
+
+// Outcome of truncate_virtuals_fno(). The MP2 energies are closed-shell
+// correlation energies in the active space before and after truncation;
+// their difference estimates what the dropped virtuals would contribute.
+struct FnoResult {
+    int n_virtual = 0;        // spatial virtuals before truncation
+    int n_virtual_kept = 0;   // natural virtuals kept
+    double mp2_full = 0.0;
+    double mp2_truncated = 0.0;
+    std::vector<double> occupations;   // every natural virtual occupation, descending
+    [[nodiscard]] double correction() const noexcept { return mp2_full - mp2_truncated; }
+};
+
+namespace detail {
+
+// Dense (pq|rs) of a config's n spatial orbitals, 0-based, row-major.
+class DenseEri {
+public:
+    explicit DenseEri(int n) : n_(static_cast<std::size_t>(n)), g_(n_ * n_ * n_ * n_, 0.0) {}
+    explicit DenseEri(const CcsdConfig& c) : DenseEri(c.n_spatial_orbitals) {
+        const int n = c.n_spatial_orbitals;
+        for (int p = 0; p < n; ++p)
+            for (int q = 0; q < n; ++q)
+                for (int r = 0; r < n; ++r)
+                    for (int s = 0; s < n; ++s) (*this)(p, q, r, s) = c.eri(p + 1, q + 1, r + 1, s + 1);
+    }
+    [[nodiscard]] double& operator()(int p, int q, int r, int s) { return g_[index(p, q, r, s)]; }
+    [[nodiscard]] double operator()(int p, int q, int r, int s) const { return g_[index(p, q, r, s)]; }
+    [[nodiscard]] int n() const noexcept { return static_cast<int>(n_); }
+
+private:
+    std::size_t n_;
+    std::vector<double> g_;
+    [[nodiscard]] std::size_t index(int p, int q, int r, int s) const noexcept {
+        return ((static_cast<std::size_t>(p) * n_ + static_cast<std::size_t>(q)) * n_
+                + static_cast<std::size_t>(r)) * n_ + static_cast<std::size_t>(s);
+    }
+};
+
+// Closed-shell MP2 amplitude T^{ab}_{ij} = (ia|jb) / (e_i + e_j - e_a - e_b).
+inline double mp2_amplitude(const DenseEri& g, const std::vector<double>& e, int i, int j, int a, int b) {
+    const auto u = [](int x) { return static_cast<std::size_t>(x); };
+    return g(i, a, j, b) / (e[u(i)] + e[u(j)] - e[u(a)] - e[u(b)]);
+}
+
+// Σ_{ijab} T^{ab}_{ij} [2 (ia|jb) - (ib|ja)] over o doubly occupied orbitals.
+inline double mp2_energy(const DenseEri& g, const std::vector<double>& e, int o) {
+    double energy = 0.0;
+    for (int i = 0; i < o; ++i)
+        for (int j = 0; j < o; ++j)
+            for (int a = o; a < g.n(); ++a)
+                for (int b = o; b < g.n(); ++b)
+                    energy += mp2_amplitude(g, e, i, j, a, b) * (2.0 * g(i, a, j, b) - g(i, b, j, a));
+    return energy;
+}
+
+// (pq|rs) in the orbitals given by the columns of c (n x m, row-major):
+// four quarter transforms, O(n^5).
+inline DenseEri transform_eri(const DenseEri& g, const std::vector<double>& c, int m) {
+    const int n = g.n();
+    const auto C = [&](int p, int P) {
+        return c[static_cast<std::size_t>(p) * static_cast<std::size_t>(m) + static_cast<std::size_t>(P)];
+    };
+    // Index 0 of the input runs over n; each pass replaces one index.
+    DenseEri a(std::max(n, m)), b(std::max(n, m));
+    for (int P = 0; P < m; ++P)
+        for (int q = 0; q < n; ++q) for (int r = 0; r < n; ++r) for (int s = 0; s < n; ++s) {
+            double v = 0.0;
+            for (int p = 0; p < n; ++p) v += C(p, P) * g(p, q, r, s);
+            a(P, q, r, s) = v;
+        }
+    for (int P = 0; P < m; ++P) for (int Q = 0; Q < m; ++Q)
+        for (int r = 0; r < n; ++r) for (int s = 0; s < n; ++s) {
+            double v = 0.0;
+            for (int q = 0; q < n; ++q) v += C(q, Q) * a(P, q, r, s);
+            b(P, Q, r, s) = v;
+        }
+    for (int P = 0; P < m; ++P) for (int Q = 0; Q < m; ++Q)
+        for (int R = 0; R < m; ++R) for (int s = 0; s < n; ++s) {
+            double v = 0.0;
+            for (int r = 0; r < n; ++r) v += C(r, R) * b(P, Q, r, s);
+            a(P, Q, R, s) = v;
+        }
+    DenseEri out(m);
+    for (int P = 0; P < m; ++P) for (int Q = 0; Q < m; ++Q)
+        for (int R = 0; R < m; ++R) for (int S = 0; S < m; ++S) {
+            double v = 0.0;
+            for (int s = 0; s < n; ++s) v += C(s, S) * a(P, Q, R, s);
+            out(P, Q, R, S) = v;
+        }
+    return out;
+}
+
+}  // namespace detail
+
+// Frozen natural orbitals (Taube & Bartlett 2005). From the MP2 amplitudes
+// of the current (canonical HF) orbitals, the virtual one-particle density
+//   D_ab = Σ_ijc [ T^{ac}_ij T^{bc}_ij + ½ A^{ac}_ij A^{bc}_ij ],
+//   A^{ac}_ij = T^{ac}_ij - T^{ca}_ij,
+// is diagonalized (per irrep when orbital_symmetry is set); natural virtuals
+// with occupation <= occupation_threshold are dropped, and the kept ones are
+// semicanonicalized so the virtual Fock block is diagonal again. The
+// integrals, orbital energies and irreps of `c` are rewritten in the new
+// basis (an external integral view is replaced by the new table);
+// occupied orbitals are untouched. O(n^5) and replicated per rank.
+inline FnoResult truncate_virtuals_fno(CcsdConfig& c, double occupation_threshold) {
+    const int n  = c.n_spatial_orbitals;
+    const int o  = c.n_occupied / 2;
+    const int nv = n - o;
+    const detail::DenseEri g(c);
+    const std::vector<double>& e = c.orbital_energies;
+    const auto u = [](int x) { return static_cast<std::size_t>(x); };
+
+    FnoResult r;
+    r.n_virtual = nv;
+    r.mp2_full  = detail::mp2_energy(g, e, o);
+
+    std::vector<double> D(u(nv) * u(nv), 0.0);
+    for (int i = 0; i < o; ++i)
+        for (int j = 0; j < o; ++j)
+            for (int cc = o; cc < n; ++cc)
+                for (int a = o; a < n; ++a) {
+                    const double t_ac = detail::mp2_amplitude(g, e, i, j, a, cc);
+                    const double A_ac = t_ac - detail::mp2_amplitude(g, e, i, j, cc, a);
+                    for (int b = o; b < n; ++b) {
+                        const double t_bc = detail::mp2_amplitude(g, e, i, j, b, cc);
+                        const double A_bc = t_bc - detail::mp2_amplitude(g, e, i, j, cc, b);
+                        D[u(a - o) * u(nv) + u(b - o)] += t_ac * t_bc + 0.5 * A_ac * A_bc;
+                    }
+                }
+
+    // Virtual blocks by irrep (one block without symmetry).
+    std::vector<int> irreps;
+    for (int a = o; a < n; ++a) {
+        const int s = c.orbital_symmetry.empty() ? 1 : c.orbital_symmetry[u(a)];
+        if (std::find(irreps.begin(), irreps.end(), s) == irreps.end()) irreps.push_back(s);
+    }
+    struct Virtual { double energy; int irrep; std::vector<double> coeff; };   // coeff over old virtuals
+    std::vector<Virtual> kept;
+    for (int s : irreps) {
+        std::vector<int> idx;   // virtual offsets in this irrep
+        for (int a = o; a < n; ++a)
+            if ((c.orbital_symmetry.empty() ? 1 : c.orbital_symmetry[u(a)]) == s) idx.push_back(a - o);
+        const int m = static_cast<int>(idx.size());
+        std::vector<double> block(u(m) * u(m));
+        for (int x = 0; x < m; ++x)
+            for (int y = 0; y < m; ++y)
+                block[u(x) * u(m) + u(y)] = D[u(idx[u(x)]) * u(nv) + u(idx[u(y)])];
+        const auto no = linalg::symmetric_eigen(std::move(block), m);
+        r.occupations.insert(r.occupations.end(), no.values.begin(), no.values.end());
+
+        std::vector<int> keep;
+        for (int k = 0; k < m; ++k)
+            if (no.values[u(k)] > occupation_threshold) keep.push_back(k);
+        const int mk = static_cast<int>(keep.size());
+        if (mk == 0) continue;
+        // Semicanonical: diagonalize U^T diag(e_v) U over the kept NOs.
+        std::vector<double> f(u(mk) * u(mk), 0.0);
+        for (int x = 0; x < mk; ++x)
+            for (int y = 0; y < mk; ++y)
+                for (int k = 0; k < m; ++k)
+                    f[u(x) * u(mk) + u(y)] += no.vectors[u(k) * u(m) + u(keep[u(x)])]
+                                            * e[u(o + idx[u(k)])]
+                                            * no.vectors[u(k) * u(m) + u(keep[u(y)])];
+        const auto sc = linalg::symmetric_eigen(std::move(f), mk);
+        for (int z = 0; z < mk; ++z) {
+            Virtual v{sc.values[u(z)], s, std::vector<double>(u(nv), 0.0)};
+            for (int k = 0; k < m; ++k)
+                for (int x = 0; x < mk; ++x)
+                    v.coeff[u(idx[u(k)])] += no.vectors[u(k) * u(m) + u(keep[u(x)])] * sc.vectors[u(x) * u(mk) + u(z)];
+            kept.push_back(std::move(v));
+        }
+    }
+    std::sort(r.occupations.rbegin(), r.occupations.rend());
+    if (kept.empty()) throw std::runtime_error("fno threshold leaves no virtual orbitals");
+    std::stable_sort(kept.begin(), kept.end(),
+                     [](const Virtual& x, const Virtual& y) { return x.energy < y.energy; });
+
+    const int nk = static_cast<int>(kept.size());
+    const int m  = o + nk;
+    std::vector<double> C(u(n) * u(m), 0.0);   // old orbital -> new orbital
+    for (int i = 0; i < o; ++i) C[u(i) * u(m) + u(i)] = 1.0;
+    for (int k = 0; k < nk; ++k)
+        for (int a = 0; a < nv; ++a) C[u(o + a) * u(m) + u(o + k)] = kept[u(k)].coeff[u(a)];
+    const detail::DenseEri h = detail::transform_eri(g, C, m);
+
+    std::vector<double> energies(e.begin(), e.begin() + o);
+    std::vector<int> symmetry;
+    if (!c.orbital_symmetry.empty()) symmetry.assign(c.orbital_symmetry.begin(), c.orbital_symmetry.begin() + o);
+    for (const Virtual& v : kept) {
+        energies.push_back(v.energy);
+        if (!c.orbital_symmetry.empty()) symmetry.push_back(v.irrep);
+    }
+    r.n_virtual_kept = nk;
+    r.mp2_truncated  = detail::mp2_energy(h, energies, o);
+
+    // Canonical (ab|cd) in compound-index order, as freeze_core() writes them.
+    IntegralTable tei;
+    for (int a = 0; a < m; ++a)
+        for (int b = 0; b <= a; ++b)
+            for (int cc = 0; cc <= a; ++cc)
+                for (int d = 0; d <= (cc == a ? b : cc); ++d)
+                    if (const double v = h(a, b, cc, d); v != 0.0)
+                        tei.insert(compound_index(a + 1, b + 1, cc + 1, d + 1), v);
+    tei.finalize();
+
+    c.two_electron_mos   = std::move(tei);
+    c.external_integrals = IntegralView{};   // the rotated integrals are new data
+    c.orbital_energies   = std::move(energies);
+    c.orbital_symmetry   = std::move(symmetry);
+    c.n_spatial_orbitals = m;
+    c.validate();
+    return r;
+}
+
+}  // namespace ccsd
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace ccsd {
+
+// Compound index of a chemist-notation integral (ab|cd) that is invariant
+// under the 8-fold permutational symmetry a<->b, c<->d, (ab)<->(cd).
+// Indices are passed as doubles to match the historical JSON "ttmo" keys.
+inline double compound_index(double a, double b, double c, double d) {
+    const double ab = a > b ? a*(a+1)/2 + b : b*(b+1)/2 + a;
+    const double cd = c > d ? c*(c+1)/2 + d : d*(d+1)/2 + c;
+    return ab > cd ? ab*(ab+1)/2 + cd : cd*(cd+1)/2 + ab;
+}
+
+// Two-electron MO integrals keyed by compound_index, stored as two parallel
+// arrays sorted by key. Filled with insert() (any order) followed by
+// finalize(); lookups are a binary search. Against a std::map this drops one
+// node allocation per integral and keeps the data contiguous, so it can be
+// broadcast as is.
+class IntegralTable {
+public:
+    void reserve(std::size_t n) { keys_.reserve(n); values_.reserve(n); }
+
+    void insert(double key, double value) {
+        keys_.push_back(key);
+        values_.push_back(value);
+    }
+
+    // Sorts by key; for duplicate keys the first inserted value wins (as
+    // std::map::emplace did). Inputs that are already sorted cost one pass.
+    void finalize() {
+        if (!std::is_sorted(keys_.begin(), keys_.end())) {
+            std::vector<std::size_t> order(keys_.size());
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            std::stable_sort(order.begin(), order.end(),
+                             [&](std::size_t a, std::size_t b) { return keys_[a] < keys_[b]; });
+            std::vector<double> k(order.size()), v(order.size());
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                k[i] = keys_[order[i]];
+                v[i] = values_[order[i]];
+            }
+            keys_.swap(k);
+            values_.swap(v);
+        }
+        std::size_t out = 0;
+        for (std::size_t i = 0; i < keys_.size(); ++i) {
+            if (out > 0 && keys_[out - 1] == keys_[i]) continue;
+            keys_[out]   = keys_[i];
+            values_[out] = values_[i];
+            ++out;
+        }
+        keys_.resize(out);
+        values_.resize(out);
+    }
+
+    // Pointer to the value for `key`, or nullptr if absent.
+    [[nodiscard]] const double* find(double key) const {
+        const auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+        if (it == keys_.end() || *it != key) return nullptr;
+        return &values_[static_cast<std::size_t>(it - keys_.begin())];
+    }
+
+    [[nodiscard]] double at(double key) const {
+        const double* v = find(key);
+        if (!v) throw std::out_of_range("IntegralTable::at: key not present");
+        return *v;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return keys_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return keys_.empty(); }
+
+    // Raw access for bulk transfer; resize() then fill both arrays in
+    // sorted order (e.g. by broadcasting a finalized table).
+    void resize(std::size_t n) { keys_.resize(n); values_.resize(n); }
+    [[nodiscard]] double* key_data() noexcept { return keys_.data(); }
+    [[nodiscard]] double* value_data() noexcept { return values_.data(); }
+    [[nodiscard]] const double* key_data() const noexcept { return keys_.data(); }
+    [[nodiscard]] const double* value_data() const noexcept { return values_.data(); }
+
+private:
+    std::vector<double> keys_;
+    std::vector<double> values_;
+};
+
+}  // namespace ccsd
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+
+#include <ccsd/config/integral_table.h>
+#include <util/tensors/tensor_view.h>
+
+namespace ccsd {
+
+// Caller-owned spatial two-electron integrals (pq|rs), chemist notation,
+// read in place instead of being copied into an IntegralTable. Two layouts:
+//   dense   every (pq|rs) at any strides (e.g. an n^4 array from an SCF
+//           code in C or Fortran order);
+//   packed  one value per 8-fold-unique integral, at offset
+//           compound_index(p, q, r, s) of the 0-based indices: the
+//           P(P+1)/2 values, P = n(n+1)/2, that many SCF codes store.
+// `first` is the first orbital in view: freeze_core() advances it instead
+// of copying the active block. The buffer must outlive every solve that
+// reads it.
+struct IntegralView {
+    enum class Layout { dense, packed };
+
+    Layout layout = Layout::dense;
+    TensorView<4> dense;              // layout == dense
+    const double* packed = nullptr;   // layout == packed
+    int n_orbitals = 0;               // orbitals in the buffer
+    int first      = 0;
+
+    [[nodiscard]] static IntegralView from_dense(TensorView<4> eri) noexcept {
+        IntegralView v;
+        v.dense      = eri;
+        v.n_orbitals = eri.extents[0];
+        return v;
+    }
+    [[nodiscard]] static IntegralView from_packed(const double* data, int n) noexcept {
+        IntegralView v;
+        v.layout     = Layout::packed;
+        v.packed     = data;
+        v.n_orbitals = n;
+        return v;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return layout == Layout::dense ? dense.empty() : packed == nullptr;
+    }
+    // Orbitals visible after freezing.
+    [[nodiscard]] int n_active() const noexcept { return n_orbitals - first; }
+
+    // (pq|rs) of active orbitals, 0-based.
+    [[nodiscard]] double operator()(int p, int q, int r, int s) const noexcept {
+        p += first; q += first; r += first; s += first;
+        if (layout == Layout::dense) return dense(p, q, r, s);
+        return packed[static_cast<std::size_t>(compound_index(p, q, r, s))];
+    }
+};
+
+}  // namespace ccsd
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+#include <ccsd/config/ccsd_config.h>
+#include <ccsd/config/fcidump.h>
+
+namespace ccsd {
+
+// Loads either input format, chosen by content: a file starting with an
+// "&FCI" namelist is read as FCIDUMP, anything else as the JSON config.
+inline CcsdConfig load_config(const std::string& path) {
+    if (fcidump::looks_like(path)) return read_fcidump(path);
+    return CcsdConfig(path);
+}
+
+}  // namespace ccsd
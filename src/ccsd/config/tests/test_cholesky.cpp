@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <ccsd/config/ccsd_config.h>
+#include <ccsd/config/cholesky.h>
+
+using Catch::Approx;
+
+namespace {
+
+// Largest |(pq|rs) - Σ_Q L L| over every index quadruple.
+double max_error(const ccsd::CcsdConfig& c, const ccsd::CholeskyVectors& L) {
+    const int n = c.n_spatial_orbitals;
+    double err = 0.0;
+    for (int p = 0; p < n; ++p)
+        for (int q = 0; q < n; ++q)
+            for (int r = 0; r < n; ++r)
+                for (int s = 0; s < n; ++s) {
+                    const double* v = c.two_electron_mos.find(ccsd::compound_index(p + 1, q + 1, r + 1, s + 1));
+                    err = std::max(err, std::abs((v ? *v : 0.0) - L.eri(p, q, r, s)));
+                }
+    return err;
+}
+
+// Five orbitals whose pair matrix is three dominant rank-one terms plus a
+// small diagonal: a loose tolerance needs only the dominant vectors.
+ccsd::CcsdConfig make_config() {
+    ccsd::CcsdConfig c{ccsd::CcsdConfig::direct_init{}};
+    c.n_spatial_orbitals = 5;
+    auto u = [](int k, int p, int q) { return std::cos(1.3 * k + 0.7 * p + 0.4 * q) / (k + 1); };
+    for (int a = 1; a <= 5; ++a)
+        for (int b = 1; b <= a; ++b)
+            for (int cc = 1; cc <= 5; ++cc)
+                for (int d = 1; d <= cc; ++d) {
+                    double v = (a == cc && b == d) ? 1e-3 : 0.0;
+                    for (int k = 0; k < 3; ++k) v += u(k, a, b) * u(k, cc, d);
+                    c.two_electron_mos.insert(ccsd::compound_index(a, b, cc, d), v);
+                }
+    c.two_electron_mos.finalize();
+    return c;
+}
+
+}  // namespace
+
+TEST_CASE("cholesky_decompose reproduces the HeH+ integrals", "[cholesky]") {
+    const ccsd::CcsdConfig c("./config.json");
+    const auto L = ccsd::cholesky_decompose(c.two_electron_mos, c.n_spatial_orbitals, 1e-12);
+    REQUIRE(L.n_orbitals() == 2);
+    REQUIRE(L.n_vectors() <= 3);   // at most one vector per orbital pair
+    REQUIRE(max_error(c, L) < 1e-12);
+}
+
+TEST_CASE("cholesky_decompose stops at the requested tolerance", "[cholesky]") {
+    const auto c = make_config();
+    const auto exact = ccsd::cholesky_decompose(c.two_electron_mos, 5, 1e-14);
+    const auto loose = ccsd::cholesky_decompose(c.two_electron_mos, 5, 1e-2);
+    REQUIRE(exact.n_vectors() == 15);
+    REQUIRE(max_error(c, exact) < 1e-12);
+    REQUIRE(loose.n_vectors() <= 3);
+    REQUIRE(max_error(c, loose) <= 1e-2);
+}
+
+TEST_CASE("Cholesky vector files round-trip and reject foreign input", "[cholesky]") {
+    const auto c = make_config();
+    const auto L = ccsd::cholesky_decompose(c.two_electron_mos, 5, 1e-6);
+    const std::string path = "test_cholesky_tmp.bin";
+    ccsd::write_cholesky(path, L);
+    const auto R = ccsd::read_cholesky(path);
+    REQUIRE(R.n_orbitals() == L.n_orbitals());
+    REQUIRE(R.n_vectors() == L.n_vectors());
+    REQUIRE(R.data() == L.data());
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a cholesky file";
+    }
+    REQUIRE_THROWS_WITH(ccsd::read_cholesky(path), "cholesky " + path + ": not a Cholesky vector file");
+    std::remove(path.c_str());
+}
@@ -3,6 +3,7 @@
 #include <cstdio>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include <ccsd/config/ccsd_config.h>
 
@@ -34,3 +35,98 @@ TEST_CASE("CcsdConfig parses a name-keyed config", "[parameters]") {
     REQUIRE(p.two_electron_mos.at(1.5) == 0.42);
     std::remove(path.c_str());
 }
+
+namespace {
+std::string write_tmp(const std::string& path, const char* text) {
+    std::ofstream out(path);
+    out << text;
+    return path;
+}
+}  // namespace
+
+TEST_CASE("CcsdConfig streams unsorted ttmo into a sorted table and skips unknown keys", "[parameters]") {
+    const auto path = write_tmp("test_config_stream.json", R"({
+      "comment": {"nested": [1, 2, {"x": "y"}]},
+      "ttmo": [9.0, 0.9, 2.0, 0.2, 9.0, 0.8, 5.0],
+      "dim": 2, "Nelec": 2,
+      "orbital_energy": [-0.5, 0.5],
+      "ENUC": 1.0, "EN": -1.0
+    })");
+    ccsd::CcsdConfig p(path);
+    REQUIRE(p.two_electron_mos.size() == 2);          // duplicate 9.0 dropped, trailing 5.0 ignored
+    REQUIRE(p.two_electron_mos.at(2.0) == 0.2);
+    REQUIRE(p.two_electron_mos.at(9.0) == 0.9);       // first value wins
+    REQUIRE(p.two_electron_mos.find(5.0) == nullptr);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("CcsdConfig reports missing and mistyped keys", "[parameters]") {
+    const auto missing = write_tmp("test_config_missing.json",
+        R"({"dim": 2, "Nelec": 2, "orbital_energy": [0, 1], "ENUC": 1.0, "ttmo": []})");
+    REQUIRE_THROWS_WITH(ccsd::CcsdConfig(missing), "config: missing key \"EN\"");
+    std::remove(missing.c_str());
+
+    const auto mistyped = write_tmp("test_config_mistyped.json",
+        R"({"dim": "2", "Nelec": 2, "orbital_energy": [0, 1], "ENUC": 1.0, "EN": 0.0, "ttmo": []})");
+    REQUIRE_THROWS_WITH(ccsd::CcsdConfig(mistyped), "config: \"dim\" has the wrong type");
+    std::remove(mistyped.c_str());
+}
+
+TEST_CASE("CcsdConfig header blob round-trips scalars and orbital energies", "[parameters]") {
+    const auto path = write_tmp("test_config_blob.json", kFixture);
+    const ccsd::CcsdConfig src(path);
+    std::remove(path.c_str());
+
+    ccsd::CcsdConfig dst{ccsd::CcsdConfig::direct_init{}};
+    REQUIRE(dst.read_header_blob(src.header_blob()) == src.two_electron_mos.size());
+    REQUIRE(dst.n_spatial_orbitals == 2);
+    REQUIRE(dst.n_occupied == 2);
+    REQUIRE(dst.orbital_energies == src.orbital_energies);
+    REQUIRE(dst.nuclear_repulsion == src.nuclear_repulsion);
+    REQUIRE(dst.hf_energy == src.hf_energy);
+    REQUIRE(dst.two_electron_mos.size() == src.two_electron_mos.size());
+}
+
+TEST_CASE("CcsdConfig applies frozen_core and renumbers the active integrals", "[parameters]") {
+    const auto path = write_tmp("test_config_frozen.json", R"({
+      "dim": 3, "Nelec": 4, "frozen_core": 1, "orbsym": [1, 3, 1],
+      "orbital_energy": [-20.0, -0.5, 0.5],
+      "ENUC": 1.0, "EN": -1.0,
+      "ttmo": [5.0, 9.9, 17.0, 0.1, 20.0, 0.3, 50.0, 0.2, 54.0, 0.4]
+    })");
+    // Keys are compound_index: (11|11) = 5, (22|11) = 17, (22|22) = 20,
+    // (33|22) = 50, (33|33) = 54.
+    ccsd::CcsdConfig p(path);
+    std::remove(path.c_str());
+    REQUIRE(p.frozen_core == 1);
+    REQUIRE(p.n_spatial_orbitals == 2);
+    REQUIRE(p.n_occupied == 2);
+    REQUIRE(p.orbital_energies == std::vector<double>{-0.5, 0.5});
+    REQUIRE(p.orbital_symmetry == std::vector<int>{3, 1});
+    REQUIRE(p.hf_energy == -1.0);
+    // Integrals touching orbital 1 are dropped; the rest shift down by one.
+    REQUIRE(p.two_electron_mos.size() == 3);
+    REQUIRE(p.two_electron_mos.at(5.0) == 0.3);
+    REQUIRE(p.two_electron_mos.at(17.0) == 0.2);
+    REQUIRE(p.two_electron_mos.at(20.0) == 0.4);
+
+    ccsd::CcsdConfig dst{ccsd::CcsdConfig::direct_init{}};
+    dst.read_header_blob(p.header_blob());
+    REQUIRE(dst.frozen_core == 1);
+    REQUIRE(dst.orbital_symmetry == p.orbital_symmetry);
+
+    REQUIRE_THROWS_WITH(p.freeze_core(1), "frozen_core must leave at least one occupied orbital");
+}
+
+TEST_CASE("CcsdConfig rejects orbsym of the wrong size or out of range", "[parameters]") {
+    ccsd::CcsdConfig c{ccsd::CcsdConfig::direct_init{}};
+    c.n_spatial_orbitals = 2;
+    c.n_occupied         = 2;
+    c.orbital_energies   = {-0.5, 0.5};
+    c.orbital_symmetry   = {1};
+    REQUIRE_THROWS_WITH(c.validate(), "orbital_symmetry size mismatch");
+    c.orbital_symmetry   = {1, 9};
+    REQUIRE_THROWS_WITH(c.validate(), "orbital_symmetry labels must be in 1..8");
+    c.orbital_symmetry   = {1, 8};
+    REQUIRE_NOTHROW(c.validate());
+}
@@ -0,0 +1,99 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <ccsd/config/fcidump.h>
+#include <ccsd/config/load_config.h>
+
+using Catch::Approx;
+
+namespace {
+std::string write_tmp(const std::string& path, const std::string& text) {
+    std::ofstream out(path);
+    out << text;
+    return path;
+}
+
+// HeH+/STO-3G, same integrals as config.json, without eps_i lines.
+const char* kHehpNoEps =
+    " &FCI NORB=2,NELEC=2,MS2=0,\n"
+    "  ORBSYM=1,1,\n"
+    "  ISYM=1,\n"
+    " &END\n"
+    "  9.4542695583037617D-01    1    1    1    1\n"
+    "  1.7535895381500544E-01    2    1    1    1\n"
+    "  1.2682234020148653E-01    2    1    2    1\n"
+    "  5.9855327701641903E-01    2    2    1    1\n"
+    " -5.6821143621433257E-02    2    2    2    1\n"
+    "  7.4715464784363106E-01    2    2    2    2\n"
+    " -2.4692135177200000E+00    1    1    0    0\n"
+    " -1.3379156938313514E+00    2    2    0    0\n"
+    "  1.1386276671000000E+00    0    0    0    0\n";
+}  // namespace
+
+TEST_CASE("read_fcidump matches the JSON config integral for integral", "[parameters][fcidump]") {
+    const ccsd::CcsdConfig json("./config.json");
+    const ccsd::CcsdConfig fci = ccsd::load_config("./config.fcidump");
+
+    REQUIRE(fci.n_spatial_orbitals == json.n_spatial_orbitals);
+    REQUIRE(fci.n_occupied == json.n_occupied);
+    REQUIRE(fci.nuclear_repulsion == json.nuclear_repulsion);
+    REQUIRE(fci.orbital_energies == json.orbital_energies);
+    REQUIRE(fci.hf_energy == Approx(json.hf_energy).epsilon(1e-12));
+    REQUIRE(fci.two_electron_mos.size() == json.two_electron_mos.size());
+    for (std::size_t i = 0; i < json.two_electron_mos.size(); ++i) {
+        REQUIRE(fci.two_electron_mos.key_data()[i] == json.two_electron_mos.key_data()[i]);
+        REQUIRE(fci.two_electron_mos.value_data()[i] == json.two_electron_mos.value_data()[i]);
+    }
+}
+
+TEST_CASE("read_fcidump derives orbital energies from the Fock diagonal without eps lines", "[parameters][fcidump]") {
+    const ccsd::CcsdConfig json("./config.json");
+    const auto path = write_tmp("test_fcidump_noeps.fcidump", kHehpNoEps);
+    const ccsd::CcsdConfig fci = ccsd::read_fcidump(path, 1);
+    std::remove(path.c_str());
+
+    // config.json's EN and orbital energies agree with its integrals to ~2e-9.
+    REQUIRE(fci.orbital_energies[0] == Approx(json.orbital_energies[0]).epsilon(1e-8));
+    REQUIRE(fci.orbital_energies[1] == Approx(json.orbital_energies[1]).epsilon(1e-8));
+    REQUIRE(fci.hf_energy == Approx(json.hf_energy).epsilon(1e-8));
+    REQUIRE(fci.two_electron_mos.at(ccsd::compound_index(1, 1, 1, 1)) == 0.94542695583037617);
+}
+
+TEST_CASE("read_fcidump gives the same table for any thread count", "[parameters][fcidump]") {
+    // Enough lines that the body is split into several slices.
+    std::string text = " &FCI NORB=40,NELEC=2,\n &END\n";
+    for (int i = 1; i <= 40; ++i)
+        for (int j = 1; j <= i; ++j)
+            for (int k = 1; k <= 6; ++k)
+                text += "  " + std::to_string(0.001 * (i * 1000 + j * 10 + k)) + " " + std::to_string(i) + " "
+                      + std::to_string(j) + " " + std::to_string(k) + " 1\n";
+    for (int i = 1; i <= 40; ++i) text += "  -1.0 " + std::to_string(i) + " " + std::to_string(i) + " 0 0\n";
+    text += "  0.5 0 0 0 0\n";
+    const auto path = write_tmp("test_fcidump_threads.fcidump", text);
+
+    const ccsd::CcsdConfig one  = ccsd::read_fcidump(path, 1);
+    const ccsd::CcsdConfig many = ccsd::read_fcidump(path, 8);
+    std::remove(path.c_str());
+
+    REQUIRE(one.two_electron_mos.size() == many.two_electron_mos.size());
+    for (std::size_t i = 0; i < one.two_electron_mos.size(); ++i) {
+        REQUIRE(one.two_electron_mos.key_data()[i] == many.two_electron_mos.key_data()[i]);
+        REQUIRE(one.two_electron_mos.value_data()[i] == many.two_electron_mos.value_data()[i]);
+    }
+    REQUIRE(many.nuclear_repulsion == 0.5);
+    REQUIRE(many.orbital_energies == one.orbital_energies);
+}
+
+TEST_CASE("read_fcidump rejects malformed lines and indices beyond NORB", "[parameters][fcidump]") {
+    const auto bad = write_tmp("test_fcidump_bad.fcidump", " &FCI NORB=2,NELEC=2 &END\n 0.5 1 1 x 1\n");
+    REQUIRE_THROWS(ccsd::read_fcidump(bad));
+    std::remove(bad.c_str());
+
+    const auto range = write_tmp("test_fcidump_range.fcidump", " &FCI NORB=2,NELEC=2 &END\n 0.5 3 1 1 1\n");
+    REQUIRE_THROWS(ccsd::read_fcidump(range));
+    std::remove(range.c_str());
+}
@@ -0,0 +1,60 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <ccsd/config/ccsd_config.h>
+#include <ccsd/config/fno.h>
+#include <ccsd/kernels/tests/test_systems.h>
+
+using Catch::Approx;
+
+namespace {
+
+// Six spatial orbitals (two doubly occupied) in irreps {1,2,1,2,1,2} with
+// pseudo-random, symmetry-clean integrals.
+ccsd::CcsdConfig make_config() {
+    return ccsd::test::pseudo_random_system(true, {-1.1, -0.7, 0.3, 0.5, 0.9, 1.6});
+}
+
+}  // namespace
+
+TEST_CASE("FNO keeping every virtual is an exact rotation", "[config][fno]") {
+    auto c = make_config();
+    const auto r = ccsd::truncate_virtuals_fno(c, -1.0);
+    REQUIRE(r.n_virtual == 4);
+    REQUIRE(r.n_virtual_kept == 4);
+    REQUIRE(r.mp2_full < 0.0);
+    REQUIRE(r.mp2_truncated == Approx(r.mp2_full).epsilon(1e-12));
+    REQUIRE(r.correction() == Approx(0.0).margin(1e-14));
+    REQUIRE(c.n_spatial_orbitals == 6);
+    REQUIRE(std::is_sorted(c.orbital_energies.begin() + 2, c.orbital_energies.end()));
+    // Virtual energies are a similarity transform of the originals.
+    double trace = 0.0;
+    for (int a = 2; a < 6; ++a) trace += c.orbital_energies[static_cast<std::size_t>(a)];
+    REQUIRE(trace == Approx(0.3 + 0.5 + 0.9 + 1.6));
+}
+
+TEST_CASE("FNO drops weakly occupied virtuals and reports their MP2 share", "[config][fno]") {
+    auto full = make_config();
+    const auto all = ccsd::truncate_virtuals_fno(full, -1.0);
+
+    REQUIRE(all.occupations.size() == 4);
+    REQUIRE(std::is_sorted(all.occupations.rbegin(), all.occupations.rend()));
+    REQUIRE(all.occupations.back() >= -1e-14);   // D is positive semidefinite
+
+    auto none = make_config();
+    REQUIRE_THROWS_WITH(ccsd::truncate_virtuals_fno(none, 1.0), "fno threshold leaves no virtual orbitals");
+
+    // Keep the two most occupied natural virtuals.
+    auto c = make_config();
+    const auto r = ccsd::truncate_virtuals_fno(c, 0.5 * (all.occupations[1] + all.occupations[2]));
+    REQUIRE(r.n_virtual_kept == 2);
+    REQUIRE(c.n_spatial_orbitals == 2 + r.n_virtual_kept);
+    REQUIRE(c.orbital_energies.size() == static_cast<std::size_t>(c.n_spatial_orbitals));
+    REQUIRE(c.orbital_symmetry.size() == static_cast<std::size_t>(c.n_spatial_orbitals));
+    REQUIRE(r.mp2_full == Approx(all.mp2_full));
+    REQUIRE(r.mp2_truncated > r.mp2_full);   // fewer virtuals, less correlation
+    REQUIRE(r.mp2_truncated + r.correction() == Approx(r.mp2_full));
+}
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <cstddef>
+
 namespace ccsd::constants {
     // MPI message tags — chosen to avoid collision between Vector2D and Vector4D sends.
     constexpr int mpi_tag_2d = 233;
     constexpr int mpi_tag_4d = 610;
+    // Tensor transfers are split into chunks of this many doubles (8 MiB) with
+    // up to mpi_max_outstanding non-blocking requests in flight.
+    constexpr std::size_t mpi_chunk_doubles = std::size_t{1} << 20;
+    constexpr int mpi_max_outstanding = 4;
     // CCSD amplitude convergence criterion (energy difference threshold).
     constexpr double convergence_threshold = 1.0e-8;  // 1e-8: conventional CCSD convergence
 }
@@ -0,0 +1,585 @@
+#include <ccsd/kernels/ccsd_eom.h>
+#include <ccsd/kernels/ccsd_gemm.h>
+#include <ccsd/kernels/ccsd_omp.h>
+#include <ccsd/kernels/ccsd_symmetry.h>
+#include <util/linalg/davidson.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+inline std::size_t sz(int x) { return static_cast<std::size_t>(x); }
+
+}  // namespace
+
+//=============================================================================
+template <class Fn>
+void ccsd::EomKernels::for_W_abef_rows(const Fn& fn) const {
+    const std::size_t v = v_, vvv = v * v * v;
+    // At least 256 rows (a,b) per call, so the caller's gemm splits across threads.
+    const std::size_t step = std::max<std::size_t>(1, 256 / std::max<std::size_t>(v, 1));
+    std::vector<double> S(std::min(step, v) * vvv);
+    for (std::size_t a0 = 0; a0 < v; a0 += step) {
+        const std::size_t a1 = std::min(a0 + step, v);
+        CCSD_OMP_PARALLEL_FOR
+        for (int ab = 0; ab < static_cast<int>((a1 - a0) * v); ++ab) {
+            const std::size_t a = a0 + static_cast<std::size_t>(ab) / v, b = static_cast<std::size_t>(ab) % v;
+            const auto& st = W_abef_.strides;
+            const double* w = W_abef_.data + static_cast<std::ptrdiff_t>(a) * st[0] + static_cast<std::ptrdiff_t>(b) * st[1];
+            double* row = S.data() + static_cast<std::size_t>(ab) * v * v;
+            for (std::size_t e = 0; e < v; ++e)
+                for (std::size_t f = 0; f < v; ++f)
+                    row[e * v + f] = w[static_cast<std::ptrdiff_t>(e) * st[2] + static_cast<std::ptrdiff_t>(f) * st[3]];
+        }
+        fn(a0, a1, S.data());
+    }
+}
+//=============================================================================
+
+//=============================================================================
+std::size_t ccsd::EomKernels::block_bytes(std::size_t o, std::size_t v) {
+    const std::size_t oo = o * o, vv = v * v, ov = o * v;
+    const std::size_t doubles = 2 * ov + 3 * vv * oo + oo + vv + oo * oo + ov * ov   // t1, Fov; t2, τ, G; Foo; Fvv; Woooo; Wring
+                              + 2 * oo * ov + 2 * ov * vv + (ov + vv * oo);          // Wooov, Wovoo; Wvovv, Wvvvo; diag
+    return doubles * sizeof(double) + (ov + vv * oo) * sizeof(char);                 // mask
+}
+
+std::size_t ccsd::EomKernels::scratch_bytes(std::size_t o, std::size_t v) {
+    // The constructor's phases: the K gemm; the blocks alive while the
+    // W_abef rows, <mn||ei> or X / Y are built; then the R gemm.
+    const std::size_t oo = o * o, ov = o * v, ovvv = o * v * v * v;
+    const std::size_t rows = std::min(std::max<std::size_t>(1, 256 / std::max<std::size_t>(v, 1)), v) * v * v * v;
+    const std::size_t k_gemm = 4 * ov * ov;
+    const std::size_t build  = ov * ov + oo * ov + ovvv + std::max({rows, oo * ov, ov * ov + ovvv});
+    const std::size_t r_gemm = 2 * ov * ov + oo * ov + 2 * ovvv;
+    return std::max({k_gemm, build, r_gemm}) * sizeof(double);
+}
+//=============================================================================
+
+//=============================================================================
+ccsd::EomKernels::EomKernels(const CcsdState& state, const ParameterClass& p, int irrep)
+    : o_(sz(p.n_occupied)), v_(sz(state.n_spin_orbitals - p.n_occupied)) {
+    if (irrep < 0) throw std::invalid_argument("EOM-CCSD: irrep must be >= 0");
+    if (state.W_abef.n_size() == 0)
+        throw std::runtime_error("EOM-CCSD needs the stored W_abef (not rebuilt from slabs)");
+    state.with_integrals([&](const auto& g) { pack(state, p, irrep, g); });
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+template <class G>
+void ccsd::EomKernels::pack(const CcsdState& state, const ParameterClass& p, int irrep, const G& g) {
+    const std::size_t o = o_, v = v_, oo = o * o, vv = v * v, ov = o * v;
+    const int n_occ = p.n_occupied;
+    auto V = [&](std::size_t a) { return n_occ + static_cast<int>(a); };
+    auto O = [](std::size_t i) { return static_cast<int>(i); };
+
+    // Amplitudes, τ and <mn||ef>.
+    t1_.resize(ov);
+    t2_.resize(vv * oo);
+    G_.resize(oo * vv);
+    tau_.resize(vv * oo);
+    for (std::size_t a = 0; a < v; ++a)
+        for (std::size_t i = 0; i < o; ++i) t1_[a * o + i] = state.t1(V(a), O(i));
+    for (std::size_t a = 0; a < v; ++a)
+        for (std::size_t b = 0; b < v; ++b)
+            for (std::size_t i = 0; i < o; ++i)
+                for (std::size_t j = 0; j < o; ++j) {
+                    const std::size_t x = ((a * v + b) * o + i) * o + j;
+                    t2_[x] = state.t2(V(a), V(b), O(i), O(j));
+                    tau_[x] = t2_[x] + t1_[a * o + i] * t1_[b * o + j] - t1_[b * o + i] * t1_[a * o + j];
+                }
+    for (std::size_t m = 0; m < o; ++m)
+        for (std::size_t n = 0; n < o; ++n)
+            for (std::size_t e = 0; e < v; ++e)
+                for (std::size_t f = 0; f < v; ++f) G_[((m * o + n) * v + e) * v + f] = g(O(m), O(n), V(e), V(f));
+
+    // One-particle blocks.
+    Fov_.resize(ov);
+    Foo_.resize(oo);
+    Fvv_.resize(vv);
+    for (std::size_t m = 0; m < o; ++m)
+        for (std::size_t e = 0; e < v; ++e) Fov_[m * v + e] = state.F_me(O(m), V(e));
+    for (std::size_t a = 0; a < v; ++a)
+        for (std::size_t e = 0; e < v; ++e) {
+            double x = state.F_ae(V(a), V(e)) + (a == e ? state.fock_spin(V(a), V(a)) : 0.0);
+            for (std::size_t m = 0; m < o; ++m) x -= 0.5 * t1_[a * o + m] * Fov_[m * v + e];
+            Fvv_[a * v + e] = x;
+        }
+    for (std::size_t m = 0; m < o; ++m)
+        for (std::size_t i = 0; i < o; ++i) {
+            double x = state.F_mi(O(m), O(i)) + (m == i ? state.fock_spin(O(i), O(i)) : 0.0);
+            for (std::size_t e = 0; e < v; ++e) x += 0.5 * t1_[e * o + i] * Fov_[m * v + e];
+            Foo_[m * o + i] = x;
+        }
+
+    // Ladders: the stored intermediates plus ¼ τ <mn||ef>. Wvvvv is never
+    // formed: its users read W_abef in place and apply the τ term factorized.
+    Woooo_.resize(oo * oo);
+    for (std::size_t m = 0; m < o; ++m)
+        for (std::size_t n = 0; n < o; ++n)
+            for (std::size_t i = 0; i < o; ++i)
+                for (std::size_t j = 0; j < o; ++j)
+                    Woooo_[((m * o + n) * o + i) * o + j] = state.W_mnij(O(m), O(n), O(i), O(j));
+    ccsd::parallel_gemm(oo, oo, vv, 0.25, G_.data(), vv, tau_.data(), oo, Woooo_.data(), oo);
+    W_abef_ = state.W_abef.view().sub({n_occ, n_occ, n_occ, n_occ},
+                                      {static_cast<int>(v), static_cast<int>(v), static_cast<int>(v), static_cast<int>(v)});
+
+    // K[(m,e)][(j,b)] = Σ_nf <mn||ef> t2(b,f,n,j), shared by Wovvo, Wovoo and Wvvvo.
+    // Z(m,b,e,j) = <mb||ej> - K, the t1-contracted part of Wovoo and Wvvvo.
+    // The scratch blocks below are released as soon as they are used up
+    // (see scratch_bytes).
+    std::vector<double> Z(ov * ov);
+    {
+        std::vector<double> K(ov * ov, 0.0);
+        {
+            std::vector<double> Gt(ov * ov), Tt(ov * ov);
+            for (std::size_t m = 0; m < o; ++m)
+                for (std::size_t e = 0; e < v; ++e)
+                    for (std::size_t n = 0; n < o; ++n)
+                        for (std::size_t f = 0; f < v; ++f) {
+                            Gt[(m * v + e) * ov + n * v + f] = G_[((m * o + n) * v + e) * v + f];
+                            Tt[(n * v + f) * ov + m * v + e] = t2_[((e * v + f) * o + n) * o + m];   // t2(b,f,n,j), (m,e) ≡ (j,b)
+                        }
+            ccsd::parallel_gemm(ov, ov, ov, 1.0, Gt.data(), ov, Tt.data(), ov, K.data(), ov);
+        }
+        Wring_.resize(ov * ov);
+        for (std::size_t m = 0; m < o; ++m)
+            for (std::size_t e = 0; e < v; ++e)
+                for (std::size_t j = 0; j < o; ++j)
+                    for (std::size_t b = 0; b < v; ++b) {
+                        const std::size_t x = (m * v + e) * ov + j * v + b;
+                        Wring_[x] = state.W_mbej(O(m), V(b), V(e), O(j)) - 0.5 * K[x];
+                    }
+        for (std::size_t m = 0; m < o; ++m)
+            for (std::size_t b = 0; b < v; ++b)
+                for (std::size_t e = 0; e < v; ++e)
+                    for (std::size_t j = 0; j < o; ++j)
+                        Z[((m * v + b) * v + e) * o + j] = g(O(m), V(b), V(e), O(j)) - K[(m * v + e) * ov + j * v + b];
+    }
+
+    // Three-index-of-a-kind blocks.
+    std::vector<double> ooov(oo * ov);   // [m][n][i][e] = <mn||ie>
+    for (std::size_t m = 0; m < o; ++m)
+        for (std::size_t n = 0; n < o; ++n)
+            for (std::size_t i = 0; i < o; ++i)
+                for (std::size_t e = 0; e < v; ++e) ooov[((m * o + n) * o + i) * v + e] = g(O(m), O(n), O(i), V(e));
+    Wooov_.resize(oo * ov);
+    for (std::size_t m = 0; m < o; ++m)
+        for (std::size_t n = 0; n < o; ++n)
+            for (std::size_t i = 0; i < o; ++i)
+                for (std::size_t e = 0; e < v; ++e) {
+                    double x = ooov[((m * o + n) * o + i) * v + e];
+                    for (std::size_t f = 0; f < v; ++f) x += t1_[f * o + i] * G_[((m * o + n) * v + f) * v + e];
+                    Wooov_[((m * o + n) * o + i) * v + e] = x;
+                }
+    std::vector<double> ovvv(o * vv * v);   // [m][b][e][f] = <mb||ef>
+    for (std::size_t m = 0; m < o; ++m)
+        for (std::size_t b = 0; b < v; ++b)
+            for (std::size_t e = 0; e < v; ++e)
+                for (std::size_t f = 0; f < v; ++f) ovvv[((m * v + b) * v + e) * v + f] = g(O(m), V(b), V(e), V(f));
+    Wvovv_.resize(ov * vv);
+    for (std::size_t a = 0; a < v; ++a)
+        for (std::size_t m = 0; m < o; ++m)
+            for (std::size_t e = 0; e < v; ++e)
+                for (std::size_t f = 0; f < v; ++f) {
+                    double x = -ovvv[((m * v + a) * v + e) * v + f];   // <am||ef> = -<ma||ef>
+                    for (std::size_t n = 0; n < o; ++n) x -= t1_[a * o + n] * G_[((n * o + m) * v + e) * v + f];
+                    Wvovv_[((a * o + m) * v + e) * v + f] = x;
+                }
+
+    // Wovoo(m,b,i,j) = <mb||ij> - F_me t2(b,e,i,j) - t_n^b Woooo(m,n,i,j) + ½ <mb||ef> τ(e,f,i,j)
+    //                + P(ij) [ <mn||ie> t2(b,e,j,n) + t_i^e Z(m,b,e,j) ]
+    Wovoo_.assign(ov * oo, 0.0);
+    ccsd::parallel_gemm(ov, oo, vv, 0.5, ovvv.data(), vv, tau_.data(), oo, Wovoo_.data(), oo);
+    CCSD_OMP_PARALLEL_FOR
+    for (int mi = 0; mi < static_cast<int>(o); ++mi) {
+        const auto m = static_cast<std::size_t>(mi);
+        std::vector<double> P(oo);   // the P(ij) bracket for one (m,b)
+        for (std::size_t b = 0; b < v; ++b) {
+            for (std::size_t i = 0; i < o; ++i)
+                for (std::size_t j = 0; j < o; ++j) {
+                    double x = 0.0;
+                    for (std::size_t n = 0; n < o; ++n)
+                        for (std::size_t e = 0; e < v; ++e)
+                            x += ooov[((m * o + n) * o + i) * v + e] * t2_[((b * v + e) * o + j) * o + n];
+                    for (std::size_t e = 0; e < v; ++e) x += t1_[e * o + i] * Z[((m * v + b) * v + e) * o + j];
+                    P[i * o + j] = x;
+                }
+            for (std::size_t i = 0; i < o; ++i)
+                for (std::size_t j = 0; j < o; ++j) {
+                    double x = g(O(m), V(b), O(i), O(j)) + P[i * o + j] - P[j * o + i];
+                    for (std::size_t e = 0; e < v; ++e) x -= Fov_[m * v + e] * t2_[((b * v + e) * o + i) * o + j];
+                    for (std::size_t n = 0; n < o; ++n) x -= t1_[b * o + n] * Woooo_[((m * o + n) * o + i) * o + j];
+                    Wovoo_[((m * v + b) * o + i) * o + j] += x;
+                }
+        }
+    }
+
+    // Wvvvo(a,b,e,i) = <ab||ei> - F_me t2(a,b,m,i) + t_i^f Wvvvv(a,b,e,f) + ½ <mn||ei> τ(a,b,m,n)
+    //                - P(ab) [ <mb||ef> t2(a,f,m,i) + t_m^a Z(m,b,e,i) ]
+    // With Wvvvv = W_abef + ¼ τ <mn||ef>, the τ part joins the <mn||ei> term:
+    //   t_i^f Wvvvv(a,b,e,f) + ½ <mn||ei> τ = t_i^f W_abef(a,b,e,f) + τ (½ <mn||ei> + ¼ <mn||ef> t_i^f).
+    Wvvvo_.assign(vv * ov, 0.0);
+    for_W_abef_rows([&](std::size_t a0, std::size_t a1, const double* S) {
+        ccsd::parallel_gemm((a1 - a0) * vv, o, v, 1.0, S, v, t1_.data(), o, Wvvvo_.data() + a0 * vv * o, o);
+    });
+    {
+        std::vector<double> oovo(oo * ov);   // [m][n][e][i] = ½ <mn||ei> + ¼ <mn||ef> t_i^f
+        for (std::size_t m = 0; m < o; ++m)
+            for (std::size_t n = 0; n < o; ++n)
+                for (std::size_t e = 0; e < v; ++e)
+                    for (std::size_t i = 0; i < o; ++i) oovo[((m * o + n) * v + e) * o + i] = 0.5 * g(O(m), O(n), V(e), O(i));
+        ccsd::parallel_gemm(oo * v, o, v, 0.25, G_.data(), v, t1_.data(), o, oovo.data(), o);
+        ccsd::parallel_gemm(vv, ov, oo, 1.0, tau_.data(), oo, oovo.data(), ov, Wvvvo_.data(), ov);
+    }
+    // R[(a,i)][(b,e)] = Σ_mf t2(a,f,m,i) <mb||ef>: the v⁴o² step, as one gemm.
+    std::vector<double> X(ov * ov), Y(ov * vv);
+    for (std::size_t a = 0; a < v; ++a)
+        for (std::size_t i = 0; i < o; ++i)
+            for (std::size_t m = 0; m < o; ++m)
+                for (std::size_t f = 0; f < v; ++f) X[(a * o + i) * ov + m * v + f] = t2_[((a * v + f) * o + m) * o + i];
+    for (std::size_t m = 0; m < o; ++m)
+        for (std::size_t f = 0; f < v; ++f)
+            for (std::size_t b = 0; b < v; ++b)
+                for (std::size_t e = 0; e < v; ++e) Y[(m * v + f) * vv + b * v + e] = ovvv[((m * v + b) * v + e) * v + f];
+    std::vector<double>().swap(ovvv);   // Y holds it, permuted
+    std::vector<double> R(ov * vv, 0.0);
+    ccsd::parallel_gemm(ov, vv, ov, 1.0, X.data(), ov, Y.data(), vv, R.data(), vv);
+    CCSD_OMP_PARALLEL_FOR
+    for (int ai = 0; ai < static_cast<int>(v); ++ai) {
+        const auto a = static_cast<std::size_t>(ai);
+        for (std::size_t b = 0; b < v; ++b)
+            for (std::size_t e = 0; e < v; ++e)
+                for (std::size_t i = 0; i < o; ++i) {
+                    double x = g(V(a), V(b), V(e), O(i))
+                             - R[(a * o + i) * vv + b * v + e] + R[(b * o + i) * vv + a * v + e];
+                    for (std::size_t m = 0; m < o; ++m) {
+                        x -= Fov_[m * v + e] * t2_[((a * v + b) * o + m) * o + i];
+                        x -= t1_[a * o + m] * Z[((m * v + b) * v + e) * o + i]
+                           - t1_[b * o + m] * Z[((m * v + a) * v + e) * o + i];
+                    }
+                    Wvvvo_[((a * v + b) * v + e) * o + i] += x;
+                }
+    }
+
+    // Target space and the preconditioner diagonal.
+    const SpinOrbitalSymmetry sym(p.orbital_symmetry, state.n_spin_orbitals, n_occ);
+    const int target = irrep << 1;
+    auto label = [&](int q) { return sym.label(q); };
+    auto spin  = [](int q) { return q % 2; };
+    diag_.assign(ov + vv * oo, 0.0);
+    mask_.assign(diag_.size(), 0);
+    for (std::size_t a = 0; a < v; ++a)
+        for (std::size_t i = 0; i < o; ++i) {
+            if ((label(V(a)) ^ label(O(i))) != target) continue;
+            mask_[singles(a, i)] = 1;
+            diag_[singles(a, i)] = Fvv_[a * v + a] - Foo_[i * o + i];
+            n_unique_ += 1;
+        }
+    for (std::size_t a = 0; a < v; ++a)
+        for (std::size_t b = 0; b < v; ++b)
+            for (std::size_t i = 0; i < o; ++i)
+                for (std::size_t j = 0; j < o; ++j) {
+                    if (a == b || i == j) continue;
+                    if ((label(V(a)) ^ label(V(b)) ^ label(O(i)) ^ label(O(j))) != target) continue;
+                    if (spin(V(a)) + spin(V(b)) != spin(O(i)) + spin(O(j))) continue;
+                    mask_[doubles(a, b, i, j)] = 1;
+                    diag_[doubles(a, b, i, j)] = Fvv_[a * v + a] + Fvv_[b * v + b] - Foo_[i * o + i] - Foo_[j * o + j];
+                    if (a < b && i < j) n_unique_ += 1;
+                }
+}
+//=============================================================================
+
+//=============================================================================
+// σ1(a,i) = Fvv(a,e) r(e,i) - Foo(m,i) r(a,m) + Fov(m,e) r(a,e,i,m) + Wovvo(m,a,e,i) r(e,m)
+//         - ½ Wooov(m,n,i,e) r(a,e,m,n) + ½ Wvovv(a,m,e,f) r(e,f,i,m)
+void ccsd::EomKernels::sigma_singles(const double* r, double* s) const {
+    const std::size_t o = o_, v = v_, ov = o * v;
+    const double* r2 = r + ov;
+    CCSD_OMP_PARALLEL_FOR
+    for (int ai = 0; ai < static_cast<int>(v); ++ai) {
+        const auto a = static_cast<std::size_t>(ai);
+        for (std::size_t i = 0; i < o; ++i) {
+            if (!mask_[singles(a, i)]) continue;
+            double x = 0.0;
+            for (std::size_t e = 0; e < v; ++e) x += Fvv_[a * v + e] * r[e * o + i];
+            for (std::size_t m = 0; m < o; ++m) x -= Foo_[m * o + i] * r[a * o + m];
+            for (std::size_t m = 0; m < o; ++m)
+                for (std::size_t e = 0; e < v; ++e) {
+                    x += Fov_[m * v + e] * r2[((a * v + e) * o + i) * o + m];
+                    x += Wring_[(m * v + e) * ov + i * v + a] * r[e * o + m];
+                }
+            for (std::size_t m = 0; m < o; ++m)
+                for (std::size_t n = 0; n < o; ++n)
+                    for (std::size_t e = 0; e < v; ++e)
+                        x -= 0.5 * Wooov_[((m * o + n) * o + i) * v + e] * r2[((a * v + e) * o + m) * o + n];
+            for (std::size_t m = 0; m < o; ++m)
+                for (std::size_t e = 0; e < v; ++e)
+                    for (std::size_t f = 0; f < v; ++f)
+                        x += 0.5 * Wvovv_[((a * o + m) * v + e) * v + f] * r2[((e * v + f) * o + i) * o + m];
+            s[singles(a, i)] += x;
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// The doubles terms outside the ladders and the ring, as P(ab) tmpab + P(ij) tmpij:
+//   tmpab = -Wovoo(m,b,i,j) r(a,m) + [Fvv(b,e) r(a,e,i,j) + Xv(b,e) t2(a,e,i,j)] + Yv(a,f) t2(f,b,i,j)
+//   tmpij = -Foo(m,j) r(a,b,i,m) + t2(a,b,i,m) Xo(m,j) + Wvvvo(a,b,e,j) r(e,i) + Yo(n,i) t2(a,b,n,j)
+// with Xv(b,e) = -½ <mn||ef> r(b,f,m,n), Xo(m,j) = -½ <mn||ef> r(e,f,j,n),
+//      Yv(a,f) = -Wvovv(a,m,e,f) r(e,m), Yo(n,i) = Wooov(m,n,i,e) r(e,m).
+void ccsd::EomKernels::sigma_doubles(const double* r, double* s) const {
+    const std::size_t o = o_, v = v_, oo = o * o, vv = v * v;
+    const double* r1 = r;
+    const double* r2 = r + v * o;
+    double* s2       = s + v * o;
+
+    std::vector<double> Xv(vv, 0.0), Xo(oo, 0.0), Yv(vv, 0.0), Yo(oo, 0.0);
+    for (std::size_t m = 0; m < o; ++m)
+        for (std::size_t n = 0; n < o; ++n)
+            for (std::size_t e = 0; e < v; ++e)
+                for (std::size_t f = 0; f < v; ++f) {
+                    const double G = -0.5 * G_[((m * o + n) * v + e) * v + f];
+                    if (G == 0.0) continue;
+                    for (std::size_t b = 0; b < v; ++b) Xv[b * v + e] += G * r2[((b * v + f) * o + m) * o + n];
+                    for (std::size_t j = 0; j < o; ++j) Xo[m * o + j] += G * r2[((e * v + f) * o + j) * o + n];
+                }
+    for (std::size_t a = 0; a < v; ++a)
+        for (std::size_t m = 0; m < o; ++m)
+            for (std::size_t e = 0; e < v; ++e) {
+                const double x = r1[e * o + m];
+                if (x == 0.0) continue;
+                for (std::size_t f = 0; f < v; ++f) Yv[a * v + f] -= Wvovv_[((a * o + m) * v + e) * v + f] * x;
+            }
+    for (std::size_t m = 0; m < o; ++m)
+        for (std::size_t n = 0; n < o; ++n)
+            for (std::size_t i = 0; i < o; ++i)
+                for (std::size_t e = 0; e < v; ++e) Yo[n * o + i] += Wooov_[((m * o + n) * o + i) * v + e] * r1[e * o + m];
+
+    std::vector<double> tab(vv * oo), tij(vv * oo);
+    CCSD_OMP_PARALLEL_FOR
+    for (int ai = 0; ai < static_cast<int>(v); ++ai) {
+        const auto a = static_cast<std::size_t>(ai);
+        for (std::size_t b = 0; b < v; ++b)
+            for (std::size_t i = 0; i < o; ++i)
+                for (std::size_t j = 0; j < o; ++j) {
+                    double x = 0.0, y = 0.0;
+                    for (std::size_t m = 0; m < o; ++m) {
+                        x -= Wovoo_[((m * v + b) * o + i) * o + j] * r1[a * o + m];
+                        y -= Foo_[m * o + j] * r2[((a * v + b) * o + i) * o + m];
+                        y += t2_[((a * v + b) * o + i) * o + m] * Xo[m * o + j];
+                        y += Yo[m * o + i] * t2_[((a * v + b) * o + m) * o + j];
+                    }
+                    for (std::size_t e = 0; e < v; ++e) {
+                        x += Fvv_[b * v + e] * r2[((a * v + e) * o + i) * o + j]
+                           + Xv[b * v + e] * t2_[((a * v + e) * o + i) * o + j]
+                           + Yv[a * v + e] * t2_[((e * v + b) * o + i) * o + j];
+                        y += Wvvvo_[((a * v + b) * v + e) * o + j] * r1[e * o + i];
+                    }
+                    tab[((a * v + b) * o + i) * o + j] = x;
+                    tij[((a * v + b) * o + i) * o + j] = y;
+                }
+    }
+    for (std::size_t a = 0; a < v; ++a)
+        for (std::size_t b = 0; b < v; ++b)
+            for (std::size_t i = 0; i < o; ++i)
+                for (std::size_t j = 0; j < o; ++j)
+                    s2[((a * v + b) * o + i) * o + j] += tab[((a * v + b) * o + i) * o + j] - tab[((b * v + a) * o + i) * o + j]
+                                                       + tij[((a * v + b) * o + i) * o + j] - tij[((a * v + b) * o + j) * o + i];
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// ½ Wvvvv(a,b,e,f) r(e,f,i,j) + ½ Woooo(m,n,i,j) r(a,b,m,n) + P(ij) P(ab) Wovvo(m,b,e,j) r(a,e,i,m),
+// each one gemm over the whole batch (the roots stacked along the free index).
+// Wvvvv = W_abef + ¼ τ <mn||ef> is applied as ½ W_abef r + ⅛ τ (<mn||ef> r).
+void ccsd::EomKernels::sigma_ladders(const std::vector<std::vector<double>>& r,
+                                     std::vector<std::vector<double>>& s) const {
+    const std::size_t o = o_, v = v_, oo = o * o, vv = v * v, ov = o * v;
+    const std::size_t nk = r.size();
+
+    // Particle ladder: B[(e,f)][(k,i,j)].
+    std::vector<double> B(vv * nk * oo), C(vv * nk * oo, 0.0);
+    for (std::size_t k = 0; k < nk; ++k)
+        for (std::size_t ef = 0; ef < vv; ++ef)
+            std::copy_n(r[k].data() + ov + ef * oo, oo, B.data() + ef * nk * oo + k * oo);
+    for_W_abef_rows([&](std::size_t a0, std::size_t a1, const double* S) {
+        ccsd::parallel_gemm((a1 - a0) * v, nk * oo, vv, 0.5, S, vv, B.data(), nk * oo, C.data() + a0 * v * nk * oo, nk * oo);
+    });
+    {
+        std::vector<double> GB(oo * nk * oo, 0.0);   // [(m,n)][(k,i,j)] = Σ_ef <mn||ef> r(e,f,i,j)
+        ccsd::parallel_gemm(oo, nk * oo, vv, 1.0, G_.data(), vv, B.data(), nk * oo, GB.data(), nk * oo);
+        ccsd::parallel_gemm(vv, nk * oo, oo, 0.125, tau_.data(), oo, GB.data(), nk * oo, C.data(), nk * oo);
+    }
+    for (std::size_t k = 0; k < nk; ++k)
+        for (std::size_t ab = 0; ab < vv; ++ab) {
+            double* out = s[k].data() + ov + ab * oo;
+            const double* in = C.data() + ab * nk * oo + k * oo;
+            for (std::size_t ij = 0; ij < oo; ++ij) out[ij] += in[ij];
+        }
+
+    // Hole ladder: rows (k,a,b) of the stacked r2 against Woooo[(m,n)][(i,j)].
+    std::vector<double> D(nk * vv * oo), E(nk * vv * oo, 0.0);
+    for (std::size_t k = 0; k < nk; ++k) std::copy_n(r[k].data() + ov, vv * oo, D.data() + k * vv * oo);
+    ccsd::parallel_gemm(nk * vv, oo, oo, 0.5, D.data(), oo, Woooo_.data(), oo, E.data(), oo);
+    for (std::size_t k = 0; k < nk; ++k) {
+        double* out = s[k].data() + ov;
+        const double* in = E.data() + k * vv * oo;
+        for (std::size_t x = 0; x < vv * oo; ++x) out[x] += in[x];
+    }
+
+    // Ring: Rr[(k,i,a)][(m,e)] = r(a,e,i,m); X = Rr · Wring, X[(k,i,a)][(j,b)].
+    std::vector<double> Rr(nk * ov * ov), X(nk * ov * ov, 0.0);
+    for (std::size_t k = 0; k < nk; ++k)
+        for (std::size_t i = 0; i < o; ++i)
+            for (std::size_t a = 0; a < v; ++a)
+                for (std::size_t m = 0; m < o; ++m)
+                    for (std::size_t e = 0; e < v; ++e)
+                        Rr[((k * o + i) * v + a) * ov + m * v + e] = r[k][doubles(a, e, i, m)];
+    ccsd::parallel_gemm(nk * ov, ov, ov, 1.0, Rr.data(), ov, Wring_.data(), ov, X.data(), ov);
+    for (std::size_t k = 0; k < nk; ++k) {
+        const double* x = X.data() + k * ov * ov;
+        auto at = [&](std::size_t i, std::size_t a, std::size_t j, std::size_t b) {
+            return x[(i * v + a) * ov + j * v + b];
+        };
+        for (std::size_t a = 0; a < v; ++a)
+            for (std::size_t b = 0; b < v; ++b)
+                for (std::size_t i = 0; i < o; ++i)
+                    for (std::size_t j = 0; j < o; ++j)
+                        s[k][doubles(a, b, i, j)] += at(i, a, j, b) - at(j, a, i, b) - at(i, b, j, a) + at(j, b, i, a);
+    }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void ccsd::EomKernels::sigma(const std::vector<std::vector<double>>& r,
+                             std::vector<std::vector<double>>& s) const {
+    s.assign(r.size(), std::vector<double>(size(), 0.0));
+    for (std::size_t k = 0; k < r.size(); ++k) {
+        if (r[k].size() != size()) throw std::runtime_error("EomKernels::sigma: trial vector has the wrong size");
+        sigma_singles(r[k].data(), s[k].data());
+        sigma_doubles(r[k].data(), s[k].data());
+    }
+    sigma_ladders(r, s);
+    for (auto& x : s)
+        for (std::size_t q = 0; q < x.size(); ++q)
+            if (!mask_[q]) x[q] = 0.0;
+}
+//=============================================================================
+
+//=============================================================================
+void ccsd::EomKernels::precondition(std::vector<double>& r, double omega) const {
+    for (std::size_t q = 0; q < r.size(); ++q) {
+        if (!mask_[q]) {
+            r[q] = 0.0;
+            continue;
+        }
+        double d = omega - diag_[q];
+        if (std::abs(d) < 1e-4) d = std::copysign(1e-4, d);   // keep near-resonant amplitudes bounded
+        r[q] /= d;
+    }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::vector<std::vector<double>> ccsd::EomKernels::guesses(int n) const {
+    const std::size_t o = o_, v = v_;
+    struct Candidate {
+        double diagonal;
+        std::vector<std::pair<std::size_t, double>> entries;
+    };
+    std::vector<Candidate> c;
+    const double h = 1.0 / std::sqrt(2.0);
+    // α and β spin orbitals alternate, so (a, i) even is the α single and
+    // (a+1, i+1) its β partner.
+    for (std::size_t a = 0; a + 1 < v; a += 2)
+        for (std::size_t i = 0; i + 1 < o; i += 2) {
+            if (!mask_[singles(a, i)]) continue;
+            const double d = diag_[singles(a, i)];
+            c.push_back({d, {{singles(a, i), h}, {singles(a + 1, i + 1), h}}});    // singlet
+            c.push_back({d, {{singles(a, i), h}, {singles(a + 1, i + 1), -h}}});   // triplet
+        }
+    for (std::size_t a = 0; a < v; ++a)
+        for (std::size_t b = a + 1; b < v; ++b)
+            for (std::size_t i = 0; i < o; ++i)
+                for (std::size_t j = i + 1; j < o; ++j) {
+                    if (!mask_[doubles(a, b, i, j)]) continue;
+                    c.push_back({diag_[doubles(a, b, i, j)],
+                                 {{doubles(a, b, i, j), 0.5}, {doubles(b, a, i, j), -0.5},
+                                  {doubles(a, b, j, i), -0.5}, {doubles(b, a, j, i), 0.5}}});
+                }
+    std::stable_sort(c.begin(), c.end(), [](const Candidate& x, const Candidate& y) { return x.diagonal < y.diagonal; });
+
+    std::vector<std::vector<double>> out;
+    for (std::size_t k = 0; k < c.size() && out.size() < static_cast<std::size_t>(std::max(n, 0)); ++k) {
+        std::vector<double> x(size(), 0.0);
+        for (const auto& [q, value] : c[k].entries) x[q] = value;
+        out.push_back(std::move(x));
+    }
+    return out;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+double ccsd::EomKernels::singles_weight(const std::vector<double>& r) const {
+    const std::size_t ov = o_ * v_;
+    double s1 = 0.0, s2 = 0.0;
+    for (std::size_t q = 0; q < r.size(); ++q) (q < ov ? s1 : s2) += r[q] * r[q];
+    const double total = s1 + 0.25 * s2;
+    return total > 0.0 ? s1 / total : 0.0;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+double ccsd::EomKernels::spin_parity(const std::vector<double>& r) const {
+    // Flipping every spin maps spin orbital p to p ^ 1; o is even, so the
+    // same holds for the virtual offsets.
+    const std::size_t o = o_, v = v_;
+    double overlap = 0.0, norm = 0.0;
+    for (std::size_t a = 0; a < v; ++a)
+        for (std::size_t i = 0; i < o; ++i) overlap += r[singles(a, i)] * r[singles(a ^ 1, i ^ 1)];
+    for (std::size_t a = 0; a < v; ++a)
+        for (std::size_t b = 0; b < v; ++b)
+            for (std::size_t i = 0; i < o; ++i)
+                for (std::size_t j = 0; j < o; ++j)
+                    overlap += r[doubles(a, b, i, j)] * r[doubles(a ^ 1, b ^ 1, i ^ 1, j ^ 1)];
+    for (double x : r) norm += x * x;
+    return norm > 0.0 ? overlap / norm : 0.0;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+ccsd::EomResult ccsd::EomKernels::solve(int roots, double tolerance, int max_iterations) const {
+    if (roots < 1) throw std::invalid_argument("EOM-CCSD: number of roots must be >= 1");
+    if (roots > n_unique_)
+        throw std::runtime_error("EOM-CCSD: " + std::to_string(roots) + " roots requested but the irrep has only "
+                                 + std::to_string(n_unique_) + " states");
+    linalg::DavidsonOptions opt;
+    opt.roots          = roots;
+    opt.tolerance      = tolerance;
+    opt.max_iterations = max_iterations;
+    const linalg::DavidsonResult d = linalg::davidson(
+        guesses(std::min(2 * roots, n_unique_)),
+        [this](const std::vector<std::vector<double>>& r, std::vector<std::vector<double>>& s) { sigma(r, s); },
+        [this](std::vector<double>& r, double omega) { precondition(r, omega); }, opt);
+
+    EomResult out;
+    out.iterations = d.iterations;
+    out.converged  = d.converged;
+    for (std::size_t k = 0; k < d.values.size(); ++k) {
+        EomRoot root;
+        root.excitation   = d.values[k];
+        root.singles      = singles_weight(d.vectors[k]);
+        root.multiplicity = spin_parity(d.vectors[k]) >= 0.0 ? 1 : 3;
+        root.residual     = d.residuals[k];
+        out.roots.push_back(root);
+    }
+    return out;
+}
+//=============================================================================
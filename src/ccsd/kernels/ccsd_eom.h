@@ -0,0 +1,127 @@
+#pragma once
+
+#include <ccsd/kernels/ccsd_state.h>
+#include <ccsd/config/ccsd_config.h>
+#include <util/tensors/tensor_view.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace ccsd {
+
+// One EOM-CCSD excited state.
+struct EomRoot {
+    double excitation   = 0.0;   // ω above the CCSD ground state (Hartree)
+    double singles      = 0.0;   // singles weight of r over unique amplitudes, 0..1
+    int    multiplicity = 1;     // 1 or 3, from the α↔β parity of r
+    double residual     = 0.0;   // final Davidson residual norm
+};
+
+struct EomResult {
+    std::vector<EomRoot> roots;   // ascending ω
+    int  iterations = 0;
+    bool converged  = false;
+};
+
+// EOM-EE-CCSD excitation energies (Stanton & Bartlett 1993), spin-orbital
+// form on converged CCSD amplitudes: the lowest eigenvalues ω of
+// H̄ - E_CCSD in the space of singles r1(a,i) and doubles r2(a,b,i,j).
+//
+// The constructor packs the H̄ blocks. Its one-particle and W_mnij /
+// W_abef / W_mbej parts are the state's Stanton intermediates (F_*, W_*),
+// which must have been rebuilt at the converged amplitudes, plus the
+// terms those intermediates leave out:
+//   Fvv = F_ae + f_aa - ½ t_m^a F_me     Foo = F_mi + f_ii + ½ t_i^e F_me
+//   Woooo = W_mnij + ¼ τ_ij^ef <mn||ef>   Wvvvv = W_abef + ¼ τ_mn^ab <mn||ef>
+//   Wovvo = W_mbej - ½ t_jn^fb <mn||ef>
+// and builds the three-virtual / three-occupied blocks (Wooov, Wvovv,
+// Wovoo, Wvvvo) from the integrals once. The v⁴ Wvvvv is never stored:
+// state.W_abef is read in place, so `state` must outlive the kernels, and
+// the τ term is applied factorized. Pure math, no MPI.
+//
+// Trial vectors are flat: r1 as [a][i], then r2 as [a][b][i][j], stored in
+// full with r2 antisymmetric (like t2). Only amplitudes in the target
+// irrep with M_s = 0 are nonzero; sigma and precondition keep the rest zero.
+class EomKernels {
+public:
+    // `irrep`: 0-based spatial irrep of the excitation (0 = totally symmetric).
+    EomKernels(const CcsdState& state, const ParameterClass& p, int irrep = 0);
+
+    [[nodiscard]] std::size_t size() const noexcept { return diag_.size(); }
+
+    // Bytes of the packed blocks the kernels keep for o occupied and v
+    // virtual spin orbitals, and the peak of the temporary blocks the
+    // constructor holds on top of them (the memory plan's EOM entries).
+    [[nodiscard]] static std::size_t block_bytes(std::size_t o, std::size_t v);
+    [[nodiscard]] static std::size_t scratch_bytes(std::size_t o, std::size_t v);
+
+    // Number of independent amplitudes in the target space: the most roots
+    // the problem has.
+    [[nodiscard]] int max_roots() const noexcept { return n_unique_; }
+
+    // s[k] = (H̄ - E_CCSD) r[k] for the whole batch. The v⁴ and o⁴ ladders
+    // and the ring term run as one gemm across every vector of the batch.
+    void sigma(const std::vector<std::vector<double>>& r, std::vector<std::vector<double>>& s) const;
+
+    // r ← r / (ω - D), D = the diagonal of the one-particle part of H̄.
+    void precondition(std::vector<double>& r, double omega) const;
+
+    // `n` start vectors: spin-adapted singles (singlet and triplet
+    // combinations) in order of D, then unit doubles when singles run out.
+    [[nodiscard]] std::vector<std::vector<double>> guesses(int n) const;
+
+    // ‖r1‖² / (‖r1‖² + ¼‖r2‖²): the full-storage doubles count each
+    // unique amplitude four times.
+    [[nodiscard]] double singles_weight(const std::vector<double>& r) const;
+
+    // <r|flip r> / <r|r> for the α↔β spin flip: +1 for singlets, -1 for
+    // the M_s = 0 component of triplets (closed-shell reference).
+    [[nodiscard]] double spin_parity(const std::vector<double>& r) const;
+
+    // Lowest `roots` states by block Davidson (linalg::davidson).
+    [[nodiscard]] EomResult solve(int roots, double tolerance = 1e-6, int max_iterations = 100) const;
+
+private:
+    std::size_t o_ = 0;
+    std::size_t v_ = 0;
+    int n_unique_  = 0;
+
+    // Packed blocks (occupied indices 0..o-1, virtual indices 0..v-1):
+    std::vector<double> t1_;      // [a][i]
+    std::vector<double> t2_;      // [a][b][i][j]
+    std::vector<double> G_;       // [m][n][e][f] = <mn||ef>
+    std::vector<double> Fov_;     // [m][e]
+    std::vector<double> Foo_;     // [m][i]
+    std::vector<double> Fvv_;     // [a][e]
+    std::vector<double> Woooo_;   // [m][n][i][j]
+    std::vector<double> tau_;     // [a][b][i][j] = t2 + t1 t1 - t1 t1
+    TensorView<4> W_abef_;        // state.W_abef, virtual block (a,b,e,f), in place
+    std::vector<double> Wring_;   // [m][e][j][b] = Wovvo(m,b,e,j)
+    std::vector<double> Wooov_;   // [m][n][i][e]
+    std::vector<double> Wvovv_;   // [a][m][e][f]
+    std::vector<double> Wovoo_;   // [m][b][i][j]
+    std::vector<double> Wvvvo_;   // [a][b][e][i]
+    std::vector<double> diag_;    // D over the flat vector
+    std::vector<char>   mask_;    // 1 where the amplitude belongs to the target space
+
+    [[nodiscard]] std::size_t singles(std::size_t a, std::size_t i) const noexcept { return a * o_ + i; }
+    [[nodiscard]] std::size_t doubles(std::size_t a, std::size_t b, std::size_t i, std::size_t j) const noexcept {
+        return v_ * o_ + ((a * v_ + b) * o_ + i) * o_ + j;
+    }
+
+    // The constructor's work: packs every block above, reading <pq||rs>
+    // through the backend `g` it resolved once (CcsdState::with_integrals).
+    template <class G>
+    void pack(const CcsdState& state, const ParameterClass& p, int irrep, const G& g);
+
+    void sigma_singles(const double* r, double* s) const;
+    void sigma_doubles(const double* r, double* s) const;
+    void sigma_ladders(const std::vector<std::vector<double>>& r, std::vector<std::vector<double>>& s) const;
+    // fn(a0, a1, S) for consecutive row ranges [a0, a1) of W_abef_, S its
+    // rows packed densely as [a - a0][b][e][f]: W_abef in gemm-ready pieces
+    // whatever its layout, never all at once.
+    template <class Fn>
+    void for_W_abef_rows(const Fn& fn) const;
+};
+
+}  // namespace ccsd
@@ -0,0 +1,59 @@
+#pragma once
+
+// Analytic floating-point operation counts of the CcsdKernels loops, as
+// functions of o = n_occupied and v = n_virtual spin orbitals. Every +, -, *
+// and / in the innermost expressions counts as one flop (tau: 4, tau_tilde: 5);
+// index arithmetic, loads, and the integral lookups are not counted. Paired
+// with measured time and traffic these place each Stanton term on a roofline.
+// The counts are for dense loops; symmetry blocking (ccsd_symmetry.h) skips
+// forbidden terms, so they are an upper bound on the work actually done.
+
+namespace ccsd::flops {
+
+constexpr double F_ae(double o, double v)   { return v * v * o * (3.0 + v * (2.0 + 8.0 * o)); }  // eq (3)
+constexpr double F_mi(double o, double v)   { return o * o * v * (3.0 + o * (2.0 + 8.0 * v)); }  // eq (4)
+constexpr double F_me(double o, double v)   { return 2.0 * o * o * v * v; }                      // eq (5)
+constexpr double W_mnij(double o, double v) { return o * o * o * o * v * (4.0 + 7.0 * v); }      // eq (6)
+constexpr double W_abef(double o, double v) { return v * v * v * v * o * (4.0 + 7.0 * o); }      // eq (7)
+constexpr double W_mbej(double o, double v) {                                                    // eq (8)
+    return o * o * v * v * (2.0 * v + o * (2.0 + 6.0 * v));
+}
+
+// T1 update for one virtual row a (all i), Stanton eq (1).
+constexpr double t1_row(double o, double v) {
+    return o * (2.0 * v + 2.0 * o + o * v * (4.0 + 3.0 * v + 3.0 * o) + 5.0);
+}
+
+// T2 update for one virtual pair (a,b) (all i,j), Stanton eq (2).
+constexpr double t2_pair(double o, double v) {
+    return o * o * (v * (4.0 + 10.0 * o) + o * (4.0 + 10.0 * v) + 4.0 * v + 7.0 * v * v
+                    + 4.0 * o + 24.0 * o * v + 7.0 * o * o + 9.0);
+}
+
+constexpr double energy(double o, double v) { return 8.0 * o * o * v * v; }
+
+// MP3 E(3): particle ladder, ring and hole ladder.
+constexpr double mp3_energy(double o, double v) {
+    return v * v * v * v * (2.0 * o * o + 3.0) + v * v * v * o * o * (2.0 * o + 2.0)
+         + o * o * o * o * (2.0 * v * v + 3.0);
+}
+
+// CC2 doubles of a tile of `pairs` virtual pairs spanning `rows` values of
+// a: the one-index T1 transforms over the o + rows rows it reads (n = o + v)
+// and the division.
+constexpr double cc2_doubles_tile(double o, double v, double rows, double pairs) {
+    const double n = o + v, p = o + rows;
+    return 2.0 * p * n * n * o * v + 2.0 * p * n * o * o * v + 2.0 * p * v * o * o * o
+         + pairs * o * o * (2.0 * o + 1.0);
+}
+
+// CC2 doubles, all pairs.
+constexpr double cc2_doubles(double o, double v) { return cc2_doubles_tile(o, v, v, v * v); }
+
+// (T) for one i<j<k triple: three connected builds of 2v³(v + o) plus the
+// a<b<c energy loop (~30 flops per element).
+constexpr double triples_per_triple(double o, double v) {
+    return 6.0 * v * v * v * (v + o) + 30.0 * v * (v - 1.0) * (v - 2.0) / 6.0;
+}
+
+}  // namespace ccsd::flops
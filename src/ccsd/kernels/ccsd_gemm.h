@@ -0,0 +1,25 @@
+#pragma once
+
+#include <ccsd/kernels/ccsd_omp.h>
+#include <util/linalg/gemm.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ccsd {
+
+// linalg::gemm with the rows of C split across threads: each thread owns
+// whole 64-row blocks of C, so no reduction is needed. Serial without OpenMP.
+inline void parallel_gemm(std::size_t m, std::size_t n, std::size_t k, double alpha,
+                          const double* A, std::size_t lda, const double* B, std::size_t ldb,
+                          double* C, std::size_t ldc) {
+    constexpr std::size_t rows = 64;
+    const auto blocks = static_cast<long>((m + rows - 1) / rows);
+    CCSD_OMP_PARALLEL_FOR
+    for (long blk = 0; blk < blocks; ++blk) {
+        const std::size_t i0 = static_cast<std::size_t>(blk) * rows;
+        linalg::gemm(std::min(rows, m - i0), n, k, alpha, A + i0 * lda, lda, B, ldb, C + i0 * ldc, ldc);
+    }
+}
+
+}  // namespace ccsd
@@ -0,0 +1,179 @@
+#include <ccsd/kernels/ccsd_incremental.h>
+
+#include <cmath>
+
+//=============================================================================
+ccsd::IncrementalIntermediates::IncrementalIntermediates(CcsdState& state, const ParameterClass& p)
+    : state_(state), p_(p),
+      sym_(p.orbital_symmetry, state.n_spin_orbitals, p.n_occupied),
+      o_(p.n_occupied), v_(state.n_spin_orbitals - p.n_occupied) {
+    const auto o = static_cast<std::size_t>(o_), v = static_cast<std::size_t>(v_);
+    t1_ref_.assign(v * o, 0.0);
+    t2_ref_.assign(v * v * o * o, 0.0);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void ccsd::IncrementalIntermediates::mark_built() {
+    const int n_so = state_.n_spin_orbitals;
+    for (int a = o_; a < n_so; ++a)
+        for (int i = 0; i < o_; ++i)
+            t1_ref_[vo(a, i)] = state_.t1(a, i);
+    for (int a = o_; a < n_so; ++a)
+        for (int b = o_; b < n_so; ++b)
+            for (int i = 0; i < o_; ++i)
+                for (int j = 0; j < o_; ++j)
+                    t2_ref_[vvoo(a, b, i, j)] = state_.t2(a, b, i, j);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+std::size_t ccsd::IncrementalIntermediates::update(double threshold) {
+    const int n_so = state_.n_spin_orbitals;
+
+    // Screened T1 change; t1_new is the reference after this update.
+    std::vector<double> t1_new = t1_ref_;
+    std::vector<Delta> d1;   // (a, -, i, -): Δt1(a,i)
+    for (int a = o_; a < n_so; ++a) {
+        for (int i : sym_.occ(irrep(a))) {
+            const double d = state_.t1(a, i) - t1_ref_[vo(a, i)];
+            if (std::abs(d) <= threshold) continue;
+            t1_new[vo(a, i)] = state_.t1(a, i);
+            d1.push_back({a, 0, i, 0, d});
+        }
+    }
+    std::size_t applied = d1.size();
+
+    // Screened T2 change, folded with the T1 products into Δtau, Δtau_tilde
+    // and ΔX over every symmetry-allowed (a,b,i,j).
+    auto t1o = [&](int a, int i) { return t1_ref_[vo(a, i)]; };
+    auto t1n = [&](int a, int i) { return t1_new[vo(a, i)]; };
+    std::vector<Delta> d_tau, d_tau_tilde, d_x;
+    for (int a = o_; a < n_so; ++a) {
+        for (int b = o_; b < n_so; ++b) {
+            for (int i = 0; i < o_; ++i) {
+                for (int j : sym_.occ(irrep(a) ^ irrep(b) ^ irrep(i))) {
+                    double& ref = t2_ref_[vvoo(a, b, i, j)];
+                    double d2 = state_.t2(a, b, i, j) - ref;
+                    if (std::abs(d2) > threshold) {
+                        ref = state_.t2(a, b, i, j);
+                        ++applied;
+                    } else {
+                        d2 = 0.0;
+                    }
+                    const double x_old = t1o(a, i) * t1o(b, j), x_new = t1n(a, i) * t1n(b, j);
+                    const double p_old = x_old - t1o(b, i) * t1o(a, j);
+                    const double p_new = x_new - t1n(b, i) * t1n(a, j);
+                    if (d2 != 0.0 || p_new != p_old) {
+                        d_tau.push_back({a, b, i, j, d2 + (p_new - p_old)});
+                        d_tau_tilde.push_back({a, b, i, j, d2 + 0.5 * (p_new - p_old)});
+                    }
+                    if (d2 != 0.0 || x_new != x_old)
+                        d_x.push_back({a, b, i, j, 0.5 * d2 + (x_new - x_old)});
+                }
+            }
+        }
+    }
+    t1_ref_ = std::move(t1_new);
+
+    scatter_t1(d1);
+    scatter_tau(d_tau, d_tau_tilde, d_x);
+    return applied;
+}
+//=============================================================================
+
+//=============================================================================
+void ccsd::IncrementalIntermediates::scatter_t1(const std::vector<Delta>& d1) { // t1-linear terms of eqs (3)-(8)
+    state_.with_integrals([&](const auto& g) {
+        const int n_so = state_.n_spin_orbitals;
+        const bool W_abef_stored = state_.W_abef.n_size() > 0;
+        for (const Delta& d : d1) {
+            const int x = d.a, m = d.i;   // Δt1(x,m)
+            const double t = d.value;
+            // eq (3): -½ f_me t1(a,m) with a = x;  t1(f,m) <ma||fe> with f = x
+            for (int e : sym_.vir(irrep(x)))
+                state_.F_ae(x,e) += -0.5*state_.fock_spin(m,e)*t;
+            for (int a = o_; a < n_so; ++a)
+                for (int e : sym_.vir(irrep(a)))
+                    state_.F_ae(a,e) += t*g(m,a,x,e);
+            // eq (4): ½ t1(e,i) f_me with (e,i) = (x,m);  t1(e,n) <mn||ie> with (e,n) = (x,m)
+            for (int mm : sym_.occ(irrep(m)))
+                state_.F_mi(mm,m) += 0.5*t*state_.fock_spin(mm,x);
+            for (int mm = 0; mm < o_; ++mm)
+                for (int i : sym_.occ(irrep(mm)))
+                    state_.F_mi(mm,i) += t*g(mm,m,i,x);
+            // eq (5): t1(f,n) <mn||ef> with (f,n) = (x,m)
+            for (int mm = 0; mm < o_; ++mm)
+                for (int e : sym_.vir(irrep(mm)))
+                    state_.F_me(mm,e) += t*g(mm,m,e,x);
+            // eq (6): t1(e,j) <mn||ie> - t1(e,i) <mn||je> with e = x
+            for (int mm = 0; mm < o_; ++mm) {
+                for (int n = 0; n < o_; ++n) {
+                    for (int k : sym_.occ(irrep(mm) ^ irrep(n) ^ irrep(m))) {
+                        state_.W_mnij(mm,n,k,m) +=  t*g(mm,n,k,x);
+                        state_.W_mnij(mm,n,m,k) += -t*g(mm,n,k,x);
+                    }
+                }
+            }
+            // eq (7): -t1(b,m) <am||ef> with b = x;  t1(a,m) <bm||ef> with a = x
+            if (W_abef_stored) {
+                for (int y = o_; y < n_so; ++y) {
+                    for (int e = o_; e < n_so; ++e) {
+                        for (int f : sym_.vir(irrep(y) ^ irrep(x) ^ irrep(e))) {
+                            state_.W_abef(y,x,e,f) += -t*g(y,m,e,f);
+                            state_.W_abef(x,y,e,f) +=  t*g(y,m,e,f);
+                        }
+                    }
+                }
+            }
+            // eq (8): t1(f,j) <mb||ef> with (f,j) = (x,m);  -t1(b,n) <mn||ej> with (b,n) = (x,m)
+            for (int mm = 0; mm < o_; ++mm) {
+                for (int y = o_; y < n_so; ++y) {
+                    for (int e : sym_.vir(irrep(mm) ^ irrep(y) ^ irrep(m)))
+                        state_.W_mbej(mm,y,e,m) += t*g(mm,y,e,x);
+                }
+                for (int e = o_; e < n_so; ++e) {
+                    for (int j : sym_.occ(irrep(mm) ^ irrep(x) ^ irrep(e)))
+                        state_.W_mbej(mm,x,e,j) += -t*g(mm,m,e,j);
+                }
+            }
+        }
+    });
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void ccsd::IncrementalIntermediates::scatter_tau(const std::vector<Delta>& d_tau,
+                                                 const std::vector<Delta>& d_tau_tilde,
+                                                 const std::vector<Delta>& d_x) { // t2 / t1·t1 terms
+    state_.with_integrals([&](const auto& g) {
+        const int n_so = state_.n_spin_orbitals;
+        for (const Delta& d : d_tau_tilde) {
+            // eq (3): -½ tau~(a,f,m,n) <mn||ef>, (a,f,m,n) = (d.a,d.b,d.i,d.j)
+            for (int e : sym_.vir(irrep(d.a)))
+                state_.F_ae(d.a,e) += -0.5*d.value*g(d.i,d.j,e,d.b);
+            // eq (4): ½ tau~(e,f,i,n) <mn||ef>, (e,f,i,n) = (d.a,d.b,d.i,d.j)
+            for (int m : sym_.occ(irrep(d.i)))
+                state_.F_mi(m,d.i) += 0.5*d.value*g(m,d.j,d.a,d.b);
+        }
+        const bool W_abef_stored = state_.W_abef.n_size() > 0;
+        for (const Delta& d : d_tau) {
+            // eq (6): ¼ tau(e,f,i,j) <mn||ef>, (e,f,i,j) = (d.a,d.b,d.i,d.j)
+            for (int m = 0; m < o_; ++m)
+                for (int n : sym_.occ(irrep(m) ^ irrep(d.i) ^ irrep(d.j)))
+                    state_.W_mnij(m,n,d.i,d.j) += 0.25*d.value*g(m,n,d.a,d.b);
+            // eq (7): ¼ tau(a,b,m,n) <mn||ef>, (a,b,m,n) = (d.a,d.b,d.i,d.j)
+            if (W_abef_stored)
+                for (int e = o_; e < n_so; ++e)
+                    for (int f : sym_.vir(irrep(d.a) ^ irrep(d.b) ^ irrep(e)))
+                        state_.W_abef(d.a,d.b,e,f) += 0.25*d.value*g(d.i,d.j,e,f);
+        }
+        for (const Delta& d : d_x) {
+            // eq (8): -X(f,b,j,n) <mn||ef>, (f,b,j,n) = (d.a,d.b,d.i,d.j)
+            for (int m = 0; m < o_; ++m)
+                for (int e : sym_.vir(irrep(m) ^ irrep(d.j) ^ irrep(d.a)))
+                    state_.W_mbej(m,d.b,e,d.i) += -d.value*g(m,d.j,e,d.a);
+        }
+    });
+}
+//=============================================================================
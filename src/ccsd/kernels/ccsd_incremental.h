@@ -0,0 +1,75 @@
+#pragma once
+
+#include <ccsd/kernels/ccsd_state.h>
+#include <ccsd/kernels/ccsd_symmetry.h>
+#include <ccsd/config/ccsd_config.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace ccsd {
+
+// Updates the F/W intermediates (Stanton eqs. 3-8) in place from the change
+// in amplitudes instead of rebuilding them. Every intermediate is
+//   I(t) = C + A·t1 + B·t2 + Q(t1, t1),
+// and all t2 / t1·t1 dependence enters through three per-element quantities
+//   tau(a,b,i,j), tau_tilde(a,b,i,j) and X(a,b,i,j) = ½ t2(a,b,i,j) + t1(a,i) t1(b,j)
+// (X for W_mbej), so I(t_ref + Δ) - I(t_ref) is a scatter of the nonzero
+// Δt1, Δtau, Δtau_tilde and ΔX against the integrals: work proportional to
+// the number of amplitudes that changed.
+//
+// The amplitudes the intermediates currently represent are kept as a
+// reference (t1_ref, t2_ref). update() applies only amplitude elements with
+// |t - t_ref| > threshold and moves those into the reference; smaller changes
+// stay pending and are applied once they accumulate past the threshold, so
+// screening error never exceeds `threshold` per element and does not drift.
+// Round-off is cleared by periodic full rebuilds (mark_built()).
+//
+// W_abef is updated only when it is stored (not rebuilt from slabs). Pure
+// math, no MPI: call on the rank that owns the intermediates.
+class IncrementalIntermediates {
+public:
+    IncrementalIntermediates(CcsdState& state, const ParameterClass& p);
+
+    // Records the current t1/t2 as the amplitudes the intermediates were just
+    // fully rebuilt from.
+    void mark_built();
+
+    // Brings the intermediates from t_ref to the current t1/t2, screened as
+    // above. Returns the number of t1 + t2 elements applied.
+    std::size_t update(double threshold);
+
+    [[nodiscard]] std::size_t bytes() const noexcept {
+        return (t1_ref_.size() + t2_ref_.size()) * sizeof(double);
+    }
+
+private:
+    struct Delta {
+        int a, b, i, j;
+        double value;
+    };
+
+    CcsdState& state_;
+    const ParameterClass& p_;
+    SpinOrbitalSymmetry sym_;
+    int o_ = 0;
+    int v_ = 0;
+    std::vector<double> t1_ref_;   // [a][i], virtual / occupied offsets
+    std::vector<double> t2_ref_;   // [a][b][i][j]
+
+    [[nodiscard]] int irrep(int p) const noexcept { return sym_.label(p); }
+    [[nodiscard]] std::size_t vo(int a, int i) const noexcept {
+        return static_cast<std::size_t>(a - o_) * static_cast<std::size_t>(o_) + static_cast<std::size_t>(i);
+    }
+    [[nodiscard]] std::size_t vvoo(int a, int b, int i, int j) const noexcept {
+        const auto o = static_cast<std::size_t>(o_), v = static_cast<std::size_t>(v_);
+        return ((static_cast<std::size_t>(a - o_) * v + static_cast<std::size_t>(b - o_)) * o
+                + static_cast<std::size_t>(i)) * o + static_cast<std::size_t>(j);
+    }
+
+    void scatter_t1(const std::vector<Delta>& d1);
+    void scatter_tau(const std::vector<Delta>& d_tau, const std::vector<Delta>& d_tau_tilde,
+                     const std::vector<Delta>& d_x);
+};
+
+}  // namespace ccsd
@@ -1,53 +1,35 @@
 #include <ccsd/kernels/ccsd_kernels.h>
+#include <ccsd/kernels/ccsd_omp.h>
+#include <ccsd/kernels/einsum.h>
+#include <util/tensors/transpose.h>
 
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
-#ifdef CCSD_USE_OMP
-  #include <omp.h>
-  #define CCSD_OMP_PARALLEL_FOR _Pragma("omp parallel for")
-#else
-  #define CCSD_OMP_PARALLEL_FOR
-#endif
-
 // Helpers for build_spin_integrals(): 1-indexed spin-orbital → 0-indexed spatial MO, spin parity.
 static int spin_to_mo(int p)          { return (p + 1) / 2; }       // 1-based spin-orbital index p → 1-based spatial MO index (used with get_value's 1-based API).
 static double same_spin(int p, int q) { return ((p % 2) == (q % 2)) ? 1.0 : 0.0; }
 static double kronecker(int a, int b) { return (a == b) ? 1.0 : 0.0; }
 
+// Loops below follow the direct-product decomposition: once the other
+// indices are fixed, a summation index runs only over sym_.occ(g) or
+// sym_.vir(g) for the one label g that keeps the term symmetry-allowed, and
+// output elements whose labels do not multiply to the identity are skipped
+// (they are zero). Each sum still visits its indices in ascending order.
+
 //=============================================================================
 double ccsd::CcsdKernels::get_key(double a, double b, double c, double d) { // Return compound index given four indices
-    double ab, cd, abcd;
-    if (a > b) {
-        ab = a*(a+1)/2 + b;
-    } else {
-        ab = b*(b+1)/2 + a;
-    }
-    if (c > d) {
-        cd = c*(c+1)/2 + d;
-    } else {
-        cd = d*(d+1)/2 + c;
-    }
-    if (ab > cd) {
-        abcd = ab*(ab+1)/2 + cd;
-    } else {
-        abcd = cd*(cd+1)/2 + ab;
-    }
-    return abcd;
+    return compound_index(a, b, c, d);
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 double ccsd::CcsdKernels::get_value(double a, double b, double c, double d) const { // Return Value of spatial MO two electron integral
-    // Example: (12\vert 34) = tei(1,2,3,4)
-    double value;
-    double key = get_key(a, b, c, d);
-    if (p_.two_electron_mos.find(key) == p_.two_electron_mos.end()) {
-        value = 0.0e0;
-    } else {
-        value = p_.two_electron_mos.find(key)->second;
-    }
-    return value;
+    // Example: (12\vert 34) = tei(1,2,3,4); from the table or the caller's buffer.
+    return p_.eri(static_cast<int>(a), static_cast<int>(b), static_cast<int>(c), static_cast<int>(d));
 }
 //-----------------------------------------------------------------------------
 
@@ -55,18 +37,25 @@ double ccsd::CcsdKernels::get_value(double a, double b, double c, double d) cons
 void ccsd::CcsdKernels::build_spin_integrals() { // CONVERT SPATIAL TO SPIN ORBITAL MO,
     // Build the spin-orbital two-electron integrals <pq||rs> = <pq|rs> - <pq|sr>
     // Indices pp,qq,rr,ss are 1-based spin orbitals; spin_to_mo converts to spatial MOs.
+    // Only the blocks with label(p)^label(q)^label(r)^label(s) == 0 are built.
+    // With Cholesky vectors nothing is stored: CholeskyIntegrals assembles them on access.
+    if (!state_.cholesky.empty()) return;
     state_.spin_integrals.zeros();
     for (int pp = 1; pp <= state_.n_spin_orbitals; ++pp) {
         for (int qq = 1; qq <= state_.n_spin_orbitals; ++qq) {
             for (int rr = 1; rr <= state_.n_spin_orbitals; ++rr) {
-                for (int ss = 1; ss <= state_.n_spin_orbitals; ++ss) {
-                    double direct   = get_value(spin_to_mo(pp), spin_to_mo(rr),
-                                                spin_to_mo(qq), spin_to_mo(ss))
-                                    * same_spin(pp,rr) * same_spin(qq,ss);
-                    double exchange = get_value(spin_to_mo(pp), spin_to_mo(ss),
-                                                spin_to_mo(qq), spin_to_mo(rr))
-                                    * same_spin(pp,ss) * same_spin(qq,rr);
-                    state_.spin_integrals(pp-1, qq-1, rr-1, ss-1) = direct - exchange;
+                const int g = irrep(pp-1) ^ irrep(qq-1) ^ irrep(rr-1);
+                for (const auto* block : {&sym_.occ(g), &sym_.vir(g)}) {
+                    for (int s : *block) {
+                        const int ss = s + 1;
+                        double direct   = get_value(spin_to_mo(pp), spin_to_mo(rr),
+                                                    spin_to_mo(qq), spin_to_mo(ss))
+                                        * same_spin(pp,rr) * same_spin(qq,ss);
+                        double exchange = get_value(spin_to_mo(pp), spin_to_mo(ss),
+                                                    spin_to_mo(qq), spin_to_mo(rr))
+                                        * same_spin(pp,ss) * same_spin(qq,rr);
+                        state_.spin_integrals(pp-1, qq-1, rr-1, ss-1) = direct - exchange;
+                    }
                 }
             }
         }
@@ -85,17 +74,19 @@ void ccsd::CcsdKernels::build_fock_spin() { // Spin basis fock matrix eigenvalue
 
 //=============================================================================
 void ccsd::CcsdKernels::guess_t2() {
-    for (int a = p_.n_occupied; a < state_.n_spin_orbitals; ++a) {
-        for (int b = p_.n_occupied; b < state_.n_spin_orbitals; ++b) {
-            for (int i = 0; i < p_.n_occupied; ++i) {
-                for (int j = 0; j < p_.n_occupied; ++j) {
-                    state_.t2(a,b,i,j) += state_.spin_integrals(i,j,a,b)
-                        / (state_.fock_spin(i,i) + state_.fock_spin(j,j)
-                           - state_.fock_spin(a,a) - state_.fock_spin(b,b));
+    state_.with_integrals([&](const auto& g) {
+        for (int a = p_.n_occupied; a < state_.n_spin_orbitals; ++a) {
+            for (int b = p_.n_occupied; b < state_.n_spin_orbitals; ++b) {
+                for (int i = 0; i < p_.n_occupied; ++i) {
+                    for (int j : sym_.occ(irrep(a) ^ irrep(b) ^ irrep(i))) {
+                        state_.t2(a,b,i,j) += g(i,j,a,b)
+                            / (state_.fock_spin(i,i) + state_.fock_spin(j,j)
+                               - state_.fock_spin(a,a) - state_.fock_spin(b,b));
+                    }
                 }
             }
         }
-    }
+    });
 }
 //=============================================================================
 
@@ -135,126 +126,281 @@ double ccsd::CcsdKernels::tau(int a, int b, int i, int j) const { // Stanton eq
 
 //=============================================================================
 void ccsd::CcsdKernels::compute_F_ae() { // Stanton eq (3)
-    state_.F_ae.zeros();
-    for (int a = p_.n_occupied; a < state_.n_spin_orbitals; ++a) {
-        for (int e = p_.n_occupied; e < state_.n_spin_orbitals; ++e) {
-            state_.F_ae(a,e) = (1.0 - kronecker(a,e)) * state_.fock_spin(a,e);
-            for (int m = 0; m < p_.n_occupied; ++m) {
-                state_.F_ae(a,e) += -0.5*state_.fock_spin(m,e)*state_.t1(a,m);
-                for (int f = p_.n_occupied; f < state_.n_spin_orbitals; ++f) {
-                    state_.F_ae(a,e) += state_.t1(f,m)*state_.spin_integrals(m,a,f,e);
-                    for (int n = 0; n < p_.n_occupied; ++n) {
-                        state_.F_ae(a,e) += -0.5*tau_tilde(a,f,m,n)*state_.spin_integrals(m,n,e,f);
+    state_.with_integrals([&](const auto& g) {
+        state_.F_ae.zeros();
+        for (int a = p_.n_occupied; a < state_.n_spin_orbitals; ++a) {
+            for (int e : sym_.vir(irrep(a))) {
+                state_.F_ae(a,e) = (1.0 - kronecker(a,e)) * state_.fock_spin(a,e);
+                for (int m = 0; m < p_.n_occupied; ++m) {
+                    if (singles_) {
+                        state_.F_ae(a,e) += -0.5*state_.fock_spin(m,e)*state_.t1(a,m);
+                        for (int f : sym_.vir(irrep(m))) {
+                            state_.F_ae(a,e) += state_.t1(f,m)*g(m,a,f,e);
+                        }
+                    }
+                    for (int f = p_.n_occupied; f < state_.n_spin_orbitals; ++f) {
+                        for (int n : sym_.occ(irrep(a) ^ irrep(f) ^ irrep(m))) {
+                            state_.F_ae(a,e) += -0.5*tau_tilde(a,f,m,n)*g(m,n,e,f);
+                        }
                     }
                 }
             }
         }
-    }
+    });
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 void ccsd::CcsdKernels::compute_F_mi() { // Stanton eq (4)
-    state_.F_mi.zeros();
-    for (int m = 0; m < p_.n_occupied; ++m) {
-        for (int i = 0; i < p_.n_occupied; ++i) {
-            state_.F_mi(m,i) = (1.0 - kronecker(m,i)) * state_.fock_spin(m,i);
-            for (int e = p_.n_occupied; e < state_.n_spin_orbitals; ++e) {
-                state_.F_mi(m,i) += 0.5*state_.t1(e,i)*state_.fock_spin(m,e);
+    state_.with_integrals([&](const auto& g) {
+        state_.F_mi.zeros();
+        for (int m = 0; m < p_.n_occupied; ++m) {
+            for (int i : sym_.occ(irrep(m))) {
+                state_.F_mi(m,i) = (1.0 - kronecker(m,i)) * state_.fock_spin(m,i);
+                if (singles_) {
+                    for (int e : sym_.vir(irrep(i))) {
+                        state_.F_mi(m,i) += 0.5*state_.t1(e,i)*state_.fock_spin(m,e);
+                    }
+                }
                 for (int n = 0; n < p_.n_occupied; ++n) {
-                    state_.F_mi(m,i) += state_.t1(e,n)*state_.spin_integrals(m,n,i,e);
-                    for (int f = p_.n_occupied; f < state_.n_spin_orbitals; ++f) {
-                        state_.F_mi(m,i) += 0.5*tau_tilde(e,f,i,n)*state_.spin_integrals(m,n,e,f);
+                    if (singles_) {
+                        for (int e : sym_.vir(irrep(n))) {
+                            state_.F_mi(m,i) += state_.t1(e,n)*g(m,n,i,e);
+                        }
+                    }
+                    for (int e = p_.n_occupied; e < state_.n_spin_orbitals; ++e) {
+                        for (int f : sym_.vir(irrep(e) ^ irrep(i) ^ irrep(n))) {
+                            state_.F_mi(m,i) += 0.5*tau_tilde(e,f,i,n)*g(m,n,e,f);
+                        }
                     }
                 }
             }
         }
-    }
+    });
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 void ccsd::CcsdKernels::compute_F_me() { // Stanton eq (5)
-    state_.F_me.zeros();
-    for (int m = 0; m < p_.n_occupied; ++m) {
-        for (int e = p_.n_occupied; e < state_.n_spin_orbitals; ++e) {
-            state_.F_me(m,e) = state_.fock_spin(m,e);
-            for (int n = 0; n < p_.n_occupied; ++n) {
-                for (int f = p_.n_occupied; f < state_.n_spin_orbitals; ++f) {
-                    state_.F_me(m,e) += state_.t1(f,n)*state_.spin_integrals(m,n,e,f);
+    state_.with_integrals([&](const auto& g) {
+        state_.F_me.zeros();
+        for (int m = 0; m < p_.n_occupied; ++m) {
+            for (int e : sym_.vir(irrep(m))) {
+                state_.F_me(m,e) = state_.fock_spin(m,e);
+                for (int n = 0; n < p_.n_occupied; ++n) {
+                    for (int f : sym_.vir(irrep(n))) {
+                        state_.F_me(m,e) += state_.t1(f,n)*g(m,n,e,f);
+                    }
                 }
             }
         }
-    }
+    });
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 void ccsd::CcsdKernels::compute_W_mnij() { // Stanton eq (6)
-    state_.W_mnij.zeros();
-    for (int m = 0; m < p_.n_occupied; ++m) {
-        for (int n = 0; n < p_.n_occupied; ++n) {
-            for (int i = 0; i < p_.n_occupied; ++i) {
-                for (int j = 0; j < p_.n_occupied; ++j) {
-                    state_.W_mnij(m,n,i,j) = state_.spin_integrals(m,n,i,j);
-                    for (int e = p_.n_occupied; e < state_.n_spin_orbitals; ++e) {
-                        state_.W_mnij(m,n,i,j) +=  state_.t1(e,j)*state_.spin_integrals(m,n,i,e)
-                                                   -state_.t1(e,i)*state_.spin_integrals(m,n,j,e);
-                        for (int f = p_.n_occupied; f < state_.n_spin_orbitals; ++f) {
-                            state_.W_mnij(m,n,i,j) += 0.25*tau(e,f,i,j)*state_.spin_integrals(m,n,e,f);
-                        }
-                    }
-                }
-            }
+    using namespace einsum::labels;
+    state_.with_integrals([&](const auto& ints) {
+        const einsum::Spaces sp = spaces();
+        const auto t1   = einsum::tensor(std::as_const(state_.t1), sp);
+        const auto tau_ = einsum::block(sp, [this](int a, int b, int i, int j) { return tau(a, b, i, j); }, e, f, i, j);
+        const auto I_oooo = einsum::block(sp, ints, m, n, i, j);
+        const auto I_ooov = einsum::block(sp, ints, m, n, i, e);
+        const auto I_oovv = einsum::block(sp, ints, m, n, e, f);
+
+        state_.W_mnij.zeros();
+        auto W = einsum::tensor(state_.W_mnij, sp);
+        W(m,n,i,j) += I_oooo(m,n,i,j);
+        if (singles_) {
+            W(m,n,i,j) +=  t1(e,j)*I_ooov(m,n,i,e);
+            W(m,n,i,j) += -t1(e,i)*I_ooov(m,n,j,e);
         }
-    }
+        W(m,n,i,j) += 0.25*tau_(e,f,i,j)*I_oovv(m,n,e,f);
+    });
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 void ccsd::CcsdKernels::compute_W_abef() { // Stanton eq (7)
     state_.W_abef.zeros();
-    for (int a = p_.n_occupied; a < state_.n_spin_orbitals; ++a) {
-        for (int b = p_.n_occupied; b < state_.n_spin_orbitals; ++b) {
-            for (int e = p_.n_occupied; e < state_.n_spin_orbitals; ++e) {
-                for (int f = p_.n_occupied; f < state_.n_spin_orbitals; ++f) {
-                    state_.W_abef(a,b,e,f) = state_.spin_integrals(a,b,e,f);
-                    for (int m = 0; m < p_.n_occupied; ++m) {
-                        state_.W_abef(a,b,e,f) += -state_.t1(b,m)*state_.spin_integrals(a,m,e,f)
-                                                  +state_.t1(a,m)*state_.spin_integrals(b,m,e,f);
-                        for (int n = 0; n < p_.n_occupied; ++n) {
-                            state_.W_abef(a,b,e,f) += 0.25*tau(a,b,m,n)*state_.spin_integrals(m,n,e,f);
-                        }
+    if (state_.cholesky.empty()) {
+        for (int a = p_.n_occupied; a < state_.n_spin_orbitals; ++a)
+            for (int b = p_.n_occupied; b < state_.n_spin_orbitals; ++b)
+                for (int e = p_.n_occupied; e < state_.n_spin_orbitals; ++e)
+                    for (int f : sym_.vir(irrep(a) ^ irrep(b) ^ irrep(e)))
+                        state_.W_abef(a,b,e,f) = state_.spin_integrals(a,b,e,f);
+    } else {
+        W_abef_integrals_from_cholesky();
+    }
+    const int n_occ = p_.n_occupied;
+    const bool screened = screen_ > 0.0;
+    if (screened && oovv_norm_.empty()) throw std::logic_error("compute_W_abef: call build_screening_norms first");
+    state_.with_integrals([&](const auto& g) {
+        for (int a = n_occ; a < state_.n_spin_orbitals; ++a) {
+            for (int b = n_occ; b < state_.n_spin_orbitals; ++b) {
+                // Screening: the τ_mn^ab <mn||ef> ladder is bounded by the
+                // (a,b) block of τ times the (e,f) block of the integrals.
+                double tau_ab = 0.0, ladder_work = 0.0;
+                if (screened) {
+                    tau_ab = tau_pair_norm(a, b);
+                    for (int m = 0; m < n_occ; ++m) ladder_work += static_cast<double>(sym_.occ(irrep(a) ^ irrep(b) ^ irrep(m)).size());
+                }
+                for (int e = n_occ; e < state_.n_spin_orbitals; ++e) {
+                    for (int f : sym_.vir(irrep(a) ^ irrep(b) ^ irrep(e))) {
+                        const bool ladder = !screened || !stats_.skip(tau_ab * oovv_norm_[vv(e, f)], screen_, ladder_work);
+                        state_.W_abef(a,b,e,f) += W_abef_dressing(g, a, b, e, f, ladder);
                     }
                 }
             }
         }
+    });
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+template <class G>
+double ccsd::CcsdKernels::W_abef_dressing(const G& g, int a, int b, int e, int f, bool ladder) const { // eq (7) minus <ab||ef>
+    double acc = 0.0;
+    if (singles_) {
+        for (int m : sym_.occ(irrep(b))) {
+            acc += -state_.t1(b,m)*g(a,m,e,f);
+        }
+        for (int m : sym_.occ(irrep(a))) {
+            acc +=  state_.t1(a,m)*g(b,m,e,f);
+        }
     }
+    if (!ladder) return acc;
+    for (int m = 0; m < p_.n_occupied; ++m) {
+        for (int n : sym_.occ(irrep(a) ^ irrep(b) ^ irrep(m))) {
+            acc += 0.25*tau(a,b,m,n)*g(m,n,e,f);
+        }
+    }
+    return acc;
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-void ccsd::CcsdKernels::compute_W_mbej() { // Stanton eq (8)
-    state_.W_mbej.zeros();
+void ccsd::CcsdKernels::build_vvvv_slab(int pair, double* slab) const { // <ab||ef>, (e,f) row-major
+    state_.with_integrals([&](const auto& g) {
+        const int n_occ  = p_.n_occupied;
+        const int n_virt = state_.n_spin_orbitals - n_occ;
+        const int a = n_occ + pair / n_virt;
+        const int b = n_occ + pair % n_virt;
+        const auto nv = static_cast<std::size_t>(n_virt);
+        std::fill(slab, slab + nv * nv, 0.0);
+        for (int e = n_occ; e < state_.n_spin_orbitals; ++e)
+            for (int f : sym_.vir(irrep(a) ^ irrep(b) ^ irrep(e)))
+                slab[static_cast<std::size_t>(e - n_occ) * nv + static_cast<std::size_t>(f - n_occ)] =
+                    g(a, b, e, f);
+    });
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void ccsd::CcsdKernels::W_abef_integrals_from_cholesky() { // <ab||ef> into W_abef
+    // For each spatial virtual A, one GEMM over the three-index vectors,
+    //   K[E][B F] = Σ_Q L^Q_{AE} L^Q_{BF},
+    // gives (AE|BF) for every E, B, F; both <ab|ef> = (AE|BF) and
+    // <ab|fe> = (AF|BE) of the spin-orbital integrals are read from it.
+    const CholeskyVectors& L = state_.cholesky;
+    const int nq    = L.n_vectors();
+    const int v0    = p_.n_occupied / 2;                 // first spatial virtual
+    const int n_sp  = p_.n_spatial_orbitals;
+    const auto nv   = static_cast<std::size_t>(n_sp - v0);
     CCSD_OMP_PARALLEL_FOR
-    for (int m = 0; m < p_.n_occupied; ++m) {
-        for (int b = p_.n_occupied; b < state_.n_spin_orbitals; ++b) {
-            for (int e = p_.n_occupied; e < state_.n_spin_orbitals; ++e) {
-                for (int j = 0; j < p_.n_occupied; ++j) {
-                    state_.W_mbej(m,b,e,j) = state_.spin_integrals(m,b,e,j);
-                    for (int f = p_.n_occupied; f < state_.n_spin_orbitals; ++f) {
-                        state_.W_mbej(m,b,e,j) += state_.t1(f,j)*state_.spin_integrals(m,b,e,f);
-                    }
-                    for (int n = 0; n < p_.n_occupied; ++n) {
-                        state_.W_mbej(m,b,e,j) += -state_.t1(b,n)*state_.spin_integrals(m,n,e,j);
-                        for (int f = p_.n_occupied; f < state_.n_spin_orbitals; ++f) {
-                            state_.W_mbej(m,b,e,j) += -(0.5*state_.t2(f,b,j,n) + state_.t1(f,j)*state_.t1(b,n))
-                                                       *state_.spin_integrals(m,n,e,f);
-                        }
-                    }
+    for (int A = v0; A < n_sp; ++A) {
+        std::vector<double> K(nv * nv * nv);
+        auto k = [&](int E, int B, int F) -> double& {
+            return K[(static_cast<std::size_t>(E - v0) * nv + static_cast<std::size_t>(B - v0)) * nv
+                     + static_cast<std::size_t>(F - v0)];
+        };
+        for (int E = v0; E < n_sp; ++E) {
+            const double* x = L.row(CholeskyVectors::pair(A, E));
+            for (int B = v0; B < n_sp; ++B)
+                for (int F = v0; F < n_sp; ++F) {
+                    const double* y = L.row(CholeskyVectors::pair(B, F));
+                    double acc = 0.0;
+                    for (int q = 0; q < nq; ++q) acc += x[q] * y[q];
+                    k(E, B, F) = acc;
                 }
-            }
         }
+        for (int a = 2 * A; a < 2 * A + 2; ++a)
+            for (int b = p_.n_occupied; b < state_.n_spin_orbitals; ++b)
+                for (int e = p_.n_occupied; e < state_.n_spin_orbitals; ++e)
+                    for (int f : sym_.vir(irrep(a) ^ irrep(b) ^ irrep(e))) {
+                        double v = 0.0;
+                        if (a % 2 == e % 2 && b % 2 == f % 2) v += k(e / 2, b / 2, f / 2);
+                        if (a % 2 == f % 2 && b % 2 == e % 2) v -= k(f / 2, b / 2, e / 2);
+                        state_.W_abef(a,b,e,f) = v;
+                    }
+    }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void ccsd::CcsdKernels::compute_W_mbej() { // Stanton eq (8)
+    using namespace einsum::labels;
+    state_.with_integrals([&](const auto& ints) {
+        const einsum::Spaces sp = spaces();
+        const auto t1 = einsum::tensor(std::as_const(state_.t1), sp);
+        const auto t2 = einsum::tensor(std::as_const(state_.t2), sp);
+        const auto I_ovvo = einsum::block(sp, ints, m, b, e, j);
+        const auto I_oovo = einsum::block(sp, ints, m, n, e, j);
+        const auto I_oovv = einsum::block(sp, ints, m, n, e, f);
+        const auto o = static_cast<std::size_t>(sp.n_occ), v = static_cast<std::size_t>(sp.n_vir);
+        state_.memory.record("W_mbej scratch", CcsdState::W_mbej_scratch(o, v) * sizeof(double));
+
+        state_.W_mbej.zeros();
+        auto W = einsum::tensor(state_.W_mbej, sp);
+        W(m,b,e,j) += I_ovvo(m,b,e,j);
+        if (singles_) {
+            W_mbej_t1_ovvv(ints);
+            W(m,b,e,j) += -t1(b,n)*I_oovo(m,n,e,j);
+        }
+        W(m,b,e,j) += -0.5*t2(f,b,j,n)*I_oovv(m,n,e,f);
+        if (singles_)
+            W(m,b,e,j) += -t1(f,j)*t1(b,n)*I_oovv(m,n,e,f);   // t1(f,j)·I first when v > o (einsum::plan)
+    });
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+template <class G>
+void ccsd::CcsdKernels::W_mbej_t1_ovvv(const G& g) { // W(m,b,e,j) += Σ_f t1(f,j) <mb||ef>
+    // The o·v³ <mb||ef> block is never formed: one m-slice at a time is
+    // filled and contracted with t1. Slice row (b,e) meets column f only
+    // where label(m)^label(b)^label(e) == label(f), and t1(f,j) is nonzero
+    // only where label(f) == label(j), so with those row labels the product
+    // is one GEMM per label (einsum::detail::symmetric_gemm).
+    const int n_occ = p_.n_occupied;
+    const int n_so  = state_.n_spin_orbitals;
+    const auto o = static_cast<std::size_t>(n_occ), v = static_cast<std::size_t>(n_so - n_occ);
+    std::vector<double> slice(v * v * v), t1(v * o), c(v * v * o);
+    std::vector<int> rows(v * v), f_labels(v), j_labels(o);
+    for (std::size_t f = 0; f < v; ++f) {
+        f_labels[f] = irrep(n_occ + static_cast<int>(f));
+        for (std::size_t j = 0; j < o; ++j) t1[f * o + j] = state_.t1(n_occ + static_cast<int>(f), static_cast<int>(j));
+    }
+    for (std::size_t j = 0; j < o; ++j) j_labels[j] = irrep(static_cast<int>(j));
+    for (int m = 0; m < n_occ; ++m) {
+        std::fill(slice.begin(), slice.end(), 0.0);
+        CCSD_OMP_PARALLEL_FOR
+        for (int b = n_occ; b < n_so; ++b)
+            for (int e = n_occ; e < n_so; ++e) {
+                const auto be = static_cast<std::size_t>(b - n_occ) * v + static_cast<std::size_t>(e - n_occ);
+                rows[be] = irrep(m) ^ irrep(b) ^ irrep(e);
+                for (int f : sym_.vir(rows[be]))
+                    slice[be * v + static_cast<std::size_t>(f - n_occ)] = g(m, b, e, f);
+            }
+        std::fill(c.begin(), c.end(), 0.0);
+        einsum::detail::symmetric_gemm(rows, f_labels, j_labels, 1.0, slice.data(), t1.data(), c.data());
+        CCSD_OMP_PARALLEL_FOR
+        for (int b = n_occ; b < n_so; ++b)
+            for (int e = n_occ; e < n_so; ++e) {
+                const double* x = c.data() + (static_cast<std::size_t>(b - n_occ) * v + static_cast<std::size_t>(e - n_occ)) * o;
+                for (int j = 0; j < n_occ; ++j) state_.W_mbej(m, b, e, j) += x[j];
+            }
     }
 }
 //-----------------------------------------------------------------------------
@@ -262,7 +408,7 @@ void ccsd::CcsdKernels::compute_W_mbej() { // Stanton eq (8)
 //-----------------------------------------------------------------------------
 double ccsd::CcsdKernels::t1_term_F_ae(int a, int i) const {
     double acc = 0.0;
-    for (int e = p_.n_occupied; e < state_.n_spin_orbitals; ++e)
+    for (int e : sym_.vir(irrep(i)))
         acc += state_.t1(e,i)*state_.F_ae(a,e);
     return acc;
 }
@@ -271,38 +417,40 @@ double ccsd::CcsdKernels::t1_term_F_ae(int a, int i) const {
 //-----------------------------------------------------------------------------
 double ccsd::CcsdKernels::t1_term_F_mi(int a, int i) const {
     double acc = 0.0;
-    for (int m = 0; m < p_.n_occupied; ++m)
+    for (int m : sym_.occ(irrep(a)))
         acc += -state_.t1(a,m)*state_.F_mi(m,i);
     return acc;
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-double ccsd::CcsdKernels::t1_terms_doubles(int a, int i) const {
+template <class G>
+double ccsd::CcsdKernels::t1_terms_doubles(const G& g, int a, int i) const {
     double acc = 0.0;
     const int n_occ = p_.n_occupied;
     const int n_so  = state_.n_spin_orbitals;
     for (int m = 0; m < n_occ; ++m) {
-        for (int e = n_occ; e < n_so; ++e) {
+        for (int e : sym_.vir(irrep(m)))
             acc += state_.t2(a,e,i,m)*state_.F_me(m,e);                        // term 4
-            for (int f = n_occ; f < n_so; ++f)
-                acc += -0.5*state_.t2(e,f,i,m)*state_.spin_integrals(m,a,e,f); // term 5
-            for (int n = 0; n < n_occ; ++n)
-                acc += -0.5*state_.t2(a,e,m,n)*state_.spin_integrals(n,m,e,i); // term 6
-        }
+        for (int e = n_occ; e < n_so; ++e)
+            for (int f : sym_.vir(irrep(e) ^ irrep(i) ^ irrep(m)))
+                acc += -0.5*state_.t2(e,f,i,m)*g(m,a,e,f); // term 5
+        for (int n = 0; n < n_occ; ++n)
+            for (int e : sym_.vir(irrep(a) ^ irrep(m) ^ irrep(n)))
+                acc += -0.5*state_.t2(a,e,m,n)*g(n,m,e,i); // term 6
     }
     return acc;
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-double ccsd::CcsdKernels::t1_term_spinint(int a, int i) const {
+template <class G>
+double ccsd::CcsdKernels::t1_term_spinint(const G& g, int a, int i) const {
     double acc = 0.0;
     const int n_occ = p_.n_occupied;
-    const int n_so  = state_.n_spin_orbitals;
     for (int n = 0; n < n_occ; ++n)
-        for (int f = n_occ; f < n_so; ++f)
-            acc += -state_.t1(f,n)*state_.spin_integrals(n,a,i,f);
+        for (int f : sym_.vir(irrep(n)))
+            acc += -state_.t1(f,n)*g(n,a,i,f);
     return acc;
 }
 //-----------------------------------------------------------------------------
@@ -310,40 +458,59 @@ double ccsd::CcsdKernels::t1_term_spinint(int a, int i) const {
 //-----------------------------------------------------------------------------
 void ccsd::CcsdKernels::compute_t1() { // Stanton eq (1)
     state_.t1_next.zeros();
+    compute_t1_tile(0, state_.n_spin_orbitals - p_.n_occupied);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void ccsd::CcsdKernels::compute_t1_tile(int v_begin, int v_end) { // Stanton eq (1), a ∈ tile
     const int n_occ = p_.n_occupied;
-    const int n_so  = state_.n_spin_orbitals;
-    CCSD_OMP_PARALLEL_FOR
-    for (int a = n_occ; a < n_so; ++a) {
-        for (int i = 0; i < n_occ; ++i) {
-            double acc = state_.fock_spin(i, a)      // Stanton eq. (1), term 1: Fock off-diagonal
-                       + t1_term_F_ae(a, i)           // term 2: T1·F_ae
-                       + t1_term_F_mi(a, i)           // term 3: T1·F_mi
-                       + t1_terms_doubles(a, i)       // terms 4–6: T2 dressed with F_me and spinints
-                       + t1_term_spinint(a, i);       // term 7: T1·<na||if>
-            state_.t1_next(a, i) = acc / state_.denom_ai(a, i);
-        }
+    if (!singles_) {   // CCD: T1 stays zero
+        for (int a = n_occ + v_begin; a < n_occ + v_end; ++a)
+            for (int i = 0; i < n_occ; ++i) state_.t1_next(a, i) = 0.0;
+        return;
     }
+    state_.with_integrals([&](const auto& g) {
+        CCSD_OMP_PARALLEL_FOR
+        for (int a = n_occ + v_begin; a < n_occ + v_end; ++a) {
+            for (int i = 0; i < n_occ; ++i) {
+                if (!sym_.allowed(a, i)) {
+                    state_.t1_next(a, i) = 0.0;
+                    continue;
+                }
+                double acc = state_.fock_spin(i, a)      // Stanton eq. (1), term 1: Fock off-diagonal
+                           + t1_term_F_ae(a, i)           // term 2: T1·F_ae
+                           + t1_term_F_mi(a, i)           // term 3: T1·F_mi
+                           + t1_terms_doubles(g, a, i)       // terms 4–6: T2 dressed with F_me and spinints
+                           + t1_term_spinint(g, a, i);       // term 7: T1·<na||if>
+                state_.t1_next(a, i) = acc / state_.denom_ai(a, i);
+            }
+        }
+    });
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-double ccsd::CcsdKernels::t2_term_spinint(int a, int b, int i, int j) const {
-    return state_.spin_integrals(i, j, a, b);
+template <class G>
+double ccsd::CcsdKernels::t2_term_spinint(const G& g, int a, int b, int i, int j) const {
+    return g(i, j, a, b);
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 double ccsd::CcsdKernels::t2_terms_F_ae(int a, int b, int i, int j) const {
     double acc = 0.0;
-    const int n_occ = p_.n_occupied;
-    const int n_so  = state_.n_spin_orbitals;
-    for (int e = n_occ; e < n_so; ++e) {
-        acc += state_.t2(a,e,i,j)*state_.F_ae(b,e)
-              -state_.t2(b,e,i,j)*state_.F_ae(a,e);
-        for (int m = 0; m < n_occ; ++m) {
-            acc += -0.5*state_.t2(a,e,i,j)*state_.t1(b,m)*state_.F_me(m,e)
-                   +0.5*state_.t2(b,e,i,j)*state_.t1(a,m)*state_.F_me(m,e);
-        }
+    for (int e : sym_.vir(irrep(b))) {
+        acc += state_.t2(a,e,i,j)*state_.F_ae(b,e);
+        if (singles_)
+            for (int m : sym_.occ(irrep(b)))
+                acc += -0.5*state_.t2(a,e,i,j)*state_.t1(b,m)*state_.F_me(m,e);
+    }
+    for (int e : sym_.vir(irrep(a))) {
+        acc += -state_.t2(b,e,i,j)*state_.F_ae(a,e);
+        if (singles_)
+            for (int m : sym_.occ(irrep(a)))
+                acc += +0.5*state_.t2(b,e,i,j)*state_.t1(a,m)*state_.F_me(m,e);
     }
     return acc;
 }
@@ -352,79 +519,129 @@ double ccsd::CcsdKernels::t2_terms_F_ae(int a, int b, int i, int j) const {
 //-----------------------------------------------------------------------------
 double ccsd::CcsdKernels::t2_terms_F_mi(int a, int b, int i, int j) const {
     double acc = 0.0;
-    const int n_occ = p_.n_occupied;
-    const int n_so  = state_.n_spin_orbitals;
-    for (int m = 0; m < n_occ; ++m) {
-        acc += -state_.t2(a,b,i,m)*state_.F_mi(m,j)
-               +state_.t2(a,b,j,m)*state_.F_mi(m,i);
-        for (int e = n_occ; e < n_so; ++e) {
-            acc += -0.5*state_.t2(a,b,i,m)*state_.t1(e,j)*state_.F_me(m,e)
-                   +0.5*state_.t2(a,b,j,m)*state_.t1(e,i)*state_.F_me(m,e);
-        }
+    for (int m : sym_.occ(irrep(j))) {
+        acc += -state_.t2(a,b,i,m)*state_.F_mi(m,j);
+        if (singles_)
+            for (int e : sym_.vir(irrep(j)))
+                acc += -0.5*state_.t2(a,b,i,m)*state_.t1(e,j)*state_.F_me(m,e);
+    }
+    for (int m : sym_.occ(irrep(i))) {
+        acc += +state_.t2(a,b,j,m)*state_.F_mi(m,i);
+        if (singles_)
+            for (int e : sym_.vir(irrep(i)))
+                acc += +0.5*state_.t2(a,b,j,m)*state_.t1(e,i)*state_.F_me(m,e);
     }
     return acc;
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-double ccsd::CcsdKernels::t2_term_single_excitations(int a, int b, int i, int j) const {
+template <class G>
+double ccsd::CcsdKernels::t2_term_single_excitations(const G& g, int a, int b, int i, int j) const {
     double acc = 0.0;
-    const int n_occ = p_.n_occupied;
-    const int n_so  = state_.n_spin_orbitals;
-    for (int e = n_occ; e < n_so; ++e) {
-        acc += state_.t1(e,i)*state_.spin_integrals(a,b,e,j)
-              -state_.t1(e,j)*state_.spin_integrals(a,b,e,i);
-    }
+    for (int e : sym_.vir(irrep(i)))
+        acc += state_.t1(e,i)*g(a,b,e,j);
+    for (int e : sym_.vir(irrep(j)))
+        acc += -state_.t1(e,j)*g(a,b,e,i);
     return acc;
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-double ccsd::CcsdKernels::t2_term_W_abef(int a, int b, int i, int j) const {
+double ccsd::CcsdKernels::t2_term_W_abef(int i, int j, const TensorView<2>& W_ab, const double* tau_ij,
+                                         const double* W_rows, const double* tau_rows, ScreeningStats* stats) const {
+    // W_ab: the (e,f) plane of W_abef for this (a,b); tau_ij: tau(:,:,i,j)
+    // from tau_planes(). Both are indexed by virtual offsets, f fastest.
     double acc = 0.0;
     const int n_occ = p_.n_occupied;
     const int n_so  = state_.n_spin_orbitals;
-    for (int e = n_occ; e < n_so; ++e)
-        for (int f = n_occ; f < n_so; ++f)
-            acc += 0.5*tau(e,f,i,j)*state_.W_abef(a,b,e,f);
+    const auto nv   = static_cast<std::ptrdiff_t>(n_so - n_occ);
+    for (int e = n_occ; e < n_so; ++e) {
+        const std::vector<int>& fs = sym_.vir(irrep(e) ^ irrep(i) ^ irrep(j));
+        if (stats && stats->skip(W_rows[e - n_occ] * tau_rows[e - n_occ], screen_, static_cast<double>(fs.size())))
+            continue;
+        const double* w = W_ab.data + (e - n_occ) * W_ab.strides[0];
+        const double* t = tau_ij + (e - n_occ) * nv;
+        for (int f : fs)
+            acc += 0.5*t[f - n_occ]*w[(f - n_occ) * W_ab.strides[1]];
+    }
     return acc;
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-double ccsd::CcsdKernels::t2_term_single_dressing(int a, int b, int i, int j) const {
+std::vector<double> ccsd::CcsdKernels::tau_planes() const { // tau(e,f,i,j) stored [i][j][e][f]
+    // t2 is read (e,f)-plane by (e,f)-plane in the W_abef term, across its
+    // slow dimensions in the standard layout. One blocked transpose of the
+    // vvoo block makes every plane contiguous, then the T1 products are added.
+    const int o = p_.n_occupied;
+    const int v = state_.n_spin_orbitals - o;
+    const auto O = static_cast<std::ptrdiff_t>(o), V = static_cast<std::ptrdiff_t>(v);
+    std::vector<double> out(static_cast<std::size_t>(O * O * V * V));
+    transpose(state_.t2.view().sub({o, o, 0, 0}, {v, v, o, o}), out.data(), {V, 1, O * V * V, V * V});
+    if (!singles_) return out;
+    for (int i = 0; i < o; ++i)
+        for (int j = 0; j < o; ++j)
+            for (int e = o; e < o + v; ++e)
+                for (int f = o; f < o + v; ++f)
+                    out[static_cast<std::size_t>(((i * O + j) * V + (e - o)) * V + (f - o))] +=
+                        state_.t1(e,i)*state_.t1(f,j) - state_.t1(f,i)*state_.t1(e,j);
+    return out;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+template <class G>
+double ccsd::CcsdKernels::t2_term_single_dressing(const G& g, int a, int b, int i, int j) const {
     double acc = 0.0;
-    for (int m = 0; m < p_.n_occupied; ++m) {
-        acc += -state_.t1(a,m)*state_.spin_integrals(m,b,i,j)
-               +state_.t1(b,m)*state_.spin_integrals(m,a,i,j);
-    }
+    for (int m : sym_.occ(irrep(a)))
+        acc += -state_.t1(a,m)*g(m,b,i,j);
+    for (int m : sym_.occ(irrep(b)))
+        acc += +state_.t1(b,m)*g(m,a,i,j);
     return acc;
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-double ccsd::CcsdKernels::t2_terms_W_mbej(int a, int b, int i, int j) const {
+template <class G>
+double ccsd::CcsdKernels::t2_terms_W_mbej(const G& g, int a, int b, int i, int j, const TensorView<4>& W, unsigned keep) const {
+    // W: W_mbej(m, x - o, e - o, k) as in WSlices; w(m,x,k)[e - o] walks e.
     double acc = 0.0;
     const int n_occ = p_.n_occupied;
-    const int n_so  = state_.n_spin_orbitals;
+    const std::ptrdiff_t se = W.strides[2];
+    const auto w = [&](int m, int x, int k) {
+        return W.data + m * W.strides[0] + (x - n_occ) * W.strides[1] + k * W.strides[3];
+    };
     for (int m = 0; m < n_occ; ++m) {
-        for (int e = n_occ; e < n_so; ++e) {
-            acc +=  state_.t2(a,e,i,m)*state_.W_mbej(m,b,e,j) - state_.t1(e,i)*state_.t1(a,m)*state_.spin_integrals(m,b,e,j);
-            acc += -state_.t2(a,e,j,m)*state_.W_mbej(m,b,e,i) + state_.t1(e,j)*state_.t1(a,m)*state_.spin_integrals(m,b,e,i);
-            acc += -state_.t2(b,e,i,m)*state_.W_mbej(m,a,e,j) + state_.t1(e,i)*state_.t1(b,m)*state_.spin_integrals(m,a,e,j);
-            acc +=  state_.t2(b,e,j,m)*state_.W_mbej(m,a,e,i) - state_.t1(e,j)*state_.t1(b,m)*state_.spin_integrals(m,a,e,i);
-        }
+        const int gm = irrep(m);
+        const double* bj = w(m,b,j);
+        const double* bi = w(m,b,i);
+        const double* aj = w(m,a,j);
+        const double* ai = w(m,a,i);
+        if (keep & 1u) for (int e : sym_.vir(irrep(a) ^ irrep(i) ^ gm)) acc +=  state_.t2(a,e,i,m)*bj[(e - n_occ) * se];
+        if (keep & 2u) for (int e : sym_.vir(irrep(a) ^ irrep(j) ^ gm)) acc += -state_.t2(a,e,j,m)*bi[(e - n_occ) * se];
+        if (keep & 4u) for (int e : sym_.vir(irrep(b) ^ irrep(i) ^ gm)) acc += -state_.t2(b,e,i,m)*aj[(e - n_occ) * se];
+        if (keep & 8u) for (int e : sym_.vir(irrep(b) ^ irrep(j) ^ gm)) acc +=  state_.t2(b,e,j,m)*ai[(e - n_occ) * se];
+    }
+    if (!singles_) return acc;
+    for (int m : sym_.occ(irrep(a))) {
+        for (int e : sym_.vir(irrep(i))) acc += -state_.t1(e,i)*state_.t1(a,m)*g(m,b,e,j);
+        for (int e : sym_.vir(irrep(j))) acc +=  state_.t1(e,j)*state_.t1(a,m)*g(m,b,e,i);
+    }
+    for (int m : sym_.occ(irrep(b))) {
+        for (int e : sym_.vir(irrep(i))) acc +=  state_.t1(e,i)*state_.t1(b,m)*g(m,a,e,j);
+        for (int e : sym_.vir(irrep(j))) acc += -state_.t1(e,j)*state_.t1(b,m)*g(m,a,e,i);
     }
     return acc;
 }
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-double ccsd::CcsdKernels::t2_term_W_mnij(int a, int b, int i, int j) const {
+double ccsd::CcsdKernels::t2_term_W_mnij(int a, int b, int i, int j, const TensorView<4>& W) const {
     double acc = 0.0;
     for (int m = 0; m < p_.n_occupied; ++m)
-        for (int n = 0; n < p_.n_occupied; ++n)
-            acc += 0.5*tau(a,b,m,n)*state_.W_mnij(m,n,i,j);
+        for (int n : sym_.occ(irrep(a) ^ irrep(b) ^ irrep(m)))
+            acc += 0.5*tau(a,b,m,n)*W(m,n,i,j);
     return acc;
 }
 //-----------------------------------------------------------------------------
@@ -432,44 +649,214 @@ double ccsd::CcsdKernels::t2_term_W_mnij(int a, int b, int i, int j) const {
 //-----------------------------------------------------------------------------
 void ccsd::CcsdKernels::compute_t2() { // Stanton eq (2)
     state_.t2_next.zeros();
+    const int n_virt = state_.n_spin_orbitals - p_.n_occupied;
+    prepare_t2_tiles();
+    compute_t2_tile(0, n_virt * n_virt);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void ccsd::CcsdKernels::prepare_t2_tiles(const WSlices* remote) { // shared by every tile of an iteration
     const int n_occ = p_.n_occupied;
-    const int n_so  = state_.n_spin_orbitals;
-    CCSD_OMP_PARALLEL_FOR
-    for (int a = n_occ; a < n_so; ++a) {
-        for (int b = n_occ; b < n_so; ++b) {
+    tau_ij_ = tau_planes();
+    state_.memory.record("tau planes", tau_ij_.size() * sizeof(double));
+    if (screen_ <= 0.0) return;
+    const int n_virt = state_.n_spin_orbitals - n_occ;
+    const TensorView<4> W_mnij = remote ? remote->W_mnij
+                                        : state_.W_mnij.view().sub({0, 0, 0, 0}, {n_occ, n_occ, n_occ, n_occ});
+    const TensorView<4> W_mbej = remote ? remote->W_mbej
+                                        : state_.W_mbej.view().sub({0, n_occ, n_occ, 0}, {n_occ, n_virt, n_virt, n_occ});
+    norms_ = t2_norms(tau_ij_, W_mnij, W_mbej);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void ccsd::CcsdKernels::compute_t2_tile(int pair_begin, int pair_end, const double* vvvv,
+                                         const WSlices* remote) { // Stanton eq (2), (a,b) ∈ tile
+    const int n_occ  = p_.n_occupied;
+    const int n_virt = state_.n_spin_orbitals - n_occ;
+    const auto nv    = static_cast<std::size_t>(n_virt);
+    const auto nv2   = nv * nv;
+    if (tau_ij_.empty()) throw std::logic_error("compute_t2_tile: call prepare_t2_tiles first");
+    const std::vector<double>& tau_ij = tau_ij_;
+    const T2Norms& norms = norms_;
+    // W_mbej / W_mnij from the caller's fetched slices, else the same boxes
+    // of the stored intermediates.
+    const TensorView<4> W_mbej = remote ? remote->W_mbej
+                                        : state_.W_mbej.view().sub({0, n_occ, n_occ, 0}, {n_occ, n_virt, n_virt, n_occ});
+    const TensorView<4> W_mnij = remote ? remote->W_mnij
+                                        : state_.W_mnij.view().sub({0, 0, 0, 0}, {n_occ, n_occ, n_occ, n_occ});
+
+    // Screening: block norms of the amplitudes, W_mnij and W_mbej from
+    // prepare_t2_tiles; the W_ab norms are taken per pair, from exactly the
+    // plane this rank holds. Work counts are kept per pair and summed in
+    // pair order afterwards.
+    const bool screened = screen_ > 0.0;
+    if (screened && vvvv && oovv_norm_.empty()) throw std::logic_error("compute_t2_tile: call build_screening_norms first");
+    std::vector<ScreeningStats> pair_stats(screened ? static_cast<std::size_t>(pair_end - pair_begin) : 0);
+    const auto ring_work = [&](int x, int y) {
+        double w = 0.0;
+        for (int m = 0; m < n_occ; ++m) w += static_cast<double>(sym_.vir(irrep(x) ^ irrep(y) ^ irrep(m)).size());
+        return w;
+    };
+
+    state_.with_integrals([&](const auto& g) {
+        CCSD_OMP_PARALLEL_FOR_DYNAMIC
+        for (int pair = pair_begin; pair < pair_end; ++pair) {
+            const int a = n_occ + pair / n_virt;
+            const int b = n_occ + pair % n_virt;
+            ScreeningStats* st = screened ? &pair_stats[static_cast<std::size_t>(pair - pair_begin)] : nullptr;
+            double tau_ab = 0.0, ladder_work = 0.0;
+            if (screened) {
+                tau_ab = tau_pair_norm(a, b);
+                for (int m = 0; m < n_occ; ++m) ladder_work += static_cast<double>(sym_.occ(irrep(a) ^ irrep(b) ^ irrep(m)).size());
+            }
+            // Streamed integrals: W_abef(a,b,:,:) is built here from the slab
+            // instead of being read from the stored intermediate.
+            std::vector<double> W_ab;
+            TensorView<2> W_plane;
+            if (vvvv) {
+                const double* slab = vvvv + static_cast<std::size_t>(pair - pair_begin) * nv2;
+                W_ab.assign(slab, slab + nv2);
+                for (int e = n_occ; e < state_.n_spin_orbitals; ++e)
+                    for (int f : sym_.vir(irrep(a) ^ irrep(b) ^ irrep(e))) {
+                        const bool ladder = !st || !st->skip(tau_ab * oovv_norm_[vv(e, f)], screen_, ladder_work);
+                        W_ab[vv(e, f)] += W_abef_dressing(g, a, b, e, f, ladder);
+                    }
+                W_plane = TensorView<2>::row_major(W_ab.data(), {n_virt, n_virt});
+            } else if (remote) {
+                W_plane = TensorView<2>::row_major(remote->W_abef + static_cast<std::size_t>(pair - pair_begin) * nv2, {n_virt, n_virt});
+            } else {
+                const TensorView<4> W = state_.W_abef.view();
+                W_plane = {W.data + state_.W_abef.offset(a, b, n_occ, n_occ), {n_virt, n_virt}, {W.strides[2], W.strides[3]}};
+            }
+            std::vector<double> W_rows;   // e-row norms of W_ab
+            if (screened) {
+                W_rows.assign(nv, 0.0);
+                for (int e = 0; e < n_virt; ++e)
+                    for (int f = 0; f < n_virt; ++f)
+                        W_rows[static_cast<std::size_t>(e)] = std::max(W_rows[static_cast<std::size_t>(e)],
+                                                                       std::abs(W_plane.data[e * W_plane.strides[0] + f * W_plane.strides[1]]));
+            }
             for (int i = 0; i < n_occ; ++i) {
                 for (int j = 0; j < n_occ; ++j) {
-                    double acc = t2_term_spinint(a, b, i, j)
+                    if (!sym_.allowed(a, b, i, j)) {
+                        state_.t2_next(a, b, i, j) = 0.0;
+                        continue;
+                    }
+                    const std::size_t ij = static_cast<std::size_t>(i * n_occ + j);
+                    unsigned ring = 0xF;
+                    bool hole_ladder = true;
+                    if (st) {
+                        const auto t2n = [&](int x, int k) { return norms.t2_ai[static_cast<std::size_t>((x - n_occ) * n_occ + k)]; };
+                        const auto Wn  = [&](int x, int k) { return norms.W_xj[static_cast<std::size_t>((x - n_occ) * n_occ + k)]; };
+                        if (st->skip(t2n(a, i) * Wn(b, j), screen_, ring_work(a, i))) ring &= ~1u;
+                        if (st->skip(t2n(a, j) * Wn(b, i), screen_, ring_work(a, j))) ring &= ~2u;
+                        if (st->skip(t2n(b, i) * Wn(a, j), screen_, ring_work(b, i))) ring &= ~4u;
+                        if (st->skip(t2n(b, j) * Wn(a, i), screen_, ring_work(b, j))) ring &= ~8u;
+                        hole_ladder = !st->skip(tau_ab * norms.W_ij[ij], screen_, ladder_work);
+                    }
+                    double acc = t2_term_spinint(g, a, b, i, j)
                                + t2_terms_F_ae(a, b, i, j)
                                + t2_terms_F_mi(a, b, i, j)
-                               + t2_term_single_excitations(a, b, i, j)
-                               + t2_term_W_abef(a, b, i, j)
-                               + t2_term_single_dressing(a, b, i, j)
-                               + t2_terms_W_mbej(a, b, i, j)
-                               + t2_term_W_mnij(a, b, i, j);
+                               + (singles_ ? t2_term_single_excitations(g, a, b, i, j) : 0.0)
+                               + t2_term_W_abef(i, j, W_plane, tau_ij.data() + ij * nv2,
+                                                st ? W_rows.data() : nullptr,
+                                                st ? norms.tau_row.data() + ij * nv : nullptr, st)
+                               + (singles_ ? t2_term_single_dressing(g, a, b, i, j) : 0.0)
+                               + t2_terms_W_mbej(g, a, b, i, j, W_mbej, ring)
+                               + (hole_ladder ? t2_term_W_mnij(a, b, i, j, W_mnij) : 0.0);
                     state_.t2_next(a, b, i, j) = acc / state_.denom_abij(a, b, i, j);
                 }
             }
         }
-    }
+        for (const ScreeningStats& p : pair_stats) stats_ += p;
+    });
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+ccsd::CcsdKernels::T2Norms ccsd::CcsdKernels::t2_norms(const std::vector<double>& tau_ij, const TensorView<4>& W_mnij,
+                                                       const TensorView<4>& W_mbej) const {
+    const int o = p_.n_occupied;
+    const int v = state_.n_spin_orbitals - o;
+    const auto O = static_cast<std::size_t>(o), V = static_cast<std::size_t>(v);
+    T2Norms n;
+    n.tau_row.resize(O * O * V);
+    for (std::size_t r = 0; r < n.tau_row.size(); ++r) n.tau_row[r] = max_abs(tau_ij.data() + r * V, V);
+    n.t2_ai.assign(V * O, 0.0);
+    for (int a = o; a < o + v; ++a)
+        for (int i = 0; i < o; ++i) {
+            double& m = n.t2_ai[static_cast<std::size_t>((a - o) * o + i)];
+            for (int e = o; e < o + v; ++e)
+                for (int k = 0; k < o; ++k) m = std::max(m, std::abs(state_.t2(a, e, i, k)));
+        }
+    n.W_ij.assign(O * O, 0.0);
+    for (int m = 0; m < o; ++m)
+        for (int k = 0; k < o; ++k)
+            for (int i = 0; i < o; ++i)
+                for (int j = 0; j < o; ++j) {
+                    double& w = n.W_ij[static_cast<std::size_t>(i * o + j)];
+                    w = std::max(w, std::abs(W_mnij(m, k, i, j)));
+                }
+    n.W_xj.assign(V * O, 0.0);
+    for (int m = 0; m < o; ++m)
+        for (int x = 0; x < v; ++x)
+            for (int e = 0; e < v; ++e)
+                for (int j = 0; j < o; ++j) {
+                    double& w = n.W_xj[static_cast<std::size_t>(x * o + j)];
+                    w = std::max(w, std::abs(W_mbej(m, x, e, j)));
+                }
+    return n;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+double ccsd::CcsdKernels::tau_pair_norm(int a, int b) const {
+    double m = 0.0;
+    for (int i = 0; i < p_.n_occupied; ++i)
+        for (int j : sym_.occ(irrep(a) ^ irrep(b) ^ irrep(i)))
+            m = std::max(m, std::abs(tau(a, b, i, j)));
+    return m;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void ccsd::CcsdKernels::build_screening_norms() { // max_mn |<mn||ef>| per (e,f)
+    if (screen_ <= 0.0) return;
+    const int n_occ = p_.n_occupied;
+    const int n_so  = state_.n_spin_orbitals;
+    const auto nv   = static_cast<std::size_t>(n_so - n_occ);
+    state_.with_integrals([&](const auto& g) {
+        oovv_norm_.assign(nv * nv, 0.0);
+        for (int e = n_occ; e < n_so; ++e)
+            for (int f = n_occ; f < n_so; ++f) {
+                double& m = oovv_norm_[vv(e, f)];
+                for (int i = 0; i < n_occ; ++i)
+                    for (int j : sym_.occ(irrep(e) ^ irrep(f) ^ irrep(i)))
+                        m = std::max(m, std::abs(g(i, j, e, f)));
+            }
+    });
 }
 //=============================================================================
 
 //=============================================================================
 double ccsd::CcsdKernels::compute_energy() const { // Equation (134) and (173); Expression from Crawford, Schaefer (2000)
-    // DOI: 10.1002/9780470125915.ch2
-    // computes CCSD energy given T1 and T2
-    double ECCSD = 0.0;
-    for (int i = 0; i < p_.n_occupied; ++i) {
-        for (int a = p_.n_occupied; a < state_.n_spin_orbitals; ++a) {
-            for (int j = 0; j < p_.n_occupied; ++j) {
-                for (int b = p_.n_occupied; b < state_.n_spin_orbitals; ++b) {
-                    ECCSD += 0.25*state_.spin_integrals(i,j,a,b)*state_.t2(a,b,i,j)
-                           + 0.5*state_.spin_integrals(i,j,a,b)*state_.t1(a,i)*state_.t1(b,j);
+    return state_.with_integrals([&](const auto& g) {
+        // DOI: 10.1002/9780470125915.ch2
+        // computes CCSD energy given T1 and T2
+        double ECCSD = 0.0;
+        for (int i = 0; i < p_.n_occupied; ++i) {
+            for (int a = p_.n_occupied; a < state_.n_spin_orbitals; ++a) {
+                for (int j = 0; j < p_.n_occupied; ++j) {
+                    for (int b : sym_.vir(irrep(i) ^ irrep(a) ^ irrep(j))) {
+                        ECCSD += 0.25*g(i,j,a,b)*state_.t2(a,b,i,j)
+                               + 0.5*g(i,j,a,b)*state_.t1(a,i)*state_.t1(b,j);
+                    }
                 }
             }
         }
-    }
-    return ECCSD;
+        return ECCSD;
+    });
 }
 //=============================================================================
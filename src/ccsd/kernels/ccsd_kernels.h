@@ -1,16 +1,26 @@
 #pragma once
 
+#include <ccsd/kernels/ccsd_screening.h>
 #include <ccsd/kernels/ccsd_state.h>
+#include <ccsd/kernels/ccsd_symmetry.h>
+#include <ccsd/kernels/einsum.h>
 #include <ccsd/config/ccsd_config.h>
+#include <util/tensors/tensor_view.h>
+
+#include <cstddef>
+#include <vector>
 
 namespace ccsd {
 
 // Pure math: implements the Stanton (1991) CCSD equations.
 // No MPI calls. Caller is responsible for rank-gating.
+// Every loop visits only symmetry-allowed index combinations (see
+// SpinOrbitalSymmetry), so `p` must be loaded before construction.
 class CcsdKernels {
 public:
     CcsdKernels(CcsdState& state, const ParameterClass& p)
-        : state_(state), p_(p) {}
+        : state_(state), p_(p),
+          sym_(p.orbital_symmetry, 2 * p.n_spatial_orbitals, p.n_occupied) {}
 
     // Initialization
     void build_spin_integrals();   // <pq||rs> in spin-orbital basis
@@ -26,14 +36,73 @@ public:
     void compute_W_abef();
     void compute_W_mbej();
 
-    // Amplitude equations (Stanton eqs. 1-2)
-    // Pre-condition: caller ensures this runs only on rank_master.
+    // Amplitude equations (Stanton eqs. 1-2) over the full virtual range.
     void compute_t1();
     void compute_t2();
 
+    // Tile variants used by the distributed update: each rank evaluates only
+    // virtual offsets v ∈ [v_begin, v_end) for T1 (a = n_occ + v), or virtual
+    // pairs p ∈ [pair_begin, pair_end) for T2 (a = n_occ + p / n_virt,
+    // b = n_occ + p % n_virt). Entries outside the tile are left untouched.
+    // With `vvvv` (the build_vvvv_slab slabs of the tile's pairs, in pair
+    // order) W_abef is never read: each pair's plane is rebuilt from its slab.
+    // With `remote` the W intermediates are read from those fetched slices
+    // instead of the state (a rank that does not own them).
+    // compute_t2_tile reads what prepare_t2_tiles built: call that once per
+    // iteration, after the intermediates and before the first tile, with
+    // the same `remote` (its W_mbej / W_mnij are the same for every tile).
+    void compute_t1_tile(int v_begin, int v_end);
+    void prepare_t2_tiles(const WSlices* remote = nullptr);
+    void compute_t2_tile(int pair_begin, int pair_end, const double* vvvv = nullptr,
+                         const WSlices* remote = nullptr);
+
+    // <ab||ef> over all virtual (e,f), row-major, for virtual pair `pair`
+    // (numbered as in compute_t2_tile): the slab a run without a stored
+    // W_abef streams from scratch or keeps in memory.
+    void build_vvvv_slab(int pair, double* slab) const;
+
     // Energy expression (Crawford & Schaefer 2000, eq. 134/173)
     [[nodiscard]] double compute_energy() const;
 
+    // Cheaper members of the hierarchy (ccsd_methods.cpp).
+    // CCD: with singles off, T1 is frozen at zero and every T1 term of the
+    // intermediates and of eqs. (1)-(2) is skipped rather than added as zero;
+    // compute_t1_tile only clears its tile and F_me is not needed.
+    void set_singles(bool on) noexcept { singles_ = on; }
+    [[nodiscard]] bool singles() const noexcept { return singles_; }
+    // MP3: the third-order energy E(3) from the first-order T2 in t2
+    // (guess_t2 with T1 zero); the MP3 correlation energy is
+    // compute_energy() + compute_mp3_energy().
+    [[nodiscard]] double compute_mp3_energy() const;
+    // E(3) split by virtual row: partial[v] for v ∈ [v_begin, v_end) (a =
+    // n_occ + v) gets the terms of row a, the rest is left untouched. The
+    // energy is the sum of all n_virt entries in order, however the rows
+    // were split.
+    void compute_mp3_partials(int v_begin, int v_end, std::vector<double>& partial) const;
+    // CC2: doubles from the T1-transformed integrals, t_ij^ab = <ab||ij>~ / D,
+    // into t2_next for every pair. T1 follows eq. (1) with F_ae/F_mi/F_me
+    // only; no W intermediate is built.
+    void compute_t2_cc2();
+    // compute_t2_cc2 for the pairs of one tile (numbered as in
+    // compute_t2_tile); entries outside it are left untouched. The integral
+    // transforms run only over the rows the tile reads.
+    void compute_t2_cc2_tile(int pair_begin, int pair_end);
+
+    // Screening (> 0): a contraction block is skipped when the product of
+    // its operands' block max norms is below the threshold. Screened are
+    // the T2 terms (W_abef ladder per e row of τ_ij and W_ab, W_mnij ladder
+    // per (a,b) | (i,j), each W_mbej ring sum per (a,i) | (b,j)) and the
+    // τ·<mn||ef> ladder of W_abef per (a,b) | (e,f). 0 computes everything.
+    void set_screening(double threshold) noexcept { screen_ = threshold; }
+    [[nodiscard]] double screening() const noexcept { return screen_; }
+    // The integral block norms the screened terms read (max_mn |<mn||ef>|
+    // per (e,f)). The integrals never change: call once, after
+    // build_spin_integrals and set_screening. No-op without screening.
+    void build_screening_norms();
+    // Accumulated over every screened call since construction or the last reset.
+    [[nodiscard]] const ScreeningStats& screening_stats() const noexcept { return stats_; }
+    void reset_screening_stats() noexcept { stats_ = {}; }
+
     // Compound index hash — public for unit testing.
     [[nodiscard]] static double get_key(double a, double b, double c, double d);
 
@@ -44,24 +113,70 @@ public:
 private:
     CcsdState& state_;
     const ParameterClass& p_;
+    SpinOrbitalSymmetry sym_;
+    bool singles_ = true;
+    double screen_ = 0.0;
+    ScreeningStats stats_;
+    std::vector<double> oovv_norm_;   // [e][f]: max_mn |<mn||ef>|, see build_screening_norms
+
+    // Block max norms the screened T2 terms compare against (one iteration).
+    struct T2Norms {
+        std::vector<double> tau_row;   // [i][j][e]: max_f |τ(e,f,i,j)|
+        std::vector<double> t2_ai;     // [a][i]:    max_{e,m} |t2(a,e,i,m)|, virtual offset a
+        std::vector<double> W_ij;      // [i][j]:    max_{m,n} |W_mnij(m,n,i,j)|
+        std::vector<double> W_xj;      // [x][j]:    max_{m,e} |W_mbej(m,x,e,j)|, virtual offset x
+    };
+    [[nodiscard]] T2Norms t2_norms(const std::vector<double>& tau_ij, const TensorView<4>& W_mnij,
+                                   const TensorView<4>& W_mbej) const;
+    std::vector<double> tau_ij_;      // prepare_t2_tiles: tau_planes() of the current amplitudes
+    T2Norms norms_;                   // prepare_t2_tiles, with screening
+    [[nodiscard]] double tau_pair_norm(int a, int b) const;   // max_{m,n} |τ(a,b,m,n)|
+    // Row-major (e,f) offset over the virtual block; also the slab layout.
+    [[nodiscard]] std::size_t vv(int e, int f) const noexcept {
+        const auto n_occ = static_cast<std::size_t>(p_.n_occupied);
+        const auto nv    = static_cast<std::size_t>(state_.n_spin_orbitals) - n_occ;
+        return (static_cast<std::size_t>(e) - n_occ) * nv + static_cast<std::size_t>(f) - n_occ;
+    }
+
+    [[nodiscard]] int irrep(int p) const noexcept { return sym_.label(p); }
+    [[nodiscard]] einsum::Spaces spaces() const noexcept {
+        return {p_.n_occupied, state_.n_spin_orbitals - p_.n_occupied, sym_.label_data()};
+    }
 
+    // Helpers taking `g` read <pq||rs> through the backend their kernel
+    // resolved once (CcsdState::with_integrals); defined in ccsd_kernels.cpp.
     [[nodiscard]] double get_value(double a, double b, double c, double d) const;
+    // The t1·<mb||ef> term of compute_W_mbej, m-slice by m-slice.
+    template <class G> void W_mbej_t1_ovvv(const G& g);
+    void W_abef_integrals_from_cholesky();
+    // `ladder` false drops the ¼ τ_mn^ab <mn||ef> sum (screened out).
+    template <class G>
+    [[nodiscard]] double W_abef_dressing(const G& g, int a, int b, int e, int f, bool ladder = true) const;
 
     // T2 amplitude term helpers (Stanton eq. 2)
-    [[nodiscard]] double t2_term_spinint(int a, int b, int i, int j) const;
+    template <class G> [[nodiscard]] double t2_term_spinint(const G& g, int a, int b, int i, int j) const;
     [[nodiscard]] double t2_terms_F_ae(int a, int b, int i, int j) const;
     [[nodiscard]] double t2_terms_F_mi(int a, int b, int i, int j) const;
-    [[nodiscard]] double t2_term_single_excitations(int a, int b, int i, int j) const;
-    [[nodiscard]] double t2_term_W_abef(int a, int b, int i, int j) const;
-    [[nodiscard]] double t2_term_single_dressing(int a, int b, int i, int j) const;
-    [[nodiscard]] double t2_terms_W_mbej(int a, int b, int i, int j) const;
-    [[nodiscard]] double t2_term_W_mnij(int a, int b, int i, int j) const;
+    template <class G> [[nodiscard]] double t2_term_single_excitations(const G& g, int a, int b, int i, int j) const;
+    // With `W_rows`/`tau_rows` (the e-row max norms of W_ab and tau_ij),
+    // rows whose product falls below the screening threshold are skipped.
+    [[nodiscard]] double t2_term_W_abef(int i, int j, const TensorView<2>& W_ab, const double* tau_ij,
+                                        const double* W_rows = nullptr, const double* tau_rows = nullptr,
+                                        ScreeningStats* stats = nullptr) const;
+    [[nodiscard]] std::vector<double> tau_planes() const;
+    template <class G> [[nodiscard]] double t2_term_single_dressing(const G& g, int a, int b, int i, int j) const;
+    // W_mbej / W_mnij indexed as in WSlices. Bit k of `keep` enables the
+    // k-th of the four T2·W_mbej sums.
+    template <class G>
+    [[nodiscard]] double t2_terms_W_mbej(const G& g, int a, int b, int i, int j, const TensorView<4>& W_mbej,
+                                         unsigned keep = 0xF) const;
+    [[nodiscard]] double t2_term_W_mnij(int a, int b, int i, int j, const TensorView<4>& W_mnij) const;
 
     // T1 amplitude term helpers (Stanton eq. 1)
     [[nodiscard]] double t1_term_F_ae(int a, int i) const;
     [[nodiscard]] double t1_term_F_mi(int a, int i) const;
-    [[nodiscard]] double t1_terms_doubles(int a, int i) const;
-    [[nodiscard]] double t1_term_spinint(int a, int i) const;
+    template <class G> [[nodiscard]] double t1_terms_doubles(const G& g, int a, int i) const;
+    template <class G> [[nodiscard]] double t1_term_spinint(const G& g, int a, int i) const;
 };
 
 }  // namespace ccsd
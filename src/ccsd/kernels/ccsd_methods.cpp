@@ -0,0 +1,149 @@
+#include <ccsd/kernels/ccsd_kernels.h>
+#include <ccsd/kernels/ccsd_omp.h>
+
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+//=============================================================================
+double ccsd::CcsdKernels::compute_mp3_energy() const {
+    const int n_virt = state_.n_spin_orbitals - p_.n_occupied;
+    std::vector<double> partial(static_cast<std::size_t>(n_virt), 0.0);
+    compute_mp3_partials(0, n_virt, partial);
+    return std::accumulate(partial.begin(), partial.end(), 0.0);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void ccsd::CcsdKernels::compute_mp3_partials(int v_begin, int v_end, std::vector<double>& partial) const { // E(3), spin-orbital form
+    // With t the first-order amplitudes:
+    //   E(3) = ⅛ Σ t_ij^ab <ab||ef> t_ij^ef + ⅛ Σ t_ij^ab <mn||ij> t_mn^ab
+    //        +   Σ t_ij^ab <mb||ej> t_im^ae
+    // i.e. ¼ Σ t_ij^ab times the linear CCD residual. All three terms are
+    // summed per virtual a, so the result does not depend on the thread
+    // count or on how the rows are split over ranks.
+    const int n_occ = p_.n_occupied;
+    const int n_so  = state_.n_spin_orbitals;
+    const auto& t   = state_.t2;
+
+    state_.with_integrals([&](const auto& g) {
+        CCSD_OMP_PARALLEL_FOR_DYNAMIC
+        for (int a = n_occ + v_begin; a < n_occ + v_end; ++a) {
+            double acc = 0.0;
+            for (int b = n_occ; b < n_so; ++b)                       // particle ladder
+                for (int e = n_occ; e < n_so; ++e)
+                    for (int f : sym_.vir(irrep(a) ^ irrep(b) ^ irrep(e))) {
+                        double tt = 0.0;
+                        for (int i = 0; i < n_occ; ++i)
+                            for (int j : sym_.occ(irrep(a) ^ irrep(b) ^ irrep(i)))
+                                tt += t(a,b,i,j)*t(e,f,i,j);
+                        if (tt != 0.0) acc += 0.125*tt*g(a,b,e,f);
+                    }
+            for (int b = n_occ; b < n_so; ++b)                       // ring
+                for (int e = n_occ; e < n_so; ++e)
+                    for (int m = 0; m < n_occ; ++m)
+                        for (int j : sym_.occ(irrep(m) ^ irrep(b) ^ irrep(e))) {
+                            double tt = 0.0;
+                            for (int i = 0; i < n_occ; ++i)
+                                tt += t(a,b,i,j)*t(a,e,i,m);
+                            if (tt != 0.0) acc += tt*g(m,b,e,j);
+                        }
+            for (int m = 0; m < n_occ; ++m)                          // hole ladder
+                for (int n = 0; n < n_occ; ++n)
+                    for (int i = 0; i < n_occ; ++i)
+                        for (int j : sym_.occ(irrep(m) ^ irrep(n) ^ irrep(i))) {
+                            double tt = 0.0;
+                            for (int b : sym_.vir(irrep(a) ^ irrep(i) ^ irrep(j)))
+                                tt += t(a,b,i,j)*t(a,b,m,n);
+                            if (tt != 0.0) acc += 0.125*tt*g(m,n,i,j);
+                        }
+            partial[static_cast<std::size_t>(a - n_occ)] = acc;
+        }
+    });
+}
+//=============================================================================
+
+//=============================================================================
+void ccsd::CcsdKernels::compute_t2_cc2() {
+    state_.t2_next.zeros();
+    const int n_virt = state_.n_spin_orbitals - p_.n_occupied;
+    compute_t2_cc2_tile(0, n_virt * n_virt);
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void ccsd::CcsdKernels::compute_t2_cc2_tile(int pair_begin, int pair_end) { // CC2 doubles (Christiansen, Koch, Jørgensen 1995)
+    // <ab||ij>~ = Σ L_ap L_bq <pq||rs> R_ir R_js with
+    //   L_aa = 1, L_am = -t_m^a      R_ii = 1, R_ie = t_i^e
+    // (the T1 similarity transform of the integrals), as four one-index
+    // transforms of O(n³ o v) and less: s→j, r→i, q→b, p→a. The last one
+    // reads only the rows p = a of the tile and p = m, so the first three
+    // run over those rows alone (local index lp).
+    if (pair_begin >= pair_end) return;
+    const int o  = p_.n_occupied;
+    const int n  = state_.n_spin_orbitals;
+    const int v  = n - o;
+    const int a_first = o + pair_begin / v, a_last = o + (pair_end - 1) / v;
+    std::vector<int> rows(static_cast<std::size_t>(o));
+    std::iota(rows.begin(), rows.end(), 0);
+    for (int a = a_first; a <= a_last; ++a) rows.push_back(a);
+    const auto lp_of_a = [&](int a) { return o + (a - a_first); };
+    const int n_rows = static_cast<int>(rows.size());
+
+    const auto N = static_cast<std::size_t>(n), O = static_cast<std::size_t>(o), V = static_cast<std::size_t>(v);
+    auto at = [](std::size_t i0, std::size_t n1, std::size_t i1, std::size_t n2, std::size_t i2, std::size_t n3, std::size_t i3) {
+        return ((i0 * n1 + i1) * n2 + i2) * n3 + i3;
+    };
+    auto u = [](int x) { return static_cast<std::size_t>(x); };
+
+    std::vector<double> J1(rows.size() * N * N * O);             // [lp][q][r][j]
+    state_.with_integrals([&](const auto& g) {
+        CCSD_OMP_PARALLEL_FOR
+        for (int lp = 0; lp < n_rows; ++lp) {
+            const int p = rows[u(lp)];
+            for (int q = 0; q < n; ++q)
+                for (int r = 0; r < n; ++r)
+                    for (int j = 0; j < o; ++j) {
+                        if (!sym_.allowed(p, q, r, j)) continue;
+                        double x = g(p,q,r,j);
+                        for (int f : sym_.vir(irrep(j))) x += state_.t1(f,j)*g(p,q,r,f);
+                        J1[at(u(lp), N, u(q), N, u(r), O, u(j))] = x;
+                    }
+        }
+    });
+
+    std::vector<double> J2(rows.size() * N * O * O);             // [lp][q][i][j]
+    CCSD_OMP_PARALLEL_FOR
+    for (int lp = 0; lp < n_rows; ++lp)
+        for (int q = 0; q < n; ++q)
+            for (int i = 0; i < o; ++i)
+                for (int j = 0; j < o; ++j) {
+                    double x = J1[at(u(lp), N, u(q), N, u(i), O, u(j))];
+                    for (int e : sym_.vir(irrep(i))) x += state_.t1(e,i)*J1[at(u(lp), N, u(q), N, u(e), O, u(j))];
+                    J2[at(u(lp), N, u(q), O, u(i), O, u(j))] = x;
+                }
+    J1 = {};
+
+    std::vector<double> J3(rows.size() * V * O * O);             // [lp][b][i][j]
+    CCSD_OMP_PARALLEL_FOR
+    for (int lp = 0; lp < n_rows; ++lp)
+        for (int b = o; b < n; ++b)
+            for (int i = 0; i < o; ++i)
+                for (int j = 0; j < o; ++j) {
+                    double x = J2[at(u(lp), N, u(b), O, u(i), O, u(j))];
+                    for (int m : sym_.occ(irrep(b))) x -= state_.t1(b,m)*J2[at(u(lp), N, u(m), O, u(i), O, u(j))];
+                    J3[at(u(lp), V, u(b - o), O, u(i), O, u(j))] = x;
+                }
+
+    CCSD_OMP_PARALLEL_FOR
+    for (int pair = pair_begin; pair < pair_end; ++pair) {
+        const int a = o + pair / v, b = o + pair % v;
+        for (int i = 0; i < o; ++i)
+            for (int j : sym_.occ(irrep(a) ^ irrep(b) ^ irrep(i))) {
+                double x = J3[at(u(lp_of_a(a)), V, u(b - o), O, u(i), O, u(j))];
+                for (int m : sym_.occ(irrep(a))) x -= state_.t1(a,m)*J3[at(u(m), V, u(b - o), O, u(i), O, u(j))];
+                state_.t2_next(a,b,i,j) = x / state_.denom_abij(a,b,i,j);
+            }
+    }
+}
+//=============================================================================
@@ -0,0 +1,36 @@
+#pragma once
+
+// OpenMP hooks for the kernel translation units; no-ops without CCSD_USE_OMP.
+#ifdef CCSD_USE_OMP
+  #include <omp.h>
+  #define CCSD_OMP_PARALLEL_FOR _Pragma("omp parallel for")
+  // Iterations handed out one at a time to whichever thread is free: for
+  // loops whose iterations vary in cost (symmetry-screened pairs).
+  #define CCSD_OMP_PARALLEL_FOR_DYNAMIC _Pragma("omp parallel for schedule(dynamic)")
+#else
+  #define CCSD_OMP_PARALLEL_FOR
+  #define CCSD_OMP_PARALLEL_FOR_DYNAMIC
+#endif
+
+namespace ccsd {
+
+// Threads a CCSD_OMP_PARALLEL_FOR region may use (1 without OpenMP).
+inline int omp_max_threads() {
+#ifdef CCSD_USE_OMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+// Thread count for later CCSD_OMP_PARALLEL_FOR regions; ignored without
+// OpenMP or when n <= 0.
+inline void set_omp_threads(int n) {
+#ifdef CCSD_USE_OMP
+    if (n > 0) omp_set_num_threads(n);
+#else
+    (void)n;
+#endif
+}
+
+}  // namespace ccsd
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace ccsd {
+
+// Work of the screened contractions (CcsdKernels::set_screening), counted
+// as the inner multiply-adds the unscreened loops would do: `total` over
+// every block visited, `skipped` over the blocks dropped by their bound.
+struct ScreeningStats {
+    double total   = 0.0;
+    double skipped = 0.0;
+
+    [[nodiscard]] double fraction() const noexcept { return total > 0.0 ? skipped / total : 0.0; }
+
+    ScreeningStats& operator+=(const ScreeningStats& o) noexcept {
+        total   += o.total;
+        skipped += o.skipped;
+        return *this;
+    }
+
+    // Counts one block of `work` multiply-adds; true if it is to be skipped.
+    bool skip(double bound, double threshold, double work) noexcept {
+        total += work;
+        if (bound >= threshold) return false;
+        skipped += work;
+        return true;
+    }
+};
+
+// max |x[k]| over [first, first + n).
+inline double max_abs(const double* first, std::size_t n) {
+    double m = 0.0;
+    for (std::size_t k = 0; k < n; ++k) m = std::max(m, std::abs(first[k]));
+    return m;
+}
+
+}  // namespace ccsd
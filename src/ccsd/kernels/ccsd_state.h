@@ -1,10 +1,49 @@
 #pragma once
 
+#include <ccsd/config/cholesky.h>
+#include <util/memory/memory_registry.h>
+#include <util/tensors/block_sparse_4d.h>
+#include <util/tensors/tensor_view.h>
 #include <util/tensors/vector_2d.h>
 #include <util/tensors/vector_4d.h>
 
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
 namespace ccsd {
 
+// The W intermediates one T2 tile reads, on a rank that does not store
+// them: compact copies fetched from their owner, indexed from the first
+// index each covers. W_mbej(m, b - o, e - o, j) has extents (o, v, v, o),
+// W_mnij(m, n, i, j) (o, o, o, o); W_abef holds the (e,f) plane of each
+// pair of the tile, in pair order, row-major (v x v). Null W_abef: the
+// planes come from this rank's <ab||ef> slabs instead (W_abef_from_slabs).
+struct WSlices {
+    TensorView<4> W_mbej;
+    TensorView<4> W_mnij;
+    const double* W_abef = nullptr;
+};
+
+// The two <pq||rs> backends as callables. A kernel picks one once, through
+// CcsdState::with_integrals, and its loops then inline the lookup instead
+// of testing for Cholesky vectors on every element.
+struct DenseIntegrals {
+    const BlockSparse4D& g;
+    [[nodiscard]] double operator()(int p, int q, int r, int s) const { return g(p, q, r, s); }
+};
+
+// <pq||rs> assembled from two spatial (pq|rs) dot products of length N_Q.
+struct CholeskyIntegrals {
+    const CholeskyVectors& c;
+    [[nodiscard]] double operator()(int p, int q, int r, int s) const {
+        double v = 0.0;
+        if (p % 2 == r % 2 && q % 2 == s % 2) v += c.eri(p / 2, r / 2, q / 2, s / 2);
+        if (p % 2 == s % 2 && q % 2 == r % 2) v -= c.eri(p / 2, s / 2, q / 2, r / 2);
+        return v;
+    }
+};
+
 // All tensor data for a CCSD calculation.
 // Tensor::rank fields store the MPI owner for each intermediate — set by MpiOrchestrator.
 struct CcsdState {
@@ -15,18 +54,97 @@ struct CcsdState {
     Vector2D denom_ai;                                  // Energy denominator, singles
     Vector4D denom_abij;                                // Energy denominator, doubles
     Vector2D fock_spin;                                 // Spin-basis Fock diagonal
-    Vector4D spin_integrals;                            // <pq||rs> in spin-orbital basis
+    BlockSparse4D spin_integrals;                       // <pq||rs>, symmetry-allowed blocks only
     int n_spin_orbitals = 0;
+    CholeskyVectors cholesky;                           // set before allocate(): replaces spin_integrals
+    bool W_abef_from_slabs = false;                     // set before allocate(): W_abef is never stored
+    bool W_remote = false;                              // set before allocate(): another rank owns every W
+    memory::MemoryRegistry memory;                      // bytes per tensor on this rank
+
+    // fn(g) with g the integral backend in use: DenseIntegrals over
+    // spin_integrals, or CholeskyIntegrals with Cholesky vectors set.
+    template <class Fn>
+    decltype(auto) with_integrals(Fn&& fn) const {
+        if (cholesky.empty()) return fn(DenseIntegrals{spin_integrals});
+        return fn(CholeskyIntegrals{cholesky});
+    }
 
-    void allocate(int n) {
+    // One <pq||rs> through with_integrals; kernels resolve the backend once
+    // per call instead.
+    [[nodiscard]] double integral(int p, int q, int r, int s) const {
+        return with_integrals([&](const auto& g) { return g(p, q, r, s); });
+    }
+
+    // Calls fn(name, tensor) for every tensor above.
+    template <class Fn>
+    void for_each_tensor(Fn&& fn) {
+        fn("F_ae", F_ae);      fn("F_mi", F_mi);      fn("F_me", F_me);
+        fn("W_mnij", W_mnij);  fn("W_abef", W_abef);  fn("W_mbej", W_mbej);
+        fn("t1", t1);          fn("t1_next", t1_next);
+        fn("t2", t2);          fn("t2_next", t2_next);
+        fn("denom_ai", denom_ai);  fn("denom_abij", denom_abij);
+        fn("fock_spin", fock_spin);
+        fn("spin_integrals", spin_integrals);
+    }
+
+    // Set before allocate(). Row-major by default whatever the build-wide
+    // layout: the T2 kernel and the RMA tile fetch both read whole (e,f)
+    // planes of one (a,b), which this makes contiguous. Both read through
+    // strides, so any layout is correct (the autotuner tries the standard one).
+    Layout<4> W_abef_layout = Layout<4>::row_major();
+
+    // `labels`: symmetry label of each spin orbital (SpinOrbitalSymmetry::
+    // labels); empty stores spin_integrals densely. With Cholesky vectors
+    // set, spin_integrals stays empty and the vectors are recorded instead;
+    // with W_abef_from_slabs, W_abef stays empty (each rank rebuilds the
+    // planes of its T2 tile from <ab||ef> slabs, streamed from scratch or
+    // held in memory, see CcsdKernels::compute_t2_tile); with
+    // W_remote no W intermediate is stored (the T2 tiles read the slices
+    // they need, fetched from the owner, through WSlices).
+    void allocate(int n, const std::vector<int>& labels = {}) {
         n_spin_orbitals = n;
-        F_ae.initialization(n);  F_mi.initialization(n);  F_me.initialization(n);
-        W_mnij.initialization(n); W_abef.initialization(n); W_mbej.initialization(n);
-        t1.initialization(n);    t1_next.initialization(n);
-        t2.initialization(n);    t2_next.initialization(n);
-        denom_ai.initialization(n);  denom_abij.initialization(n);
-        fock_spin.initialization(n);
-        spin_integrals.initialization(n);
+        memory.clear();
+        for_each_tensor([&](const char* name, auto& t) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(t)>, BlockSparse4D>) {
+                if (cholesky.empty()) t.initialization(n, labels);
+                else                  t = BlockSparse4D{};
+            } else if constexpr (std::is_same_v<std::decay_t<decltype(t)>, Vector4D>) {
+                const bool is_W = &t == &W_mnij || &t == &W_abef || &t == &W_mbej;
+                if (is_W && W_remote)         t = Vector4D{};
+                else if (&t != &W_abef)       t.initialization(n);
+                else if (W_abef_from_slabs)  t = Vector4D{};
+                else                          t.initialization(n, W_abef_layout);
+            } else {
+                t.initialization(n);
+            }
+            memory.record(name, t.n_size() * sizeof(double));
+        });
+        if (!cholesky.empty()) memory.record("cholesky", cholesky.bytes());
+    }
+
+    // Doubles CcsdKernels holds while it runs, beyond the tensors above:
+    // the τ planes the T2 tiles share for an iteration, and compute_W_mbej's
+    // integral blocks with one <mb||ef> m-slice and its product with t1.
+    [[nodiscard]] static std::size_t tau_planes_size(std::size_t o, std::size_t v) { return o * o * v * v; }
+    [[nodiscard]] static std::size_t W_mbej_scratch(std::size_t o, std::size_t v) {
+        return 2 * o * o * v * v + o * o * o * v + v * v * v + v * v * o + v * o;
+    }
+
+    // What allocate(n, labels) and the kernels would record, for `n_occ`
+    // occupied spin orbitals, without allocating anything.
+    [[nodiscard]] static memory::MemoryRegistry plan(int n, int n_occ, const std::vector<int>& labels = {}) {
+        CcsdState empty;
+        memory::MemoryRegistry r;
+        empty.for_each_tensor([&](const char* name, auto& t) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(t)>, BlockSparse4D>)
+                r.record(name, t.elements_for(n, labels) * sizeof(double));
+            else
+                r.record(name, t.elements_for(n) * sizeof(double));
+        });
+        const auto o = static_cast<std::size_t>(n_occ), v = static_cast<std::size_t>(n - n_occ);
+        r.record("tau planes", tau_planes_size(o, v) * sizeof(double));
+        r.record("W_mbej scratch", W_mbej_scratch(o, v) * sizeof(double));
+        return r;
     }
 };
 
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+namespace ccsd {
+
+// Direct-product decomposition (Stanton, Gauss, Watts & Bartlett 1991) for
+// Abelian point groups. Each spin orbital p carries the label
+//   ((orbsym[p/2] - 1) << 1) | (p % 2)
+// i.e. its spatial irrep and its spin as one element of an XOR group, so a
+// tensor element <pq||rs>, t2(a,b,i,j), W(...) can be nonzero only when the
+// XOR of its four labels is 0, and t1(a,i), F(p,q) only when the two labels
+// match. Spin alone already halves the blocks for C1 molecules.
+//
+// occ(g) / vir(g) list the occupied / virtual spin orbitals with label g in
+// ascending order, so kernels can run their summation indices over exactly
+// the orbitals that the other indices leave symmetry-allowed.
+class SpinOrbitalSymmetry {
+public:
+    SpinOrbitalSymmetry() = default;
+
+    // `orbsym`: 1-based spatial irreps (empty = C1); n_spin = 2 * its size.
+    SpinOrbitalSymmetry(const std::vector<int>& orbsym, int n_spin, int n_occ)
+        : label_(labels(orbsym, n_spin)) {
+        const int max_label = label_.empty() ? 0 : *std::max_element(label_.begin(), label_.end());
+        n_labels_ = static_cast<int>(std::bit_ceil(static_cast<unsigned>(max_label) + 1u));
+        occ_.resize(static_cast<std::size_t>(n_labels_));
+        vir_.resize(static_cast<std::size_t>(n_labels_));
+        for (int p = 0; p < n_spin; ++p)
+            (p < n_occ ? occ_ : vir_)[static_cast<std::size_t>(label(p))].push_back(p);
+    }
+
+    // Label of every spin orbital, as stored by BlockSparse4D.
+    [[nodiscard]] static std::vector<int> labels(const std::vector<int>& orbsym, int n_spin) {
+        std::vector<int> l(static_cast<std::size_t>(n_spin));
+        for (std::size_t p = 0; p < l.size(); ++p) {
+            const int irrep = orbsym.empty() ? 0 : orbsym[p / 2] - 1;
+            l[p] = (irrep << 1) | static_cast<int>(p % 2);
+        }
+        return l;
+    }
+
+    [[nodiscard]] int n_labels() const noexcept { return n_labels_; }
+    [[nodiscard]] int label(int p) const noexcept { return label_[static_cast<std::size_t>(p)]; }
+    // label(p) for every p, contiguous (einsum::Spaces::labels).
+    [[nodiscard]] const int* label_data() const noexcept { return label_.data(); }
+    [[nodiscard]] const std::vector<int>& occ(int g) const { return occ_[static_cast<std::size_t>(g)]; }
+    [[nodiscard]] const std::vector<int>& vir(int g) const { return vir_[static_cast<std::size_t>(g)]; }
+
+    [[nodiscard]] bool allowed(int p, int q) const noexcept { return label(p) == label(q); }
+    [[nodiscard]] bool allowed(int p, int q, int r, int s) const noexcept {
+        return (label(p) ^ label(q) ^ label(r) ^ label(s)) == 0;
+    }
+
+private:
+    std::vector<int> label_;
+    int n_labels_ = 1;
+    std::vector<std::vector<int>> occ_, vir_;
+};
+
+}  // namespace ccsd
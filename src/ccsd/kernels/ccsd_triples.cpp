@@ -0,0 +1,176 @@
+#include <ccsd/kernels/ccsd_triples.h>
+#include <ccsd/kernels/ccsd_omp.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+inline std::size_t sz(int x) { return static_cast<std::size_t>(x); }
+
+}  // namespace
+
+//=============================================================================
+ccsd::TriplesKernels::TriplesKernels(const CcsdState& state, const ParameterClass& p)
+    : o_(p.n_occupied), v_(state.n_spin_orbitals - p.n_occupied),
+      sym_(p.orbital_symmetry, state.n_spin_orbitals, p.n_occupied) {
+    const int o = o_, v = v_;
+    for (int i = 0; i < o; ++i)
+        for (int j = i + 1; j < o; ++j)
+            for (int k = j + 1; k < o; ++k)
+                triples_.push_back({i, j, k});
+    if (triples_.empty() || v < 3) {
+        triples_.clear();   // no a<b<c: every triple contributes zero
+        return;
+    }
+
+    const auto& t2 = state.t2;
+    I_.resize(sz(o) * sz(v) * sz(v) * sz(v));
+    N_.resize(sz(o) * sz(o) * sz(v) * sz(v));
+    T_.resize(sz(o) * sz(o) * sz(v) * sz(v));
+    M_.resize(sz(o) * sz(o) * sz(v) * sz(o));
+    G_.resize(sz(o) * sz(o) * sz(v) * sz(v));
+    t1_.resize(sz(o) * sz(v));
+    fo_.resize(sz(o));
+    fv_.resize(sz(v));
+
+    state.with_integrals([&](const auto& g) {
+        std::size_t n = 0;
+        for (int pp = 0; pp < o; ++pp)
+            for (int e = 0; e < v; ++e)
+                for (int b = 0; b < v; ++b)
+                    for (int c = 0; c < v; ++c)
+                        I_[n++] = g(o + e, pp, o + b, o + c);
+        n = 0;
+        for (int pp = 0; pp < o; ++pp)
+            for (int m = 0; m < o; ++m)
+                for (int b = 0; b < v; ++b)
+                    for (int c = 0; c < v; ++c)
+                        N_[n++] = t2(o + b, o + c, pp, m);
+        n = 0;
+        for (int q = 0; q < o; ++q)
+            for (int r = 0; r < o; ++r)
+                for (int a = 0; a < v; ++a)
+                    for (int e = 0; e < v; ++e)
+                        T_[n++] = t2(o + a, o + e, q, r);
+        n = 0;
+        for (int q = 0; q < o; ++q)
+            for (int r = 0; r < o; ++r)
+                for (int a = 0; a < v; ++a)
+                    for (int m = 0; m < o; ++m)
+                        M_[n++] = g(m, o + a, q, r);
+        n = 0;
+        for (int j = 0; j < o; ++j)
+            for (int k = 0; k < o; ++k)
+                for (int b = 0; b < v; ++b)
+                    for (int c = 0; c < v; ++c)
+                        G_[n++] = g(j, k, o + b, o + c);
+    });
+    for (int i = 0; i < o; ++i)
+        for (int a = 0; a < v; ++a)
+            t1_[sz(i) * sz(v) + sz(a)] = state.t1(o + a, i);
+    for (int i = 0; i < o; ++i) fo_[sz(i)] = state.fock_spin(i, i);
+    for (int a = 0; a < v; ++a) fv_[sz(a)] = state.fock_spin(o + a, o + a);
+}
+//=============================================================================
+
+//=============================================================================
+// y[a][b][c] += sign * ( Σ_e t2(a,e,q,r) <e p||b c> - Σ_m <m a||q r> t2(b,c,p,m) ),
+// the raw connected term for one (p,q,r) ordering before P(a/bc). Both
+// t2(a,e,q,r) and <m a||q r> vanish unless e / m carry label a^q^r.
+void ccsd::TriplesKernels::add_connected(int p, int q, int r, double sign,
+                                         std::vector<double>& y) const {
+    const std::size_t v = sz(v_), o = sz(o_), vv = v * v;
+    const double* I  = I_.data() + sz(p) * v * vv;
+    const double* N  = N_.data() + sz(p) * o * vv;
+    const double* T  = T_.data() + (sz(q) * o + sz(r)) * vv;
+    const double* M  = M_.data() + (sz(q) * o + sz(r)) * v * o;
+    const int g_qr = sym_.label(q) ^ sym_.label(r);
+    for (std::size_t a = 0; a < v; ++a) {
+        double* ya = y.data() + a * vv;
+        const int g = sym_.label(o_ + static_cast<int>(a)) ^ g_qr;
+        for (const int eg : sym_.vir(g)) {
+            const std::size_t e = sz(eg - o_);
+            const double s  = sign * T[a * v + e];
+            const double* x = I + e * vv;
+            for (std::size_t bc = 0; bc < vv; ++bc) ya[bc] += s * x[bc];
+        }
+        for (const int mg : sym_.occ(g)) {
+            const std::size_t m = sz(mg);
+            const double s  = -sign * M[a * o + m];
+            const double* x = N + m * vv;
+            for (std::size_t bc = 0; bc < vv; ++bc) ya[bc] += s * x[bc];
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+double ccsd::TriplesKernels::triple_energy(int t, std::vector<double>& y) const {
+    const auto [i, j, k] = triple(t);
+    const std::size_t v = sz(v_), o = sz(o_), vv = v * v;
+
+    // P(i/jk) on the connected term: (ijk) - (jik) - (kji).
+    std::fill(y.begin(), y.end(), 0.0);
+    add_connected(i, j, k,  1.0, y);
+    add_connected(j, i, k, -1.0, y);
+    add_connected(k, j, i, -1.0, y);
+
+    const double* t1i = t1_.data() + sz(i) * v;
+    const double* t1j = t1_.data() + sz(j) * v;
+    const double* t1k = t1_.data() + sz(k) * v;
+    const double* Gjk = G_.data() + (sz(j) * o + sz(k)) * vv;
+    const double* Gik = G_.data() + (sz(i) * o + sz(k)) * vv;
+    const double* Gji = G_.data() + (sz(j) * o + sz(i)) * vv;
+    const double f_ijk = fo_[sz(i)] + fo_[sz(j)] + fo_[sz(k)];
+    const int g_ijk = sym_.label(i) ^ sym_.label(j) ^ sym_.label(k);
+
+    // Every term vanishes unless label(c) = label(i^j^k^a^b).
+    double e = 0.0;
+    for (std::size_t a = 0; a < v; ++a) {
+        for (std::size_t b = a + 1; b < v; ++b) {
+            const auto& cs = sym_.vir(g_ijk ^ sym_.label(o_ + static_cast<int>(a)) ^ sym_.label(o_ + static_cast<int>(b)));
+            for (auto it = std::upper_bound(cs.begin(), cs.end(), o_ + static_cast<int>(b)); it != cs.end(); ++it) {
+                const std::size_t c = sz(*it - o_);
+                // P(a/bc) on the connected term: (abc) - (bac) - (cba).
+                const double w = y[a * vv + b * v + c] - y[b * vv + a * v + c] - y[c * vv + b * v + a];
+                // Disconnected: P(i/jk) P(a/bc) t1(a,i) <jk||bc>.
+                auto d = [&](const double* t1x, const double* G) {
+                    return t1x[a] * G[b * v + c] - t1x[b] * G[a * v + c] - t1x[c] * G[b * v + a];
+                };
+                const double dv = d(t1i, Gjk) - d(t1j, Gik) - d(t1k, Gji);
+                const double denom = f_ijk - fv_[a] - fv_[b] - fv_[c];
+                e += w * (w + dv) / denom;
+            }
+        }
+    }
+    return e;
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void ccsd::TriplesKernels::compute_tile(int t_begin, int t_end, double* e) const {
+    const int n = std::max(t_end - t_begin, 0);
+    if (n == 0) return;
+    const int workers = std::min(omp_max_threads(), n);
+    const std::size_t v = sz(v_);
+    // Workers take triples one at a time from a shared index: the e, m and c
+    // ranges depend on the triple's labels, so a fixed split would idle.
+    std::atomic<int> next{t_begin};
+    CCSD_OMP_PARALLEL_FOR
+    for (int w = 0; w < workers; ++w) {
+        std::vector<double> y(v * v * v);   // per-worker v³ buffer, reused per triple
+        for (int t = next++; t < t_end; t = next++) e[t - t_begin] = triple_energy(t, y);
+    }
+}
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+double ccsd::TriplesKernels::compute_energy() const {
+    std::vector<double> e(sz(n_triples()));
+    compute_tile(0, n_triples(), e.data());
+    double sum = 0.0;
+    for (double x : e) sum += x;
+    return sum;
+}
+//=============================================================================
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <ccsd/kernels/ccsd_state.h>
+#include <ccsd/kernels/ccsd_symmetry.h>
+#include <ccsd/config/ccsd_config.h>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace ccsd {
+
+// Perturbative triples correction E[(T)] on converged CCSD amplitudes
+// (Crawford & Schaefer 2000, spin-orbital form):
+//   D t(c) = P(i/jk) P(a/bc) [ Σ_e t_jk^ae <ei||bc> - Σ_m t_im^bc <ma||jk> ]
+//   D t(d) = P(i/jk) P(a/bc) t_i^a <jk||bc>
+//   E[(T)] = Σ_{i<j<k} Σ_{a<b<c} t(c) D (t(c) + t(d))
+//
+// The constructor packs the integral and amplitude slices the kernel reads
+// into contiguous v-major panels, so the O(o³v⁴) work per triple runs as
+// unit-stride axpys over (b,c). The e and m sums and the c loop run only
+// over the orbitals whose labels the other indices leave symmetry-allowed
+// (SpinOrbitalSymmetry), so the work per triple depends on its labels.
+// Pure math, no MPI: callers split the triple index [0, n_triples())
+// across ranks with compute_tile.
+class TriplesKernels {
+public:
+    TriplesKernels(const CcsdState& state, const ParameterClass& p);
+
+    // Number of i<j<k occupied triples; triple t maps to triple(t).
+    [[nodiscard]] int n_triples() const noexcept { return static_cast<int>(triples_.size()); }
+    [[nodiscard]] const std::array<int, 3>& triple(int t) const {
+        return triples_[static_cast<std::size_t>(t)];
+    }
+
+    // Energy of each triple in [t_begin, t_end) into e[t - t_begin].
+    // Threads take triples one at a time, one v³ workspace per thread.
+    void compute_tile(int t_begin, int t_end, double* e) const;
+
+    // Σ over all triples, summed in triple order (thread-count independent).
+    [[nodiscard]] double compute_energy() const;
+
+private:
+    int o_ = 0;
+    int v_ = 0;
+    std::vector<std::array<int, 3>> triples_;
+    SpinOrbitalSymmetry sym_;
+
+    // Packed panels (occupied indices 0..o-1, virtual indices 0..v-1):
+    std::vector<double> I_;    // [p][e][b][c] = <e p||b c>
+    std::vector<double> N_;    // [p][m][b][c] = t2(b,c,p,m)
+    std::vector<double> T_;    // [q][r][a][e] = t2(a,e,q,r)
+    std::vector<double> M_;    // [q][r][a][m] = <m a||q r>
+    std::vector<double> G_;    // [j][k][b][c] = <j k||b c>
+    std::vector<double> t1_;   // [i][a]       = t1(a,i)
+    std::vector<double> fo_, fv_;   // Fock diagonal, occupied / virtual
+
+    [[nodiscard]] double triple_energy(int t, std::vector<double>& y) const;
+    void add_connected(int p, int q, int r, double sign, std::vector<double>& y) const;
+};
+
+}  // namespace ccsd
@@ -0,0 +1,550 @@
+#pragma once
+
+#include <ccsd/kernels/ccsd_gemm.h>
+#include <ccsd/kernels/ccsd_omp.h>
+#include <util/tensors/layout.h>
+#include <util/tensors/tensor_view.h>
+#include <util/tensors/transpose.h>
+#include <util/tensors/vector_2d.h>
+#include <util/tensors/vector_4d.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Index-notation contractions for the CCSD intermediates, written the way
+// Stanton writes them:
+//
+//   W(m,b,e,j) += -0.5 * t2(f,b,j,n) * I(m,n,e,f);
+//
+// Labels carry their index space in the type (a–h virtual, i–n occupied), so
+// a malformed expression — a label that is neither summed over exactly once
+// nor free in the target, or a label in the wrong space — fails to compile.
+// A two-operand term is lowered to one GEMM between the operands packed as
+// [free | summed] and [summed | free]; a three-operand term first contracts
+// whichever pair is cheapest for the actual o / v (see plan()), so the
+// t1·t1·<..||..> terms never build the O(o²v²) outer product when v > o.
+//
+// With symmetry labels in Spaces, every operand is taken to be totally
+// symmetric (an element vanishes unless the XOR of its indices' labels is
+// 0): blocks are filled only where allowed, and each GEMM is split into one
+// per label of the contracted indices, skipping the forbidden blocks
+// (Stanton, Gauss, Watts & Bartlett 1991). Packing, GEMMs and scatters are
+// threaded.
+namespace ccsd::einsum {
+
+enum class Space { occ, vir };
+
+// Stanton's convention; any other letter is a compile error.
+constexpr Space space_of(char c) {
+    if (c >= 'a' && c <= 'h') return Space::vir;
+    if (c >= 'i' && c <= 'n') return Space::occ;
+    throw "einsum labels are a-h (virtual) or i-n (occupied)";
+}
+
+template <char C>
+struct Index {
+    static constexpr char label = C;
+    static constexpr Space space = space_of(C);
+};
+
+namespace labels {
+inline constexpr Index<'a'> a;  inline constexpr Index<'b'> b;  inline constexpr Index<'c'> c;
+inline constexpr Index<'d'> d;  inline constexpr Index<'e'> e;  inline constexpr Index<'f'> f;
+inline constexpr Index<'g'> g;  inline constexpr Index<'h'> h;
+inline constexpr Index<'i'> i;  inline constexpr Index<'j'> j;  inline constexpr Index<'k'> k;
+inline constexpr Index<'l'> l;  inline constexpr Index<'m'> m;  inline constexpr Index<'n'> n;
+}  // namespace labels
+
+// Spin-orbital ranges of the two spaces: occupied [0, n_occ), virtual
+// after. `labels`: symmetry label of each spin orbital (SpinOrbitalSymmetry),
+// or null to treat every element as allowed.
+struct Spaces {
+    int n_occ = 0;
+    int n_vir = 0;
+    const int* labels = nullptr;
+
+    [[nodiscard]] constexpr int first(Space s) const noexcept { return s == Space::occ ? 0 : n_occ; }
+    [[nodiscard]] constexpr int size(Space s) const noexcept { return s == Space::occ ? n_occ : n_vir; }
+    // Label of position x (from 0) within space s.
+    [[nodiscard]] constexpr int label(Space s, int x) const noexcept { return labels ? labels[first(s) + x] : 0; }
+};
+
+// A tensor slice named by labels; `view` spans exactly the labelled spaces,
+// indexed from 0 within each.
+template <char... L>
+struct Operand {
+    static constexpr std::array<char, sizeof...(L)> labels{L...};
+    TensorView<sizeof...(L)> view;
+    Spaces spaces;
+};
+
+// scale · op₁ · op₂ · …, built by the operators below.
+template <class... Ops>
+struct Term {
+    double scale = 1.0;
+    std::tuple<Ops...> ops;
+};
+
+// A writable slice: the left-hand side of +=. `data` is view.data, mutable.
+template <char... L>
+struct Target : Operand<L...> {
+    double* data = nullptr;
+
+    template <class... Ops> Target& operator+=(const Term<Ops...>& t);
+    template <char... R> Target& operator+=(const Operand<R...>& x);
+};
+
+template <char... L>
+Term<Operand<L...>> operator*(double s, const Operand<L...>& x) { return {s, {x}}; }
+template <char... L>
+Term<Operand<L...>> operator-(const Operand<L...>& x) { return {-1.0, {x}}; }
+template <char... L, char... R>
+Term<Operand<L...>, Operand<R...>> operator*(const Operand<L...>& x, const Operand<R...>& y) { return {1.0, {x, y}}; }
+template <class... Ops, char... R>
+Term<Ops..., Operand<R...>> operator*(const Term<Ops...>& t, const Operand<R...>& y) {
+    return {t.scale, std::tuple_cat(t.ops, std::tuple<Operand<R...>>{y})};
+}
+template <class... Ops>
+Term<Ops...> operator*(double s, const Term<Ops...>& t) { return {s * t.scale, t.ops}; }
+template <class... Ops>
+Term<Ops...> operator-(const Term<Ops...>& t) { return {-t.scale, t.ops}; }
+
+// Labels a Vector2D / Vector4D: t(a,i) is the virtual × occupied block of t.
+// Writable (Target) unless T is const.
+template <class T>
+class Tensor {
+public:
+    static constexpr std::size_t rank = std::is_same_v<std::remove_const_t<T>, Vector4D> ? 4 : 2;
+
+    Tensor(T& t, Spaces s) : t_(&t), s_(s) {}
+
+    template <char... L>
+    auto operator()(Index<L>...) const {
+        static_assert(sizeof...(L) == rank, "one label per dimension");
+        const TensorView<rank> whole = t_->view();
+        const TensorView<rank> v = whole.sub({s_.first(Index<L>::space)...}, {s_.size(Index<L>::space)...});
+        if constexpr (std::is_const_v<T>) {
+            return Operand<L...>{v, s_};
+        } else {
+            Target<L...> out;
+            out.view = v;
+            out.spaces = s_;
+            out.data = t_->raw() + (v.data - whole.data);
+            return out;
+        }
+    }
+
+private:
+    T* t_;
+    Spaces s_;
+};
+
+template <class T>
+Tensor<T> tensor(T& t, Spaces s) { return {t, s}; }
+
+// Dense row-major block over fixed spaces, filled once from fn(p, q, …) of
+// global spin-orbital indices: integrals or tau, which the kernels otherwise
+// evaluate element by element. fn is called only for symmetry-allowed
+// elements; the rest stay zero. Labels used with it must match its spaces.
+template <Space... S>
+class Block {
+public:
+    static constexpr std::size_t rank = sizeof...(S);
+
+    template <class Fn>
+    Block(Spaces sp, const Fn& fn) : extents_{sp.size(S)...}, spaces_(sp) {
+        const std::array<int, rank> first{sp.first(S)...};
+        std::ptrdiff_t n = 1;
+        for (int e : extents_) n *= e;
+        data_.assign(static_cast<std::size_t>(n), 0.0);
+        CCSD_OMP_PARALLEL_FOR
+        for (std::ptrdiff_t flat = 0; flat < n; ++flat) {
+            std::array<int, rank> p{};
+            std::ptrdiff_t rest = flat;
+            int label = 0;
+            for (std::size_t d = rank; d-- > 0;) {
+                p[d] = first[d] + static_cast<int>(rest % extents_[d]);
+                rest /= extents_[d];
+                if (sp.labels) label ^= sp.labels[p[d]];
+            }
+            if (label == 0) data_[static_cast<std::size_t>(flat)] = std::apply(fn, p);
+        }
+    }
+
+    template <char... L>
+    [[nodiscard]] Operand<L...> operator()(Index<L>...) const {
+        static_assert(sizeof...(L) == rank, "one label per dimension");
+        static_assert(((Index<L>::space == S) && ...), "label space differs from the block's");
+        return {TensorView<rank>::row_major(data_.data(), extents_), spaces_};
+    }
+
+private:
+    std::array<int, rank> extents_;
+    Spaces spaces_;
+    std::vector<double> data_;
+};
+
+template <class Fn, char... L>
+Block<Index<L>::space...> block(Spaces sp, const Fn& fn, Index<L>...) { return {sp, fn}; }
+
+// Which operands of a term are contracted first, and the flop count of the
+// whole term in that order (2 per multiply-add).
+struct Plan {
+    int first = 0;
+    int second = 0;
+    double flops = 0.0;
+};
+
+namespace detail {
+
+template <std::size_t N>
+constexpr int find(char c, const std::array<char, N>& l) {
+    for (std::size_t d = 0; d < N; ++d)
+        if (l[d] == c) return static_cast<int>(d);
+    return -1;
+}
+
+template <std::size_t N>
+constexpr int count(char c, const std::array<char, N>& l) {
+    int k = 0;
+    for (char x : l) k += (x == c);
+    return k;
+}
+
+// Every target label once in the target and once among the operands; every
+// other label exactly twice among the operands, in two different ones.
+template <class Out, class... Ops>
+consteval bool well_formed() {
+    bool ok = true;
+    for (char c : Out::labels)
+        ok = ok && count(c, Out::labels) == 1 && (count(c, Ops::labels) + ...) == 1;
+    const auto check = [&](const auto& labels) {
+        for (char c : labels) {
+            const int uses = (count(c, Ops::labels) + ...);
+            ok = ok && count(c, labels) == 1 && uses == (find(c, Out::labels) >= 0 ? 1 : 2);
+        }
+    };
+    (check(Ops::labels), ...);
+    return ok;
+}
+
+// Labels of X·Y's result: those in exactly one of the two, X's first.
+template <class X, class Y>
+consteval auto pair_labels() {
+    constexpr std::size_t n = [] {
+        std::size_t k = 0;
+        for (char c : X::labels) k += (find(c, Y::labels) < 0);
+        for (char c : Y::labels) k += (find(c, X::labels) < 0);
+        return k;
+    }();
+    std::array<char, n> r{};
+    std::size_t k = 0;
+    for (char c : X::labels) if (find(c, Y::labels) < 0) r[k++] = c;
+    for (char c : Y::labels) if (find(c, X::labels) < 0) r[k++] = c;
+    return r;
+}
+
+template <class... Ops>
+int extent(char c, const Ops&... ops) {
+    int e = 0;
+    const auto look = [&](const auto& x) {
+        const int d = find(c, x.labels);
+        if (d >= 0) e = x.view.extents[static_cast<std::size_t>(d)];
+    };
+    (look(ops), ...);
+    return e;
+}
+
+// ccsd::transpose / transpose_add with the source cut into slabs along its
+// longest dimension, one per iteration of a threaded loop; the slabs write
+// disjoint parts of dst.
+template <std::size_t R, class Put>
+void parallel_transpose(const TensorView<R>& src, double* dst, const std::array<std::ptrdiff_t, R>& dst_strides,
+                        const Put& put) {
+    std::size_t w = 0;
+    for (std::size_t d = 1; d < R; ++d)
+        if (src.extents[d] > src.extents[w]) w = d;
+    const int slabs = src.extents[w];
+    CCSD_OMP_PARALLEL_FOR
+    for (int x = 0; x < slabs; ++x) {
+        std::array<int, R> lo{}, hi = src.extents;
+        lo[w] = x;
+        hi[w] = x + 1;
+        ccsd::detail::transpose_box(src, dst, dst_strides, lo, hi, put);
+    }
+}
+
+template <std::size_t R>
+std::size_t volume(const TensorView<R>& v) {
+    std::size_t n = 1;
+    for (int e : v.extents) n *= static_cast<std::size_t>(e);
+    return n;
+}
+
+// `src` repacked densely in `layout`.
+template <std::size_t R>
+std::vector<double> pack(const TensorView<R>& src, const Layout<R>& layout) {
+    std::vector<double> out(volume(src));
+    parallel_transpose(src, out.data(), layout.strides(src.extents), [](double& t, double s) { t = s; });
+    return out;
+}
+
+// dst += alpha · src, dst strided.
+template <std::size_t R>
+void scatter_add(const TensorView<R>& src, double alpha, double* dst, const std::array<std::ptrdiff_t, R>& dst_strides) {
+    parallel_transpose(src, dst, dst_strides, [alpha](double& t, double s) { t += alpha * s; });
+}
+
+// Symmetry label of each row-major position of dimensions order[from, to)
+// of a view labelled `l` (the XOR of the labels of its indices).
+template <std::size_t R>
+std::vector<int> composite_labels(const TensorView<R>& v, const std::array<char, R>& l, const Layout<R>& order,
+                                  std::size_t from, std::size_t to, const Spaces& sp) {
+    std::vector<int> out{0};
+    for (std::size_t x = from; x < to; ++x) {
+        const auto d = static_cast<std::size_t>(order.order[x]);
+        const Space s = space_of(l[d]);
+        std::vector<int> next;
+        next.reserve(out.size() * static_cast<std::size_t>(v.extents[d]));
+        for (int g : out)
+            for (int i = 0; i < v.extents[d]; ++i) next.push_back(g ^ sp.label(s, i));
+        out.swap(next);
+    }
+    return out;
+}
+
+// c[m x n] += alpha · a[m x k] · b[k x n] (dense, row-major) for totally
+// symmetric a and b: a(r, q) vanishes unless rows[r] == sums[q], and
+// b(q, c) unless sums[q] == cols[c], so each label g is one smaller GEMM
+// over the rows, summed indices and columns that carry it.
+inline void symmetric_gemm(const std::vector<int>& rows, const std::vector<int>& sums, const std::vector<int>& cols,
+                           double alpha, const double* a, const double* b, double* c) {
+    const std::size_t m = rows.size(), k = sums.size(), n = cols.size();
+    int n_labels = 0;
+    for (const auto* v : {&rows, &sums, &cols})
+        for (int g : *v) n_labels = std::max(n_labels, g + 1);
+    if (n_labels <= 1) {
+        parallel_gemm(m, n, k, alpha, a, k, b, n, c, n);
+        return;
+    }
+    const auto with = [](const std::vector<int>& v, int g) {
+        std::vector<std::size_t> out;
+        for (std::size_t x = 0; x < v.size(); ++x)
+            if (v[x] == g) out.push_back(x);
+        return out;
+    };
+    for (int g = 0; g < n_labels; ++g) {
+        const std::vector<std::size_t> R = with(rows, g), Q = with(sums, g), C = with(cols, g);
+        if (R.empty() || Q.empty() || C.empty()) continue;
+        const std::size_t mg = R.size(), kg = Q.size(), ng = C.size();
+        std::vector<double> ag(mg * kg), bg(kg * ng), cg(mg * ng, 0.0);
+        CCSD_OMP_PARALLEL_FOR
+        for (std::size_t r = 0; r < mg; ++r)
+            for (std::size_t q = 0; q < kg; ++q) ag[r * kg + q] = a[R[r] * k + Q[q]];
+        CCSD_OMP_PARALLEL_FOR
+        for (std::size_t q = 0; q < kg; ++q)
+            for (std::size_t x = 0; x < ng; ++x) bg[q * ng + x] = b[Q[q] * n + C[x]];
+        parallel_gemm(mg, ng, kg, alpha, ag.data(), kg, bg.data(), ng, cg.data(), ng);
+        CCSD_OMP_PARALLEL_FOR
+        for (std::size_t r = 0; r < mg; ++r)
+            for (std::size_t x = 0; x < ng; ++x) c[R[r] * n + C[x]] += cg[r * ng + x];
+    }
+}
+
+// How one operand is packed for a GEMM: its dimensions in packed order
+// (row-major), the first `lead` of them forming the GEMM's row index (for
+// the left operand) or summed index (for the right one).
+template <std::size_t R>
+struct Packing {
+    Layout<R> order;
+    std::size_t lead = 0;
+    std::size_t outer = 1, inner = 1;   // elements spanned by the first `lead` dims / the rest
+};
+
+// X packed [free | summed] (free_first) or [summed | free], its summed
+// dimensions in the order of `summed` (the first n_summed labels).
+template <std::size_t R, std::size_t S>
+Packing<R> packing(const TensorView<R>& x, const std::array<char, R>& lx,
+                   const std::array<char, S>& summed, std::size_t n_summed, bool free_first) {
+    Packing<R> p;
+    std::size_t nd = 0;
+    const auto is_summed = [&](char c) {
+        for (std::size_t s = 0; s < n_summed; ++s)
+            if (summed[s] == c) return true;
+        return false;
+    };
+    const auto put_free = [&](std::size_t& size) {
+        for (std::size_t d = 0; d < R; ++d)
+            if (!is_summed(lx[d])) {
+                p.order.order[nd++] = static_cast<int>(d);
+                size *= static_cast<std::size_t>(x.extents[d]);
+            }
+    };
+    const auto put_summed = [&](std::size_t& size) {
+        for (std::size_t s = 0; s < n_summed; ++s) {
+            const int d = find(summed[s], lx);
+            p.order.order[nd++] = d;
+            size *= static_cast<std::size_t>(x.extents[static_cast<std::size_t>(d)]);
+        }
+    };
+    if (free_first) { put_free(p.outer);   p.lead = nd; put_summed(p.inner); }
+    else            { put_summed(p.outer); p.lead = nd; put_free(p.inner); }
+    return p;
+}
+
+// Elements packing v in `order` copies: none when v is already stored so.
+template <std::size_t R>
+std::size_t copied(const TensorView<R>& v, const Layout<R>& order) {
+    return v.strides == order.strides(v.extents) ? 0 : volume(v);
+}
+
+// v's data densely in `order`: v itself when so stored, else packed into buf.
+template <std::size_t R>
+const double* packed(const TensorView<R>& v, const Layout<R>& order, std::vector<double>& buf) {
+    if (copied(v, order) == 0) return v.data;
+    buf = pack(v, order);
+    return buf.data();
+}
+
+// out += alpha · X · Y with X packed [free | summed] and Y [summed | free]:
+// GEMMs form the product (one per symmetry label, see symmetric_gemm) and
+// it is scattered into out in out's label order.
+template <std::size_t RX, std::size_t RY, std::size_t RO>
+void multiply(double alpha, const Spaces& sp,
+              const TensorView<RX>& X, const std::array<char, RX>& lx, const Packing<RX>& px,
+              const TensorView<RY>& Y, const std::array<char, RY>& ly, const Packing<RY>& py,
+              double* out, const TensorView<RO>& ov, const std::array<char, RO>& lo) {
+    std::vector<double> xbuf, ybuf;
+    const double* x = packed(X, px.order, xbuf);
+    const double* y = packed(Y, py.order, ybuf);
+    std::vector<double> c(px.outer * py.inner, 0.0);
+    symmetric_gemm(composite_labels(X, lx, px.order, 0, px.lead, sp), composite_labels(X, lx, px.order, px.lead, RX, sp),
+                   composite_labels(Y, ly, py.order, py.lead, RY, sp), alpha, x, y, c.data());
+
+    Layout<RO> pc;
+    std::size_t nc = 0;
+    for (std::size_t d = 0; d < px.lead; ++d)
+        pc.order[nc++] = find(lx[static_cast<std::size_t>(px.order.order[d])], lo);
+    for (std::size_t d = py.lead; d < RY; ++d)
+        pc.order[nc++] = find(ly[static_cast<std::size_t>(py.order.order[d])], lo);
+    scatter_add(TensorView<RO>{c.data(), ov.extents, pc.strides(ov.extents)}, 1.0, out, ov.strides);
+}
+
+// out += alpha · A · B, summed over the labels A and B share, as one GEMM
+// between the operands packed [free | summed] and [summed | free]. The
+// summed labels follow the larger operand's own order, and the GEMM runs
+// as A·B or B·A, whichever packing copies fewer elements: a dense block
+// whose summed labels come last (or first) is then used as stored.
+template <std::size_t RA, std::size_t RB, std::size_t RO>
+void contract(double alpha, const Spaces& sp,
+              const TensorView<RA>& A, const std::array<char, RA>& la,
+              const TensorView<RB>& B, const std::array<char, RB>& lb,
+              double* out, const TensorView<RO>& ov, const std::array<char, RO>& lo) {
+    std::array<char, std::max(RA, RB)> summed{};
+    std::size_t n_summed = 0;
+    if (volume(A) >= volume(B)) {
+        for (char c : la) if (find(c, lb) >= 0) summed[n_summed++] = c;
+    } else {
+        for (char c : lb) if (find(c, la) >= 0) summed[n_summed++] = c;
+    }
+    const Packing<RA> a_row = packing(A, la, summed, n_summed, true),  a_col = packing(A, la, summed, n_summed, false);
+    const Packing<RB> b_row = packing(B, lb, summed, n_summed, true),  b_col = packing(B, lb, summed, n_summed, false);
+    if (copied(B, b_row.order) + copied(A, a_col.order) < copied(A, a_row.order) + copied(B, b_col.order))
+        multiply(alpha, sp, B, lb, b_row, A, la, a_col, out, ov, lo);
+    else
+        multiply(alpha, sp, A, la, a_row, B, lb, b_col, out, ov, lo);
+}
+
+// Flops of (X·Y)·Z.
+template <class X, class Y, class Z>
+double pair_flops(const X& x, const Y& y, const Z& z) {
+    constexpr auto li = pair_labels<X, Y>();
+    double first = 2.0, second = 2.0;
+    for (char c : X::labels) first *= extent(c, x, y, z);
+    for (char c : Y::labels) if (find(c, X::labels) < 0) first *= extent(c, x, y, z);
+    for (char c : li) second *= extent(c, x, y, z);
+    for (char c : Z::labels) if (find(c, li) < 0) second *= extent(c, x, y, z);
+    return first + second;
+}
+
+// out += scale · (X·Y)·Z through a dense row-major intermediate.
+template <class X, class Y, class Z, char... O>
+void contract_pair_first(double scale, const X& x, const Y& y, const Z& z, const Target<O...>& out) {
+    constexpr auto li = pair_labels<X, Y>();
+    static_assert(li.size() > 0, "a pair of operands contracts to a scalar");
+    std::array<int, li.size()> ext{};
+    std::size_t n = 1;
+    for (std::size_t d = 0; d < li.size(); ++d) {
+        ext[d] = extent(li[d], x, y);
+        n *= static_cast<std::size_t>(ext[d]);
+    }
+    std::vector<double> mid(n, 0.0);
+    const auto mv = TensorView<li.size()>::row_major(mid.data(), ext);
+    contract(1.0, x.spaces, x.view, X::labels, y.view, Y::labels, mid.data(), mv, li);
+    contract(scale, x.spaces, mv, li, z.view, Z::labels, out.data, out.view, Target<O...>::labels);
+}
+
+}  // namespace detail
+
+template <class... Ops>
+[[nodiscard]] Plan plan(const Term<Ops...>& t) {
+    static_assert(sizeof...(Ops) >= 1 && sizeof...(Ops) <= 3, "terms have one to three operands");
+    if constexpr (sizeof...(Ops) == 1) {
+        const auto& x = std::get<0>(t.ops);
+        double v = 1.0;
+        for (int e : x.view.extents) v *= e;
+        return {0, 0, v};
+    } else if constexpr (sizeof...(Ops) == 2) {
+        const auto& [x, y] = t.ops;
+        double v = 2.0;
+        for (int e : x.view.extents) v *= e;
+        for (char c : y.labels) if (detail::find(c, x.labels) < 0) v *= detail::extent(c, y);
+        return {0, 1, v};
+    } else {
+        const auto& [x, y, z] = t.ops;
+        Plan best{0, 1, detail::pair_flops(x, y, z)};
+        if (const double f = detail::pair_flops(x, z, y); f < best.flops) best = {0, 2, f};
+        if (const double f = detail::pair_flops(y, z, x); f < best.flops) best = {1, 2, f};
+        return best;
+    }
+}
+
+template <char... O>
+template <class... Ops>
+Target<O...>& Target<O...>::operator+=(const Term<Ops...>& t) {
+    static_assert(detail::well_formed<Target, Ops...>(),
+                  "each label must be free in the target or summed over exactly two operands");
+    if constexpr (sizeof...(Ops) == 1) {
+        // Operand dimensions permuted into target order: one blocked transpose.
+        const auto& x = std::get<0>(t.ops);
+        TensorView<sizeof...(O)> v{x.view.data, {}, {}};
+        for (std::size_t d = 0; d < sizeof...(O); ++d) {
+            const auto s = static_cast<std::size_t>(detail::find(this->labels[d], x.labels));
+            v.extents[d] = x.view.extents[s];
+            v.strides[d] = x.view.strides[s];
+        }
+        detail::scatter_add(v, t.scale, data, this->view.strides);
+    } else if constexpr (sizeof...(Ops) == 2) {
+        const auto& [x, y] = t.ops;
+        detail::contract(t.scale, x.spaces, x.view, x.labels, y.view, y.labels, data, this->view, this->labels);
+    } else {
+        const Plan p = plan(t);
+        const auto& [x, y, z] = t.ops;
+        if (p.first == 0 && p.second == 1)      detail::contract_pair_first(t.scale, x, y, z, *this);
+        else if (p.first == 0 && p.second == 2) detail::contract_pair_first(t.scale, x, z, y, *this);
+        else                                    detail::contract_pair_first(t.scale, y, z, x, *this);
+    }
+    return *this;
+}
+
+template <char... O>
+template <char... R>
+Target<O...>& Target<O...>::operator+=(const Operand<R...>& x) {
+    return *this += 1.0 * x;
+}
+
+}  // namespace ccsd::einsum
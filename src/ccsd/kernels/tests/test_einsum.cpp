@@ -0,0 +1,157 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <ccsd/kernels/einsum.h>
+
+#include <cmath>
+#include <utility>
+
+using Catch::Approx;
+using namespace ccsd::einsum::labels;
+
+// Small spin-orbital space with o != v so a transposed extent would show up.
+namespace {
+
+constexpr int n_occ = 3, n_vir = 5, n_so = n_occ + n_vir;
+constexpr ccsd::einsum::Spaces sp{n_occ, n_vir};
+
+double f4(int p, int q, int r, int s) { return std::sin(0.3 * p + 1.1 * q - 0.7 * r + 0.2 * s + 0.05 * p * s); }
+double f2(int p, int q) { return std::cos(0.9 * p - 0.4 * q); }
+
+ccsd::Vector4D filled4(ccsd::Layout<4> layout = ccsd::Layout<4>::standard()) {
+    ccsd::Vector4D t;
+    t.initialization(n_so, layout);
+    for (int p = 0; p < n_so; ++p)
+        for (int q = 0; q < n_so; ++q)
+            for (int r = 0; r < n_so; ++r)
+                for (int s = 0; s < n_so; ++s) t(p, q, r, s) = f4(p, q, r, s);
+    return t;
+}
+
+ccsd::Vector2D filled2() {
+    ccsd::Vector2D t;
+    t.initialization(n_so);
+    for (int p = 0; p < n_so; ++p)
+        for (int q = 0; q < n_so; ++q) t(p, q) = f2(p, q);
+    return t;
+}
+
+}  // namespace
+
+TEST_CASE("einsum copies a block with permuted labels", "[einsum]") {
+    const auto I = ccsd::einsum::block(sp, f4, m, b, e, j);
+    ccsd::Vector4D W;
+    W.initialization(n_so);
+    auto w = ccsd::einsum::tensor(W, sp);
+    w(j,m,e,b) += -2.0*I(m,b,e,j);
+
+    for (int mm = 0; mm < n_occ; ++mm)
+        for (int bb = n_occ; bb < n_so; ++bb)
+            for (int ee = n_occ; ee < n_so; ++ee)
+                for (int jj = 0; jj < n_occ; ++jj)
+                    REQUIRE(W(jj, mm, ee, bb) == Approx(-2.0 * f4(mm, bb, ee, jj)));
+    REQUIRE(W(0, 0, 0, 0) == 0.0);   // outside the target block
+}
+
+TEST_CASE("einsum binary contraction matches explicit loops", "[einsum]") {
+    // Non-standard layouts on both sides: the packing must follow the strides.
+    const ccsd::Vector4D t2 = filled4(ccsd::Layout<4>{{2, 0, 3, 1}});
+    const auto I = ccsd::einsum::block(sp, f4, m, n, e, f);
+    ccsd::Vector4D W;
+    W.initialization(n_so, ccsd::Layout<4>::row_major());
+    auto w = ccsd::einsum::tensor(W, sp);
+    w(m,b,e,j) += -0.5*ccsd::einsum::tensor(t2, sp)(f,b,j,n)*I(m,n,e,f);
+
+    for (int mm = 0; mm < n_occ; ++mm)
+        for (int bb = n_occ; bb < n_so; ++bb)
+            for (int ee = n_occ; ee < n_so; ++ee)
+                for (int jj = 0; jj < n_occ; ++jj) {
+                    double ref = 0.0;
+                    for (int nn = 0; nn < n_occ; ++nn)
+                        for (int ff = n_occ; ff < n_so; ++ff)
+                            ref += -0.5 * f4(ff, bb, jj, nn) * f4(mm, nn, ee, ff);
+                    REQUIRE(W(mm, bb, ee, jj) == Approx(ref).margin(1e-12));
+                }
+}
+
+TEST_CASE("einsum ternary contraction matches explicit loops", "[einsum]") {
+    const ccsd::Vector2D T1 = filled2();
+    const auto t1 = ccsd::einsum::tensor(T1, sp);
+    const auto I = ccsd::einsum::block(sp, f4, m, n, e, f);
+    ccsd::Vector4D W;
+    W.initialization(n_so);
+    auto w = ccsd::einsum::tensor(W, sp);
+    w(m,b,e,j) += -t1(f,j)*t1(b,n)*I(m,n,e,f);
+
+    for (int mm = 0; mm < n_occ; ++mm)
+        for (int bb = n_occ; bb < n_so; ++bb)
+            for (int ee = n_occ; ee < n_so; ++ee)
+                for (int jj = 0; jj < n_occ; ++jj) {
+                    double ref = 0.0;
+                    for (int nn = 0; nn < n_occ; ++nn)
+                        for (int ff = n_occ; ff < n_so; ++ff)
+                            ref += -f2(ff, jj) * f2(bb, nn) * f4(mm, nn, ee, ff);
+                    REQUIRE(W(mm, bb, ee, jj) == Approx(ref).margin(1e-12));
+                }
+}
+
+TEST_CASE("einsum plan contracts the cheapest pair first", "[einsum]") {
+    const ccsd::Vector2D T1 = filled2();
+    const auto t1 = ccsd::einsum::tensor(T1, sp);
+    const auto I = ccsd::einsum::block(sp, f4, m, n, e, f);
+
+    // v > o: t1(f,j)·I (o³v²) beats t1(b,n)·I (o²v³) and t1·t1 (o³v³ after).
+    const auto p = ccsd::einsum::plan(-t1(f,j)*t1(b,n)*I(m,n,e,f));
+    REQUIRE(p.first == 0);
+    REQUIRE(p.second == 2);
+    REQUIRE(p.flops == Approx(2.0 * 2 * n_occ * n_occ * n_occ * n_vir * n_vir));
+
+    // With the roles of o and v swapped the other t1 goes first.
+    constexpr ccsd::einsum::Spaces swapped{n_vir, n_occ};
+    const auto u1 = ccsd::einsum::tensor(T1, swapped);
+    const auto J = ccsd::einsum::block(swapped, f4, m, n, e, f);
+    const auto q = ccsd::einsum::plan(-u1(f,j)*u1(b,n)*J(m,n,e,f));
+    REQUIRE(q.first == 1);
+    REQUIRE(q.second == 2);
+}
+
+TEST_CASE("einsum with symmetry labels skips only forbidden blocks", "[einsum]") {
+    // Operands that vanish unless their labels XOR to 0: the per-label GEMMs
+    // must reproduce the dense loops exactly, and blocks fill only allowed
+    // elements.
+    const int labels[n_so] = {0, 1, 2, 3, 1, 0, 2, 3};
+    const ccsd::einsum::Spaces sym{n_occ, n_vir, labels};
+    const auto ok2 = [&](int p, int q) { return labels[p] == labels[q]; };
+    const auto ok4 = [&](int p, int q, int r, int s) { return (labels[p] ^ labels[q] ^ labels[r] ^ labels[s]) == 0; };
+    const auto g4 = [&](int p, int q, int r, int s) { return ok4(p, q, r, s) ? f4(p, q, r, s) : 0.0; };
+
+    ccsd::Vector2D T1;
+    T1.initialization(n_so);
+    ccsd::Vector4D T2;
+    T2.initialization(n_so);
+    for (int p = 0; p < n_so; ++p)
+        for (int q = 0; q < n_so; ++q) {
+            T1(p, q) = ok2(p, q) ? f2(p, q) : 0.0;
+            for (int r = 0; r < n_so; ++r)
+                for (int s = 0; s < n_so; ++s) T2(p, q, r, s) = g4(p, q, r, s);
+        }
+    const auto t1 = ccsd::einsum::tensor(T1, sym);
+    const auto t2 = ccsd::einsum::tensor(T2, sym);
+    const auto I = ccsd::einsum::block(sym, f4, m, n, e, f);
+    ccsd::Vector4D W;
+    W.initialization(n_so);
+    auto w = ccsd::einsum::tensor(W, sym);
+    w(m,b,e,j) += -0.5*t2(f,b,j,n)*I(m,n,e,f);
+    w(m,b,e,j) += -t1(f,j)*t1(b,n)*I(m,n,e,f);
+
+    for (int mm = 0; mm < n_occ; ++mm)
+        for (int bb = n_occ; bb < n_so; ++bb)
+            for (int ee = n_occ; ee < n_so; ++ee)
+                for (int jj = 0; jj < n_occ; ++jj) {
+                    double ref = 0.0;
+                    for (int nn = 0; nn < n_occ; ++nn)
+                        for (int ff = n_occ; ff < n_so; ++ff)
+                            ref += (-0.5 * g4(ff, bb, jj, nn) - T1(ff, jj) * T1(bb, nn)) * g4(mm, nn, ee, ff);
+                    REQUIRE(W(mm, bb, ee, jj) == Approx(ref).margin(1e-12));
+                }
+}
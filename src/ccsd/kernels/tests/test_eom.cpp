@@ -0,0 +1,182 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <ccsd/kernels/ccsd_eom.h>
+#include <ccsd/kernels/ccsd_kernels.h>
+#include <ccsd/kernels/ccsd_state.h>
+#include <ccsd/config/ccsd_config.h>
+#include <ccsd/kernels/tests/test_systems.h>
+#include <util/linalg/general_eigen.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using Catch::Approx;
+
+// ── helpers ──────────────────────────────────────────────────────────────────
+
+namespace {
+
+using ccsd::test::build_intermediates;
+using ccsd::test::pseudo_random_system;
+
+// Converges CCSD tightly (amplitude change < 1e-13) and leaves the
+// intermediates built at the converged amplitudes.
+void converge(ccsd::CcsdState& s, ccsd::CcsdKernels& k) {
+    ccsd::test::initialize(k);
+    for (int iter = 0; iter < 500; ++iter)
+        if (ccsd::test::iterate(s, k) < 1e-13) break;
+    build_intermediates(k);
+}
+
+// CCSD residual <μ|H̄|0> = D t_next(T) - D T, flattened like an EOM vector.
+std::vector<double> residual(ccsd::CcsdState& s, ccsd::CcsdKernels& k, int o) {
+    const int n = s.n_spin_orbitals;
+    build_intermediates(k);
+    k.compute_t1();
+    k.compute_t2();
+    std::vector<double> out;
+    for (int a = o; a < n; ++a)
+        for (int i = 0; i < o; ++i) out.push_back(s.denom_ai(a, i) * (s.t1_next(a, i) - s.t1(a, i)));
+    for (int a = o; a < n; ++a)
+        for (int b = o; b < n; ++b)
+            for (int i = 0; i < o; ++i)
+                for (int j = 0; j < o; ++j)
+                    out.push_back(s.denom_abij(a, b, i, j) * (s.t2_next(a, b, i, j) - s.t2(a, b, i, j)));
+    return out;
+}
+
+// T ← T0 + h R, with R flattened like an EOM vector.
+void displace(ccsd::CcsdState& s, const ccsd::CcsdState& base, const std::vector<double>& r, double h, int o) {
+    const int n = s.n_spin_orbitals;
+    std::size_t q = 0;
+    for (int a = o; a < n; ++a)
+        for (int i = 0; i < o; ++i, ++q) s.t1(a, i) = base.t1(a, i) + h * r[q];
+    for (int a = o; a < n; ++a)
+        for (int b = o; b < n; ++b)
+            for (int i = 0; i < o; ++i)
+                for (int j = 0; j < o; ++j, ++q) s.t2(a, b, i, j) = base.t2(a, b, i, j) + h * r[q];
+}
+
+// Pseudo-random combination of every start vector: a generic vector of
+// the target space (antisymmetric doubles, right irrep and M_s).
+std::vector<double> random_vector(const ccsd::EomKernels& eom, int seed) {
+    const auto basis = eom.guesses(eom.max_roots());
+    std::vector<double> r(eom.size(), 0.0);
+    for (std::size_t k = 0; k < basis.size(); ++k) {
+        const double x = std::sin(12.9898 * static_cast<double>(k + 1) + 78.233 * seed) * 43758.5453;
+        const double c = x - std::floor(x) - 0.5;
+        for (std::size_t q = 0; q < r.size(); ++q) r[q] += c * basis[k][q];
+    }
+    return r;
+}
+
+}  // namespace
+
+// ── sigma ────────────────────────────────────────────────────────────────────
+
+TEST_CASE("EOM sigma equals the CCSD Jacobian at convergence", "[eom]") {
+    // At converged T, H̄ - E_CCSD on singles and doubles is the Jacobian of
+    // the CCSD residual; a five-point stencil is exact for its (quartic) T.
+    const ccsd::CcsdConfig cfg = pseudo_random_system();
+    ccsd::CcsdConfig labelled = cfg;
+    labelled.orbital_symmetry = {1, 2, 1, 2, 1, 2};
+    const int o = cfg.n_occupied;
+
+    ccsd::CcsdState s;
+    s.allocate(2 * cfg.n_spatial_orbitals);
+    ccsd::CcsdKernels k(s, cfg);
+    converge(s, k);
+    const ccsd::CcsdState base = s;
+
+    for (const int irrep : {0, 1}) {
+        const ccsd::EomKernels eom(base, labelled, irrep);
+        REQUIRE(eom.max_roots() > 0);
+        const std::vector<double> r = random_vector(eom, irrep);
+        std::vector<std::vector<double>> sigma;
+        eom.sigma({r}, sigma);
+
+        const double h = 1e-2;
+        std::vector<double> jr(r.size(), 0.0);
+        for (const auto& [step, weight] : {std::pair{2.0, -1.0}, {1.0, 8.0}, {-1.0, -8.0}, {-2.0, 1.0}}) {
+            displace(s, base, r, step * h, o);
+            const std::vector<double> omega = residual(s, k, o);
+            for (std::size_t q = 0; q < jr.size(); ++q) jr[q] += weight * omega[q] / (12.0 * h);
+        }
+        for (std::size_t q = 0; q < r.size(); ++q) REQUIRE(sigma[0][q] == Approx(jr[q]).margin(1e-9));
+    }
+}
+
+TEST_CASE("EOM sigma of a batch equals the vectors one at a time", "[eom]") {
+    const ccsd::CcsdConfig cfg = pseudo_random_system();
+    ccsd::CcsdState s;
+    s.allocate(2 * cfg.n_spatial_orbitals);
+    ccsd::CcsdKernels k(s, cfg);
+    converge(s, k);
+    const ccsd::EomKernels eom(s, cfg);
+
+    const std::vector<std::vector<double>> batch = {random_vector(eom, 1), random_vector(eom, 2), random_vector(eom, 3)};
+    std::vector<std::vector<double>> together;
+    eom.sigma(batch, together);
+    for (std::size_t b = 0; b < batch.size(); ++b) {
+        std::vector<std::vector<double>> alone;
+        eom.sigma({batch[b]}, alone);
+        for (std::size_t q = 0; q < alone[0].size(); ++q) REQUIRE(together[b][q] == Approx(alone[0][q]).margin(1e-13));
+    }
+}
+
+// ── Davidson ─────────────────────────────────────────────────────────────────
+
+TEST_CASE("EOM Davidson roots match the dense EOM matrix", "[eom][davidson]") {
+    const ccsd::CcsdConfig cfg = pseudo_random_system();
+    ccsd::CcsdState s;
+    s.allocate(2 * cfg.n_spatial_orbitals);
+    ccsd::CcsdKernels k(s, cfg);
+    converge(s, k);
+    const ccsd::EomKernels eom(s, cfg);
+
+    // H̄ - E in the orthonormal basis of all start vectors.
+    const auto basis = eom.guesses(eom.max_roots());
+    const auto m = basis.size();
+    std::vector<std::vector<double>> columns;
+    eom.sigma(basis, columns);
+    std::vector<double> dense(m * m);
+    for (std::size_t i = 0; i < m; ++i)
+        for (std::size_t j = 0; j < m; ++j) {
+            double x = 0.0;
+            for (std::size_t q = 0; q < eom.size(); ++q) x += basis[i][q] * columns[j][q];
+            dense[i * m + j] = x;
+        }
+    std::vector<double> expected = ccsd::linalg::general_eigenvalues(dense, static_cast<int>(m)).real;
+    std::sort(expected.begin(), expected.end());
+
+    const ccsd::EomResult result = eom.solve(4, 1e-8);
+    REQUIRE(result.converged);
+    REQUIRE(result.roots.size() == 4);
+    for (std::size_t r = 0; r < 4; ++r) REQUIRE(result.roots[r].excitation == Approx(expected[r]).epsilon(1e-9));
+}
+
+TEST_CASE("EOM-CCSD of a two-electron system reproduces the FCI excitation energies", "[eom][davidson]") {
+    // CCSD is exact for two electrons, so EOM-CCSD gives the full-CI
+    // spectrum of HeH+ (M_s = 0 determinants diagonalized separately).
+    ccsd::CcsdConfig cfg("./config.json");
+    ccsd::CcsdState  s;
+    s.allocate(2 * cfg.n_spatial_orbitals);
+    ccsd::CcsdKernels k(s, cfg);
+    converge(s, k);
+    const ccsd::EomKernels eom(s, cfg);
+    REQUIRE(eom.max_roots() == 3);
+
+    const ccsd::EomResult result = eom.solve(3, 1e-9);
+    REQUIRE(result.converged);
+    REQUIRE(result.roots[0].excitation == Approx(0.665827640280).epsilon(1e-8));
+    REQUIRE(result.roots[1].excitation == Approx(0.833785435251).epsilon(1e-8));
+    REQUIRE(result.roots[2].excitation == Approx(2.166461896036).epsilon(1e-8));
+    REQUIRE(result.roots[0].multiplicity == 3);
+    REQUIRE(result.roots[1].multiplicity == 1);
+    REQUIRE(result.roots[2].multiplicity == 1);
+    REQUIRE(result.roots[0].singles == Approx(1.0));      // a triplet has no M_s = 0 doubles here
+    REQUIRE(result.roots[2].singles < 0.5);                // the doubly excited state
+}
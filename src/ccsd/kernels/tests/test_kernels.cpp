@@ -1,10 +1,20 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
 
+#include <ccsd/kernels/ccsd_incremental.h>
 #include <ccsd/kernels/ccsd_kernels.h>
+#include <ccsd/kernels/ccsd_symmetry.h>
 #include <ccsd/kernels/ccsd_state.h>
 #include <ccsd/kernels/ccsd_constants.h>
 #include <ccsd/config/ccsd_config.h>
+#include <ccsd/config/fno.h>
+#include <ccsd/kernels/tests/test_systems.h>
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 using Catch::Approx;
 
@@ -149,3 +159,308 @@ TEST_CASE("CcsdKernels converges HeH+ to reference energy without MPI", "[kernel
     REQUIRE(iter < 200);
     REQUIRE(energy == Approx(-0.008225832259).epsilon(1e-8));
 }
+
+// ── frozen core ──────────────────────────────────────────────────────────────
+
+namespace {
+
+double converge_ccsd(const ccsd::CcsdConfig& cfg, std::size_t* spin_integral_elements = nullptr,
+                     ccsd::CholeskyVectors cholesky = {}) {
+    const int n = 2 * cfg.n_spatial_orbitals;
+    ccsd::CcsdState s;
+    s.cholesky = std::move(cholesky);
+    s.allocate(n, ccsd::SpinOrbitalSymmetry::labels(cfg.orbital_symmetry, n));
+    if (spin_integral_elements) *spin_integral_elements = s.spin_integrals.n_size();
+    ccsd::CcsdKernels k(s, cfg);
+    ccsd::test::initialize(k);
+    double energy = 0.0, diff = 10.0;
+    for (int iter = 0; diff > ccsd::constants::convergence_threshold && iter < 200; ++iter) {
+        ccsd::test::iterate(s, k);
+        const double e = k.compute_energy();
+        diff = std::abs(e - energy);
+        energy = e;
+    }
+    return energy;
+}
+
+}  // namespace
+
+TEST_CASE("freeze_core of a decoupled core orbital leaves the CCSD energy unchanged", "[kernels][frozen_core]") {
+    // HeH+ shifted up by one orbital under a deep core orbital whose only
+    // integral is (11|11): the core pair cannot excite, so full and
+    // frozen-core CCSD must agree.
+    const ccsd::CcsdConfig hehp("./config.json");
+    ccsd::CcsdConfig full{ccsd::CcsdConfig::direct_init{}};
+    full.n_spatial_orbitals = 3;
+    full.n_occupied         = 4;
+    full.orbital_energies   = {-20.0, hehp.orbital_energies[0], hehp.orbital_energies[1]};
+    full.two_electron_mos.insert(ccsd::compound_index(1, 1, 1, 1), 1.0);
+    for (int a = 1; a <= 2; ++a)
+        for (int b = 1; b <= 2; ++b)
+            for (int c = 1; c <= 2; ++c)
+                for (int d = 1; d <= 2; ++d)
+                    if (const double* v = hehp.two_electron_mos.find(ccsd::compound_index(a, b, c, d)))
+                        full.two_electron_mos.insert(ccsd::compound_index(a + 1, b + 1, c + 1, d + 1), *v);
+    full.two_electron_mos.finalize();
+    full.validate();
+
+    ccsd::CcsdConfig frozen = full;
+    frozen.freeze_core(1);
+    REQUIRE(frozen.n_spatial_orbitals == 2);
+    REQUIRE(frozen.n_occupied == 2);
+    REQUIRE(frozen.frozen_core == 1);
+    REQUIRE(frozen.two_electron_mos.size() == hehp.two_electron_mos.size());
+
+    const double e_frozen = converge_ccsd(frozen);
+    REQUIRE(e_frozen == Approx(-0.008225832259).epsilon(1e-8));
+    REQUIRE(converge_ccsd(full) == Approx(e_frozen).epsilon(1e-10));
+}
+
+// ── point-group symmetry ─────────────────────────────────────────────────────
+
+namespace {
+
+// Four spatial orbitals in irreps {1,2,1,2} (C2v-like, two occupied).
+ccsd::CcsdConfig pseudo_random_system(bool labelled = false) {
+    return ccsd::test::pseudo_random_system(labelled, {-1.0, -0.8, 0.6, 0.9});
+}
+
+}  // namespace
+
+TEST_CASE("Irrep-blocked CCSD matches the unlabelled run on a symmetric system", "[kernels][symmetry]") {
+    const ccsd::CcsdConfig c1  = pseudo_random_system();
+    const ccsd::CcsdConfig sym = pseudo_random_system(true);
+
+    std::size_t n_c1 = 0, n_sym = 0;
+    const double e_c1  = converge_ccsd(c1, &n_c1);
+    const double e_sym = converge_ccsd(sym, &n_sym);
+    REQUIRE(e_c1 < -1e-4);
+    REQUIRE(e_sym == Approx(e_c1).epsilon(1e-12));
+    REQUIRE(n_sym * 2 == n_c1);   // two irreps halve the spin-blocked integrals
+}
+
+TEST_CASE("compute_W_mbej matches Stanton eq. (8) element by element", "[kernels][symmetry]") {
+    // The t1·<mb||ef> term runs m-slice by m-slice, one GEMM per label.
+    for (const bool labelled : {false, true}) {
+        const ccsd::CcsdConfig cfg = ccsd::test::pseudo_random_system(labelled);
+        ccsd::CcsdState s;
+        s.allocate(2 * cfg.n_spatial_orbitals);
+        ccsd::CcsdKernels k(s, cfg);
+        ccsd::test::initialize(k);
+        ccsd::test::iterate(s, k, 2);
+        k.compute_W_mbej();
+        const int o = cfg.n_occupied, n = s.n_spin_orbitals;
+        for (int m = 0; m < o; ++m)
+            for (int b = o; b < n; ++b)
+                for (int e = o; e < n; ++e)
+                    for (int j = 0; j < o; ++j) {
+                        double w = s.integral(m, b, e, j);
+                        for (int f = o; f < n; ++f) w += s.t1(f, j) * s.integral(m, b, e, f);
+                        for (int nn = 0; nn < o; ++nn) {
+                            w -= s.t1(b, nn) * s.integral(m, nn, e, j);
+                            for (int f = o; f < n; ++f)
+                                w -= (0.5 * s.t2(f, b, j, nn) + s.t1(f, j) * s.t1(b, nn)) * s.integral(m, nn, e, f);
+                        }
+                        REQUIRE(s.W_mbej(m, b, e, j) == Approx(w).margin(1e-13));
+                    }
+    }
+}
+
+TEST_CASE("FNO keeping every virtual leaves the CCSD energy unchanged", "[kernels][fno]") {
+    for (const bool labelled : {false, true}) {
+        const ccsd::CcsdConfig full = pseudo_random_system(labelled);
+        ccsd::CcsdConfig rotated = full;
+        const auto r = ccsd::truncate_virtuals_fno(rotated, -1.0);
+        REQUIRE(r.n_virtual_kept == 2);
+        REQUIRE(converge_ccsd(rotated) == Approx(converge_ccsd(full)).epsilon(1e-9));
+    }
+}
+
+// ── Cholesky integrals ───────────────────────────────────────────────────────
+
+TEST_CASE("Cholesky backend matches dense integrals on a symmetric system", "[kernels][cholesky]") {
+    // Same orbital layout as above, but (ab|cd) = Σ_k u_k(ab) u_k(cd) with each
+    // u_k confined to one pair irrep: positive semidefinite and symmetry-clean,
+    // so a tight decomposition is exact.
+    ccsd::CcsdConfig cfg{ccsd::CcsdConfig::direct_init{}};
+    cfg.n_spatial_orbitals = 4;
+    cfg.n_occupied         = 4;
+    cfg.orbital_energies   = {-1.0, -0.8, 0.6, 0.9};
+    cfg.orbital_symmetry   = {1, 2, 1, 2};
+    const auto g = [&](int p) { return cfg.orbital_symmetry[static_cast<std::size_t>(p - 1)] - 1; };
+    const auto u = [&](int k, int a, int b) {
+        return (g(a) ^ g(b)) == k % 2 ? std::cos(1.1 * k + 0.9 * a + 0.5 * b) * (a == b ? 0.6 : 0.2) : 0.0;
+    };
+    for (int a = 1; a <= 4; ++a)
+        for (int b = 1; b <= a; ++b)
+            for (int c = 1; c <= 4; ++c)
+                for (int d = 1; d <= c; ++d) {
+                    double v = 0.0;
+                    for (int k = 0; k < 6; ++k) v += u(k, a, b) * u(k, c, d);
+                    if (v != 0.0) cfg.two_electron_mos.insert(ccsd::compound_index(a, b, c, d), v);
+                }
+    cfg.two_electron_mos.finalize();
+    cfg.validate();
+
+    std::size_t n_chol = 1;
+    const double e_dense = converge_ccsd(cfg);
+    const auto   L       = ccsd::cholesky_decompose(cfg.two_electron_mos, cfg.n_spatial_orbitals, 1e-14);
+    REQUIRE(e_dense < -1e-5);
+    REQUIRE(L.n_vectors() <= 6);
+    REQUIRE(converge_ccsd(cfg, &n_chol, L) == Approx(e_dense).epsilon(1e-10));
+    REQUIRE(n_chol == 0);   // no dense spin-orbital integrals are stored
+}
+
+TEST_CASE("Cholesky backend converges HeH+ to the reference energy", "[kernels][cholesky]") {
+    const ccsd::CcsdConfig cfg("./config.json");
+    const auto L = ccsd::cholesky_decompose(cfg.two_electron_mos, cfg.n_spatial_orbitals, 1e-12);
+    REQUIRE(converge_ccsd(cfg, nullptr, L) == Approx(-0.008225832259).epsilon(1e-8));
+}
+
+// ── tiled amplitude update ───────────────────────────────────────────────────
+
+TEST_CASE("compute_t1_tile/compute_t2_tile over split ranges match full update", "[kernels][tile]") {
+    ccsd::CcsdConfig cfg("./config.json");
+    ccsd::CcsdState  s;
+    s.allocate(2 * cfg.n_spatial_orbitals);
+
+    ccsd::CcsdKernels k(s, cfg);
+    k.build_spin_integrals();
+    k.build_fock_spin();
+    k.guess_t2();
+    k.build_denominators();
+    k.compute_F_ae();  k.compute_F_mi();  k.compute_F_me();
+    k.compute_W_mnij(); k.compute_W_abef(); k.compute_W_mbej();
+
+    k.compute_t1();
+    k.compute_t2();
+    const ccsd::Vector2D t1_full = s.t1_next;
+    const ccsd::Vector4D t2_full = s.t2_next;
+
+    // Two uneven tiles per amplitude, evaluated separately.
+    const int n_virt = s.n_spin_orbitals - cfg.n_occupied;
+    s.t1_next.zeros();
+    s.t2_next.zeros();
+    k.compute_t1_tile(0, 1);
+    k.compute_t1_tile(1, n_virt);
+    REQUIRE_THROWS_AS(ccsd::CcsdKernels(s, cfg).compute_t2_tile(0, 1), std::logic_error);
+    k.prepare_t2_tiles();
+    k.compute_t2_tile(0, 1);
+    k.compute_t2_tile(1, n_virt * n_virt);
+
+    for (int p = 0; p < s.n_spin_orbitals; ++p) {
+        for (int q = 0; q < s.n_spin_orbitals; ++q) {
+            REQUIRE(s.t1_next(p, q) == t1_full(p, q));
+            for (int r = 0; r < s.n_spin_orbitals; ++r)
+                for (int t = 0; t < s.n_spin_orbitals; ++t)
+                    REQUIRE(s.t2_next(p, q, r, t) == t2_full(p, q, r, t));
+        }
+    }
+}
+
+TEST_CASE("compute_t2_tile from streamed vvvv slabs matches the stored W_abef", "[kernels][tile][out_of_core]") {
+    ccsd::CcsdConfig cfg("./config.json");
+    ccsd::CcsdState  s;
+    s.allocate(2 * cfg.n_spatial_orbitals);
+
+    ccsd::CcsdKernels k(s, cfg);
+    k.build_spin_integrals();
+    k.build_fock_spin();
+    k.guess_t2();
+    k.build_denominators();
+    k.compute_F_ae();  k.compute_F_mi();  k.compute_F_me();
+    k.compute_W_mnij(); k.compute_W_abef(); k.compute_W_mbej();
+    k.compute_t2();
+    const ccsd::Vector4D t2_full = s.t2_next;
+
+    // Slabs of pairs [1, n_pairs) only, as a rank whose tile starts at 1 holds them.
+    const int n_virt  = s.n_spin_orbitals - cfg.n_occupied;
+    const auto nv2    = static_cast<std::size_t>(n_virt * n_virt);
+    std::vector<double> slabs(nv2 * (nv2 - 1));
+    for (int pair = 1; pair < n_virt * n_virt; ++pair)
+        k.build_vvvv_slab(pair, slabs.data() + static_cast<std::size_t>(pair - 1) * nv2);
+    s.W_abef.zeros();   // must not be read
+    s.t2_next.zeros();
+    k.prepare_t2_tiles();
+    k.compute_t2_tile(1, n_virt * n_virt, slabs.data());
+
+    for (int pair = 1; pair < n_virt * n_virt; ++pair) {
+        const int a = cfg.n_occupied + pair / n_virt;
+        const int b = cfg.n_occupied + pair % n_virt;
+        for (int i = 0; i < cfg.n_occupied; ++i)
+            for (int j = 0; j < cfg.n_occupied; ++j)
+                REQUIRE(s.t2_next(a, b, i, j) == Approx(t2_full(a, b, i, j)).epsilon(1e-14));
+    }
+}
+
+// ── incremental intermediates ────────────────────────────────────────────────
+
+using ccsd::test::build_intermediates;
+
+TEST_CASE("IncrementalIntermediates::update(0) reproduces a full rebuild", "[kernels][incremental]") {
+    for (const bool labelled : {false, true}) {
+        const ccsd::CcsdConfig cfg = pseudo_random_system(labelled);
+        const int n = 2 * cfg.n_spatial_orbitals;
+        ccsd::CcsdState s;
+        s.allocate(n, ccsd::SpinOrbitalSymmetry::labels(cfg.orbital_symmetry, n));
+        ccsd::CcsdKernels k(s, cfg);
+        ccsd::test::initialize(k);
+
+        // Built at the second iterate (t1 != 0), updated to the third, so
+        // every t1-linear, t1·t1 and t2 term changes.
+        ccsd::IncrementalIntermediates inc(s, cfg);
+        for (int iter = 0; iter < 2; ++iter) {
+            build_intermediates(k);
+            if (iter == 1) inc.mark_built();
+            k.compute_t1();
+            k.compute_t2();
+            s.t1 = s.t1_next;
+            s.t2 = s.t2_next;
+        }
+        REQUIRE(inc.update(0.0) > 0);
+        const ccsd::CcsdState updated = s;
+        build_intermediates(k);
+
+        const auto same = [&](const auto& x, const auto& y) {
+            for (std::size_t e = 0; e < x.n_size(); ++e)
+                REQUIRE(x.raw()[e] == Approx(y.raw()[e]).margin(1e-13));
+        };
+        same(updated.F_ae, s.F_ae);      same(updated.F_mi, s.F_mi);      same(updated.F_me, s.F_me);
+        same(updated.W_mnij, s.W_mnij);  same(updated.W_abef, s.W_abef);  same(updated.W_mbej, s.W_mbej);
+        REQUIRE(inc.update(0.0) == 0);   // nothing changed since
+    }
+}
+
+TEST_CASE("Screened incremental intermediates converge to the full-rebuild energy", "[kernels][incremental]") {
+    const ccsd::CcsdConfig cfg = pseudo_random_system();
+    const double e_full = converge_ccsd(cfg);
+
+    ccsd::CcsdState s;
+    s.allocate(2 * cfg.n_spatial_orbitals);
+    ccsd::CcsdKernels k(s, cfg);
+    ccsd::IncrementalIntermediates inc(s, cfg);
+    ccsd::test::initialize(k);
+    double energy = 0.0, diff = 10.0;
+    std::size_t applied = 0, full = 0;
+    int iter = 0;
+    for (; diff > ccsd::constants::convergence_threshold && iter < 200; ++iter) {
+        if (iter % 4 == 0) {   // full rebuild every fourth iteration
+            build_intermediates(k);
+            inc.mark_built();
+            full += 1;
+        } else {
+            applied += inc.update(1e-10);
+        }
+        k.compute_t1();
+        k.compute_t2();
+        s.t1 = s.t1_next;
+        s.t2 = s.t2_next;
+        const double e = k.compute_energy();
+        diff = std::abs(e - energy);
+        energy = e;
+    }
+    REQUIRE(iter < 200);
+    REQUIRE(full < static_cast<std::size_t>(iter));
+    REQUIRE(applied > 0);
+    REQUIRE(energy == Approx(e_full).epsilon(1e-8));
+}
@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <ccsd/kernels/ccsd_flops.h>
 #include <ccsd/kernels/ccsd_kernels.h>
 
 // get_key is a pure static function: compound index from 4 doubles.
@@ -29,3 +30,15 @@ TEST_CASE("get_key distinct inputs produce distinct keys", "[math]") {
     REQUIRE(k2 != k3);
     REQUIRE(k1 != k3);
 }
+
+// Flop model (ccsd_flops.h): hand counts for o = v = 1, and tile linearity.
+TEST_CASE("flop model matches hand counts for a 1x1 system", "[math]") {
+    REQUIRE(ccsd::flops::F_me(1.0, 1.0) == 2.0);
+    REQUIRE(ccsd::flops::F_ae(1.0, 1.0) == 13.0);    // 3 + (2 + 8)
+    REQUIRE(ccsd::flops::W_mnij(1.0, 1.0) == 11.0);  // 4 + 7
+}
+
+TEST_CASE("flop model is symmetric between F_ae/F_mi and W_abef/W_mnij", "[math]") {
+    REQUIRE(ccsd::flops::F_ae(2.0, 3.0) == ccsd::flops::F_mi(3.0, 2.0));
+    REQUIRE(ccsd::flops::W_abef(2.0, 3.0) == ccsd::flops::W_mnij(3.0, 2.0));
+}
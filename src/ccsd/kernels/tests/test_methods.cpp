@@ -0,0 +1,170 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <ccsd/kernels/ccsd_kernels.h>
+#include <ccsd/kernels/ccsd_state.h>
+#include <ccsd/config/ccsd_config.h>
+#include <ccsd/kernels/tests/test_systems.h>
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using Catch::Approx;
+
+// ── helpers ──────────────────────────────────────────────────────────────────
+
+namespace {
+
+using ccsd::test::build_intermediates;
+using ccsd::test::initialize;
+using ccsd::test::pseudo_random_system;
+
+// D t2_next: the right-hand side of eq. (2) at the current amplitudes.
+std::vector<double> doubles_rhs(ccsd::CcsdState& s, ccsd::CcsdKernels& k, int o) {
+    build_intermediates(k);
+    k.compute_t2();
+    std::vector<double> out;
+    for (int a = o; a < s.n_spin_orbitals; ++a)
+        for (int b = o; b < s.n_spin_orbitals; ++b)
+            for (int i = 0; i < o; ++i)
+                for (int j = 0; j < o; ++j) out.push_back(s.denom_abij(a, b, i, j) * s.t2_next(a, b, i, j));
+    return out;
+}
+
+}  // namespace
+
+// ── CCD ──────────────────────────────────────────────────────────────────────
+
+TEST_CASE("CCD with singles off matches the CCSD kernels with T1 held at zero", "[methods]") {
+    for (const bool labelled : {false, true}) {
+        const ccsd::CcsdConfig cfg = pseudo_random_system(labelled);
+        ccsd::CcsdState full, ccd;
+        full.allocate(2 * cfg.n_spatial_orbitals);
+        ccd.allocate(2 * cfg.n_spatial_orbitals);
+        ccsd::CcsdKernels kf(full, cfg), kd(ccd, cfg);
+        kd.set_singles(false);
+        initialize(kf);
+        initialize(kd);
+
+        for (int iter = 0; iter < 5; ++iter) {
+            build_intermediates(kf);
+            kf.compute_t2();
+            kd.compute_F_ae();  kd.compute_F_mi();
+            kd.compute_W_mnij(); kd.compute_W_abef(); kd.compute_W_mbej();
+            kd.compute_t1();
+            kd.compute_t2();
+            for (std::size_t e = 0; e < ccd.t1_next.n_size(); ++e) REQUIRE(ccd.t1_next.raw()[e] == 0.0);
+            for (std::size_t e = 0; e < ccd.t2_next.n_size(); ++e)
+                REQUIRE(ccd.t2_next.raw()[e] == Approx(full.t2_next.raw()[e]).margin(1e-14));
+            full.t2 = full.t2_next;
+            ccd.t2  = ccd.t2_next;
+        }
+        REQUIRE(kd.compute_energy() == Approx(kf.compute_energy()).epsilon(1e-13));
+    }
+}
+
+// ── MP3 ──────────────────────────────────────────────────────────────────────
+
+TEST_CASE("MP3 energy equals the linear CCD residual contracted with first-order T2", "[methods]") {
+    // The CCD right-hand side is R(λ) = <ij||ab> + λ L + λ² Q at T2 = λ t(1),
+    // so L = (R(1) - R(-1)) / 2 and E(3) = ¼ Σ t(1) L.
+    for (const bool labelled : {false, true}) {
+        const ccsd::CcsdConfig cfg = pseudo_random_system(labelled);
+        const int o = cfg.n_occupied;
+        ccsd::CcsdState s;
+        s.allocate(2 * cfg.n_spatial_orbitals);
+        ccsd::CcsdKernels k(s, cfg);
+        k.set_singles(false);
+        initialize(k);
+        const ccsd::Vector4D first = s.t2;
+        const double e3 = k.compute_mp3_energy();
+
+        const std::vector<double> plus = doubles_rhs(s, k, o);
+        for (std::size_t e = 0; e < s.t2.n_size(); ++e) s.t2.raw()[e] = -first.raw()[e];
+        const std::vector<double> minus = doubles_rhs(s, k, o);
+
+        double expected = 0.0;
+        std::size_t q = 0;
+        for (int a = o; a < s.n_spin_orbitals; ++a)
+            for (int b = o; b < s.n_spin_orbitals; ++b)
+                for (int i = 0; i < o; ++i)
+                    for (int j = 0; j < o; ++j, ++q)
+                        expected += 0.25 * first(a, b, i, j) * 0.5 * (plus[q] - minus[q]);
+        REQUIRE(std::abs(e3) > 1e-6);
+        REQUIRE(e3 == Approx(expected).epsilon(1e-12));
+    }
+}
+
+TEST_CASE("MP3 row partials sum to E(3) however the rows are split", "[methods]") {
+    for (const bool labelled : {false, true}) {
+        const ccsd::CcsdConfig cfg = pseudo_random_system(labelled);
+        ccsd::CcsdState s;
+        s.allocate(2 * cfg.n_spatial_orbitals);
+        ccsd::CcsdKernels k(s, cfg);
+        k.set_singles(false);
+        initialize(k);
+        const double e3 = k.compute_mp3_energy();
+
+        // Uneven row tiles, one of them empty, as the ranks would hold them.
+        const int n_virt = s.n_spin_orbitals - cfg.n_occupied;
+        std::vector<double> partial(static_cast<std::size_t>(n_virt), 0.0);
+        for (const auto& [begin, end] : {std::pair{0, 3}, std::pair{3, 3}, std::pair{3, n_virt}})
+            k.compute_mp3_partials(begin, end, partial);
+        double sum = 0.0;
+        for (double x : partial) sum += x;
+        REQUIRE(sum == e3);
+    }
+}
+
+// ── CC2 ──────────────────────────────────────────────────────────────────────
+
+TEST_CASE("CC2 doubles equal the CCSD doubles equation at T2 = 0", "[methods]") {
+    // With T2 = 0 every term of eq. (2) is a product of T1 and <pq||rs>:
+    // exactly the T1-transformed integral <ab||ij>~ over D.
+    for (const bool labelled : {false, true}) {
+        const ccsd::CcsdConfig cfg = pseudo_random_system(labelled);
+        const int o = cfg.n_occupied;
+        ccsd::CcsdState s;
+        s.allocate(2 * cfg.n_spatial_orbitals);
+        ccsd::CcsdKernels k(s, cfg);
+        initialize(k);
+        ccsd::test::iterate(s, k, 3);   // a realistic, symmetry-allowed T1
+        s.t2.zeros();
+
+        k.compute_t2_cc2();
+        const ccsd::Vector4D cc2 = s.t2_next;
+        build_intermediates(k);
+        k.compute_t2();
+        double largest = 0.0;
+        for (int a = o; a < s.n_spin_orbitals; ++a)
+            for (int b = o; b < s.n_spin_orbitals; ++b)
+                for (int i = 0; i < o; ++i)
+                    for (int j = 0; j < o; ++j) {
+                        largest = std::max(largest, std::abs(cc2(a, b, i, j)));
+                        REQUIRE(cc2(a, b, i, j) == Approx(s.t2_next(a, b, i, j)).margin(1e-13));
+                    }
+        REQUIRE(largest > 1e-4);
+    }
+}
+
+TEST_CASE("CC2 doubles built by tiles match the full build", "[methods]") {
+    for (const bool labelled : {false, true}) {
+        const ccsd::CcsdConfig cfg = pseudo_random_system(labelled);
+        ccsd::CcsdState s;
+        s.allocate(2 * cfg.n_spatial_orbitals);
+        ccsd::CcsdKernels k(s, cfg);
+        initialize(k);
+        ccsd::test::iterate(s, k, 3);
+        k.compute_t2_cc2();
+        const ccsd::Vector4D full = s.t2_next;
+
+        // Tiles that start and end inside a row of pairs, as the ranks' do.
+        const int n_virt = s.n_spin_orbitals - cfg.n_occupied;
+        s.t2_next.zeros();
+        for (const auto& [begin, end] : {std::pair{0, 5}, std::pair{5, 13}, std::pair{13, n_virt * n_virt}})
+            k.compute_t2_cc2_tile(begin, end);
+        for (std::size_t e = 0; e < full.n_size(); ++e) REQUIRE(s.t2_next.raw()[e] == full.raw()[e]);
+    }
+}
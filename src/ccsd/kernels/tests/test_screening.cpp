@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <ccsd/kernels/ccsd_kernels.h>
+#include <ccsd/kernels/ccsd_screening.h>
+#include <ccsd/kernels/ccsd_state.h>
+#include <ccsd/config/ccsd_config.h>
+#include <ccsd/kernels/tests/test_systems.h>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using Catch::Approx;
+
+// ── helpers ──────────────────────────────────────────────────────────────────
+
+namespace {
+
+// The shared pseudo-random system with orbital_symmetry unset, so its
+// symmetry zeros are only found by the block norms.
+using ccsd::test::build_intermediates;
+using ccsd::test::pseudo_random_system;
+
+// CCSD correlation energy after `iterations` updates at `threshold`.
+double ccsd_energy(const ccsd::CcsdConfig& cfg, double threshold, ccsd::ScreeningStats* stats = nullptr,
+                   int iterations = 60) {
+    ccsd::CcsdState s;
+    s.allocate(2 * cfg.n_spatial_orbitals);
+    ccsd::CcsdKernels k(s, cfg);
+    k.set_screening(threshold);
+    ccsd::test::initialize(k);
+    ccsd::test::iterate(s, k, iterations);
+    if (stats) *stats = k.screening_stats();
+    return k.compute_energy();
+}
+
+}  // namespace
+
+// ── bounds ───────────────────────────────────────────────────────────────────
+
+TEST_CASE("ScreeningStats counts total and skipped work", "[screening]") {
+    ccsd::ScreeningStats st;
+    REQUIRE(st.fraction() == 0.0);
+    REQUIRE_FALSE(st.skip(1e-3, 1e-4, 10.0));
+    REQUIRE(st.skip(1e-5, 1e-4, 30.0));
+    REQUIRE(st.total == 40.0);
+    REQUIRE(st.skipped == 30.0);
+    REQUIRE(st.fraction() == Approx(0.75));
+    const double x[] = {0.5, -2.0, 1.0};
+    REQUIRE(ccsd::max_abs(x, 3) == 2.0);
+}
+
+// ── CCSD ─────────────────────────────────────────────────────────────────────
+
+TEST_CASE("Screening below every nonzero bound skips only exact zeros", "[screening]") {
+    // The spin- and symmetry-forbidden blocks have zero norm, so a tiny
+    // threshold already skips work without changing the energy.
+    const ccsd::CcsdConfig cfg = pseudo_random_system();
+    ccsd::ScreeningStats st;
+    const double e_full   = ccsd_energy(cfg, 0.0);
+    const double e_screen = ccsd_energy(cfg, 1e-300, &st);
+    REQUIRE(st.total > 0.0);
+    REQUIRE(st.fraction() > 0.0);
+    REQUIRE(e_screen == Approx(e_full).margin(1e-15));
+}
+
+TEST_CASE("A larger screening threshold skips more work at a bounded energy error", "[screening]") {
+    const ccsd::CcsdConfig cfg = pseudo_random_system();
+    const double e_full = ccsd_energy(cfg, 0.0);
+    double last = 0.0;
+    for (const double threshold : {1e-8, 1e-5, 1e-3}) {
+        ccsd::ScreeningStats st;
+        const double e = ccsd_energy(cfg, threshold, &st);
+        REQUIRE(st.fraction() >= last);
+        REQUIRE(std::abs(e - e_full) < 10.0 * threshold);
+        last = st.fraction();
+    }
+}
+
+TEST_CASE("Screened T2 from streamed <ab||ef> slabs matches the in-core W_abef", "[screening]") {
+    // Both paths bound the τ·<mn||ef> ladder and the W_ab rows the same way.
+    const ccsd::CcsdConfig cfg = pseudo_random_system();
+    const int o = cfg.n_occupied;
+    const int n_virt = 2 * cfg.n_spatial_orbitals - o;
+    ccsd::CcsdState s;
+    s.allocate(2 * cfg.n_spatial_orbitals);
+    ccsd::CcsdKernels k(s, cfg);
+    k.set_screening(1e-3);
+    ccsd::test::initialize(k);
+    ccsd::test::iterate(s, k, 3);
+    build_intermediates(k);
+    k.compute_t2();
+    const ccsd::Vector4D in_core = s.t2_next;
+
+    const auto nv2 = static_cast<std::size_t>(n_virt) * static_cast<std::size_t>(n_virt);
+    std::vector<double> slabs(static_cast<std::size_t>(n_virt * n_virt) * nv2);
+    for (int pair = 0; pair < n_virt * n_virt; ++pair) k.build_vvvv_slab(pair, slabs.data() + static_cast<std::size_t>(pair) * nv2);
+    s.t2_next.zeros();
+    k.prepare_t2_tiles();
+    k.compute_t2_tile(0, n_virt * n_virt, slabs.data());
+    for (std::size_t e = 0; e < in_core.n_size(); ++e)
+        REQUIRE(s.t2_next.raw()[e] == Approx(in_core.raw()[e]).margin(1e-14));
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <ccsd/kernels/ccsd_kernels.h>
+#include <ccsd/kernels/ccsd_state.h>
+#include <ccsd/config/ccsd_config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Fixtures shared by the kernel tests (and test_fno): a small symmetric
+// system with pseudo-random integrals, and the steps of a CCSD iteration.
+namespace ccsd::test {
+
+// One spatial orbital per entry of `energies`, two doubly occupied, in
+// irreps {1,2,1,2,...}; pseudo-random integrals that vanish unless the
+// irreps multiply to 1. With `labelled` orbital_symmetry is set and the
+// kernels run symmetry-blocked; otherwise the zeros are only in the values.
+inline CcsdConfig pseudo_random_system(bool labelled = false,
+                                       std::vector<double> energies = {-1.0, -0.8, 0.6, 0.9, 1.2, 1.5}) {
+    CcsdConfig c{CcsdConfig::direct_init{}};
+    const int n = static_cast<int>(energies.size());
+    c.n_spatial_orbitals = n;
+    c.n_occupied         = 4;
+    c.orbital_energies   = std::move(energies);
+    std::vector<int> orbsym(static_cast<std::size_t>(n));
+    for (std::size_t p = 0; p < orbsym.size(); ++p) orbsym[p] = 1 + static_cast<int>(p % 2);
+    const auto g = [&](int p) { return orbsym[static_cast<std::size_t>(p - 1)] - 1; };
+    for (int a = 1; a <= n; ++a)
+        for (int b = 1; b <= a; ++b)
+            for (int c2 = 1; c2 <= n; ++c2)
+                for (int d = 1; d <= c2; ++d) {
+                    if ((g(a) ^ g(b) ^ g(c2) ^ g(d)) != 0) continue;
+                    const double key = compound_index(a, b, c2, d);
+                    const double x   = std::sin(12.9898 * key) * 43758.5453;
+                    c.two_electron_mos.insert(key, (a == b && c2 == d ? 0.3 : 0.0) + 0.1 * (x - std::floor(x) - 0.5));
+                }
+    c.two_electron_mos.finalize();
+    if (labelled) c.orbital_symmetry = std::move(orbsym);
+    c.validate();
+    return c;
+}
+
+// Integrals, Fock matrix, first-order T2, denominators and, with
+// screening set, the integral block norms.
+inline void initialize(CcsdKernels& k) {
+    k.build_spin_integrals();
+    k.build_fock_spin();
+    k.guess_t2();
+    k.build_denominators();
+    k.build_screening_norms();
+}
+
+inline void build_intermediates(CcsdKernels& k) {
+    k.compute_F_ae();  k.compute_F_mi();  k.compute_F_me();
+    k.compute_W_mnij(); k.compute_W_abef(); k.compute_W_mbej();
+}
+
+// `iterations` CCSD updates (intermediates, then T1/T2 from them); returns
+// the largest amplitude change of the last one.
+inline double iterate(CcsdState& s, CcsdKernels& k, int iterations = 1) {
+    double change = 0.0;
+    for (int iter = 0; iter < iterations; ++iter) {
+        build_intermediates(k);
+        k.compute_t1();
+        k.compute_t2();
+        change = 0.0;
+        for (std::size_t e = 0; e < s.t1.n_size(); ++e) change = std::max(change, std::abs(s.t1_next.raw()[e] - s.t1.raw()[e]));
+        for (std::size_t e = 0; e < s.t2.n_size(); ++e) change = std::max(change, std::abs(s.t2_next.raw()[e] - s.t2.raw()[e]));
+        s.t1 = s.t1_next;
+        s.t2 = s.t2_next;
+    }
+    return change;
+}
+
+}  // namespace ccsd::test
@@ -0,0 +1,139 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <ccsd/kernels/ccsd_triples.h>
+#include <ccsd/kernels/ccsd_state.h>
+#include <ccsd/kernels/ccsd_symmetry.h>
+#include <ccsd/config/ccsd_config.h>
+#include <ccsd/config/integral_table.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using Catch::Approx;
+
+// ── helpers ──────────────────────────────────────────────────────────────────
+
+// Deterministic pseudo-random value in [-0.5, 0.5).
+static double noise(int a, int b, int c, int d) {
+    const double x = std::sin(12.9898 * a + 78.233 * b + 37.719 * c + 4.581 * d) * 43758.5453;
+    return x - std::floor(x) - 0.5;
+}
+
+// State with antisymmetric <pq||rs> (real, 8-fold up to sign), antisymmetric
+// t2, random t1, and a gapped Fock diagonal; every element whose spin and
+// `orbsym` labels do not XOR to 0 is zero, as in a real CCSD state.
+static ccsd::CcsdState make_state(int o, int v, const std::vector<int>& orbsym = {}) {
+    ccsd::CcsdState s;
+    const int n = o + v;
+    s.allocate(n);
+    const ccsd::SpinOrbitalSymmetry sym(orbsym, n, o);
+    // Chemist (pr|qs) seeded by its 8-fold symmetric compound index.
+    auto chem = [](int p, int r, int q, int t) {
+        const double key = ccsd::compound_index(p, r, q, t);
+        return noise(static_cast<int>(key), 1, 2, 3);
+    };
+    for (int p = 0; p < n; ++p)
+        for (int q = 0; q < n; ++q)
+            for (int r = 0; r < n; ++r)
+                for (int t = 0; t < n; ++t)
+                    if (sym.allowed(p, q, r, t)) s.spin_integrals(p, q, r, t) = chem(p, r, q, t) - chem(p, t, q, r);
+    for (int a = o; a < n; ++a)
+        for (int b = o; b < n; ++b)
+            for (int i = 0; i < o; ++i)
+                for (int j = 0; j < o; ++j) {
+                    if (!sym.allowed(a, b, i, j)) continue;
+                    auto raw = [](int x, int y, int k, int l) { return 0.1 * noise(x, y, k, l); };
+                    s.t2(a, b, i, j) = raw(a, b, i, j) - raw(b, a, i, j) - raw(a, b, j, i) + raw(b, a, j, i);
+                }
+    for (int a = o; a < n; ++a)
+        for (int i = 0; i < o; ++i)
+            if (sym.allowed(a, i)) s.t1(a, i) = 0.05 * noise(a, i, 7, 9);
+    for (int p = 0; p < n; ++p) s.fock_spin(p, p) = p < o ? -1.0 - 0.1 * p : 0.5 + 0.2 * (p - o);
+    return s;
+}
+
+static ccsd::CcsdConfig make_config(int o, int v, std::vector<int> orbsym = {}) {
+    ccsd::CcsdConfig c{ccsd::CcsdConfig::direct_init{}};
+    c.n_spatial_orbitals = (o + v) / 2;
+    c.n_occupied         = o;
+    c.orbital_symmetry   = std::move(orbsym);
+    return c;
+}
+
+// Textbook (T): (1/36) Σ over all ijkabc, P operators applied literally.
+static double reference_triples(const ccsd::CcsdState& s, int o, int v) {
+    const int n = o + v;
+    const auto& g = s.spin_integrals;
+    auto conn = [&](int i, int j, int k, int a, int b, int c) {
+        double x = 0.0;
+        for (int e = o; e < n; ++e) x += s.t2(a, e, j, k) * g(e, i, b, c);
+        for (int m = 0; m < o; ++m) x -= s.t2(b, c, i, m) * g(m, a, j, k);
+        return x;
+    };
+    auto disc = [&](int i, int j, int k, int a, int b, int c) { return s.t1(a, i) * g(j, k, b, c); };
+    auto P = [](auto f, int i, int j, int k, int a, int b, int c) {
+        auto pa = [&](int ii, int jj, int kk) { return f(ii, jj, kk, a, b, c) - f(ii, jj, kk, b, a, c) - f(ii, jj, kk, c, b, a); };
+        return pa(i, j, k) - pa(j, i, k) - pa(k, j, i);
+    };
+    double e = 0.0;
+    for (int i = 0; i < o; ++i) for (int j = 0; j < o; ++j) for (int k = 0; k < o; ++k)
+    for (int a = o; a < n; ++a) for (int b = o; b < n; ++b) for (int c = o; c < n; ++c) {
+        const double d = s.fock_spin(i, i) + s.fock_spin(j, j) + s.fock_spin(k, k)
+                       - s.fock_spin(a, a) - s.fock_spin(b, b) - s.fock_spin(c, c);
+        const double w  = P(conn, i, j, k, a, b, c);
+        const double dv = P(disc, i, j, k, a, b, c);
+        e += w * (w + dv) / d;
+    }
+    return e / 36.0;
+}
+
+// ── tests ────────────────────────────────────────────────────────────────────
+
+TEST_CASE("TriplesKernels matches the unrestricted textbook (T) sum", "[kernels][triples]") {
+    for (auto [o, v] : {std::pair{3, 4}, std::pair{4, 4}, std::pair{3, 5}}) {
+        const auto s   = make_state(o, v);
+        const auto cfg = make_config(o, v);
+        const ccsd::TriplesKernels t(s, cfg);
+        const double ref = reference_triples(s, o, v);
+        REQUIRE(ref != 0.0);
+        REQUIRE(t.compute_energy() == Approx(ref).epsilon(1e-12));
+    }
+}
+
+TEST_CASE("TriplesKernels restricted to symmetry-allowed labels matches the textbook sum", "[kernels][triples]") {
+    // Irreps {1,2,1,2,...}: the e, m and c loops visit a quarter of the virtuals.
+    const int o = 4, v = 8;
+    std::vector<int> orbsym((o + v) / 2);
+    for (std::size_t p = 0; p < orbsym.size(); ++p) orbsym[p] = 1 + static_cast<int>(p % 2);
+    const auto s = make_state(o, v, orbsym);
+    const ccsd::TriplesKernels t(s, make_config(o, v, orbsym));
+    const double ref = reference_triples(s, o, v);
+    REQUIRE(ref != 0.0);
+    REQUIRE(t.compute_energy() == Approx(ref).epsilon(1e-12));
+}
+
+TEST_CASE("TriplesKernels tiles reproduce the full sum bit for bit", "[kernels][triples]") {
+    const auto s   = make_state(5, 4);
+    const auto cfg = make_config(5, 4);
+    const ccsd::TriplesKernels t(s, cfg);
+    REQUIRE(t.n_triples() == 10);
+
+    std::vector<double> e(10);
+    t.compute_tile(0, 3, e.data());
+    t.compute_tile(3, 10, e.data() + 3);
+    double sum = 0.0;
+    for (double x : e) sum += x;
+    REQUIRE(sum == t.compute_energy());
+}
+
+TEST_CASE("TriplesKernels is zero when fewer than three occupied orbitals", "[kernels][triples]") {
+    const auto s   = make_state(2, 4);
+    const auto cfg = make_config(2, 4);
+    const ccsd::TriplesKernels t(s, cfg);
+    REQUIRE(t.n_triples() == 0);
+    REQUIRE(t.compute_energy() == 0.0);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <utility>
+
+namespace ccsd::mpi {
+
+// Owning handle for a communicator produced by MPI_Comm_split*. Frees the
+// communicator on destruction; never frees MPI_COMM_WORLD/MPI_COMM_SELF.
+class Communicator {
+public:
+    Communicator() = default;
+    explicit Communicator(MPI_Comm comm) noexcept : comm_(comm) {}
+
+    ~Communicator() { release(); }
+
+    Communicator(const Communicator&) = delete;
+    Communicator& operator=(const Communicator&) = delete;
+    Communicator(Communicator&& other) noexcept
+        : comm_(std::exchange(other.comm_, MPI_COMM_NULL)) {}
+    Communicator& operator=(Communicator&& other) noexcept {
+        if (this != &other) {
+            release();
+            comm_ = std::exchange(other.comm_, MPI_COMM_NULL);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] MPI_Comm get() const noexcept { return comm_; }
+    [[nodiscard]] int rank() const { int r = 0; MPI_Comm_rank(comm_, &r); return r; }
+    [[nodiscard]] int size() const { int s = 0; MPI_Comm_size(comm_, &s); return s; }
+
+private:
+    MPI_Comm comm_ = MPI_COMM_NULL;
+
+    void release() noexcept {
+        if (comm_ != MPI_COMM_NULL && comm_ != MPI_COMM_WORLD && comm_ != MPI_COMM_SELF)
+            MPI_Comm_free(&comm_);
+        comm_ = MPI_COMM_NULL;
+    }
+};
+
+// Ranks of `parent` that share a node (shared-memory domain).
+inline Communicator split_node_local(MPI_Comm parent) {
+    MPI_Comm out = MPI_COMM_NULL;
+    int rank = 0;
+    MPI_Comm_rank(parent, &rank);
+    MPI_Comm_split_type(parent, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &out);
+    return Communicator(out);
+}
+
+// One communicator per node-local rank index: rank k of every node joins
+// inter-node group k. Group 0 is the usual "node leaders" communicator.
+inline Communicator split_inter_node(MPI_Comm parent) {
+    Communicator local = split_node_local(parent);
+    int rank = 0;
+    MPI_Comm_rank(parent, &rank);
+    MPI_Comm out = MPI_COMM_NULL;
+    MPI_Comm_split(parent, local.rank(), rank, &out);
+    return Communicator(out);
+}
+
+// Partitions `parent` into `n_groups` contiguous blocks of ranks, e.g. to run
+// several independent CCSD solves side by side. Returns this rank's group
+// communicator; `group_id` receives the block index.
+inline Communicator split_groups(MPI_Comm parent, int n_groups, int* group_id = nullptr) {
+    int rank = 0, size = 0;
+    MPI_Comm_rank(parent, &rank);
+    MPI_Comm_size(parent, &size);
+    if (n_groups < 1) n_groups = 1;
+    if (n_groups > size) n_groups = size;
+    const int color = static_cast<int>(static_cast<long long>(rank) * n_groups / size);
+    if (group_id) *group_id = color;
+    MPI_Comm out = MPI_COMM_NULL;
+    MPI_Comm_split(parent, color, rank, &out);
+    return Communicator(out);
+}
+
+}  // namespace ccsd::mpi
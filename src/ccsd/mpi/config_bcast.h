@@ -0,0 +1,84 @@
+#pragma once
+
+#include <mpi.h>
+#include <ccsd/config/cholesky.h>
+#include <ccsd/config/load_config.h>
+#include <ccsd/mpi/tensor_ops.h>
+
+#include <cstdint>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ccsd::mpi {
+
+// Parses `path` (JSON or FCIDUMP, see load_config) on `root` only and broadcasts the result: first the header
+// blob (scalars + orbital energies), then the sorted integral keys and
+// values in pipelined chunks. Other ranks never touch the file. Collective
+// over `comm`; a parse failure on root is rethrown on every rank.
+inline void load_and_broadcast_config(CcsdConfig& cfg, const std::string& path, int root,
+                                      MPI_Comm comm = MPI_COMM_WORLD,
+                                      const TransferOptions& opt = {}) {
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+
+    std::vector<std::byte> blob;
+    std::string error;
+    if (rank == root) {
+        try {
+            cfg = load_config(path);
+            blob = cfg.header_blob();
+        } catch (const std::exception& ex) {
+            error = ex.what();
+        }
+    }
+
+    // Blob size 0 signals failure on root.
+    std::uint64_t n_bytes = blob.size();
+    MPI_Bcast(&n_bytes, 1, MPI_UINT64_T, root, comm);
+    if (n_bytes == 0)
+        throw std::runtime_error(rank == root ? error : "config load failed on root rank");
+
+    blob.resize(static_cast<std::size_t>(n_bytes));
+    MPI_Bcast(blob.data(), static_cast<int>(n_bytes), MPI_BYTE, root, comm);
+    const std::size_t n_tei = rank == root ? cfg.two_electron_mos.size() : cfg.read_header_blob(blob);
+
+    detail::bcast(cfg.two_electron_mos.key_data(), n_tei, root, comm, opt);
+    detail::bcast(cfg.two_electron_mos.value_data(), n_tei, root, comm, opt);
+    if (rank != root) cfg.validate();
+}
+
+// Reads a binary Cholesky vector file (see read_cholesky) on `root` and
+// broadcasts it the same way. Collective over `comm`.
+inline CholeskyVectors load_and_broadcast_cholesky(const std::string& path, int root,
+                                                   MPI_Comm comm = MPI_COMM_WORLD,
+                                                   const TransferOptions& opt = {}) {
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+
+    CholeskyVectors L;
+    std::string error;
+    std::int64_t dims[2] = {-1, 0};   // n_orbitals -1 signals failure on root
+    if (rank == root) {
+        try {
+            L = read_cholesky(path);
+            dims[0] = L.n_orbitals();
+            dims[1] = L.n_vectors();
+        } catch (const std::exception& ex) {
+            error = ex.what();
+        }
+    }
+    MPI_Bcast(dims, 2, MPI_INT64_T, root, comm);
+    if (dims[0] < 0)
+        throw std::runtime_error(rank == root ? error : "cholesky load failed on root rank");
+
+    const auto n = static_cast<std::size_t>(dims[0]);
+    std::vector<double> data = rank == root ? L.data()
+                                            : std::vector<double>(n * (n + 1) / 2 * static_cast<std::size_t>(dims[1]));
+    detail::bcast(data.data(), data.size(), root, comm, opt);
+    return {static_cast<int>(dims[0]), static_cast<int>(dims[1]), std::move(data)};
+}
+
+}  // namespace ccsd::mpi
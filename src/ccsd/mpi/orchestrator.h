@@ -1,25 +1,54 @@
 #pragma once
 
 #include <ccsd/kernels/ccsd_state.h>
+#include <ccsd/mpi/rma_tensor.h>
+#include <ccsd/mpi/rma_window.h>
 #include <ccsd/mpi/session.h>
+#include <ccsd/mpi/task_counter.h>
 #include <ccsd/mpi/tensor_ops.h>
+#include <util/timing/trace.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
 
 namespace ccsd {
 
+// Half-open index range [begin, end) owned by one rank.
+struct TileRange {
+    int begin = 0;
+    int end   = 0;
+};
+
 class MpiOrchestrator {
 public:
     MpiClass mpi;
+    ccsd::mpi::TransferOptions transfer;   // chunking for tensor broadcasts
+    timing::TraceRecorder* trace = nullptr; // optional: each transfer below becomes a comm event
 
     // Derives rank_start from size; must be called before any other method.
-    void configure(int size, int rank) {
+    // All collectives and point-to-point transfers run on `comm`. One-sided
+    // transfers use `window` when given (created over `comm` or a parent of
+    // it, see RmaWindow), else a window over `comm` opened on first use.
+    void configure(int size, int rank, MPI_Comm comm = MPI_COMM_WORLD,
+                   ccsd::mpi::RmaWindow* window = nullptr) {
         mpi.size    = size;
         mpi.rank    = rank;
+        mpi.comm    = comm;
         rank_master_ = 0;
         rank_start_  = (size == 1) ? 0 : 1;
+        window_      = window;
     }
 
     [[nodiscard]] int master() const noexcept { return rank_master_; }
     [[nodiscard]] int start()  const noexcept { return rank_start_; }
+    // The W intermediates are stored on this rank. W_mnij and W_mbej always
+    // live whole on rank_start, as does W_abef unless it is rebuilt from
+    // per-rank <ab||ef> slabs (CcsdState::W_abef_from_slabs).
+    [[nodiscard]] bool owns_W() const noexcept { return mpi.rank == rank_start_; }
 
     void assign_tensor_owners(CcsdState& state) const {
         state.F_ae.rank = rank_start_;  state.F_me.rank = rank_start_;
@@ -27,42 +56,366 @@ public:
         state.W_mnij.rank = rank_start_; state.W_abef.rank = rank_start_;
     }
 
-    void gather_F_to_master(CcsdState& state) const {
+    // Splits the virtual index (T1) and virtual-pair index (T2) into one
+    // contiguous tile per rank. Must be called once n_occ/n_so are known.
+    void configure_amplitude_tiles(int n_occ, int n_so) {
+        n_occ_  = n_occ;
+        n_virt_ = n_so - n_occ;
+        const int n_pairs = n_virt_ * n_virt_;
+        t1_counts_.assign(static_cast<std::size_t>(mpi.size), 0);
+        t1_displs_.assign(static_cast<std::size_t>(mpi.size), 0);
+        t2_counts_.assign(static_cast<std::size_t>(mpi.size), 0);
+        t2_displs_.assign(static_cast<std::size_t>(mpi.size), 0);
+        for (int r = 0; r < mpi.size; ++r) {
+            const auto ur = static_cast<std::size_t>(r);
+            TileRange v  = block_range(n_virt_, r);
+            TileRange pq = block_range(n_pairs, r);
+            t1_counts_[ur] = v.end - v.begin;
+            t1_displs_[ur] = v.begin;
+            t2_counts_[ur] = pq.end - pq.begin;
+            t2_displs_[ur] = pq.begin;
+        }
+        t1_tile_ = block_range(n_virt_, mpi.rank);
+        t2_tile_ = block_range(n_pairs, mpi.rank);
+    }
+
+    [[nodiscard]] TileRange t1_tile() const noexcept { return t1_tile_; }
+    [[nodiscard]] TileRange t2_tile() const noexcept { return t2_tile_; }
+
+    // F intermediates are O(n^2): every rank simply receives a full copy.
+    void broadcast_F(CcsdState& state) const {
+        timing::ScopedTrace scope(trace, "bcast F", timing::TraceCategory::comm);
         if (mpi.size == 1) return;
-        send_2d(state.F_ae, state.F_ae.rank, rank_master_);
-        send_2d(state.F_me, state.F_me.rank, rank_master_);
-        send_2d(state.F_mi, state.F_mi.rank, rank_master_);
+        ccsd::mpi::bcast(state.F_ae, state.F_ae.rank, mpi.comm, transfer);
+        ccsd::mpi::bcast(state.F_me, state.F_me.rank, mpi.comm, transfer);
+        ccsd::mpi::bcast(state.F_mi, state.F_mi.rank, mpi.comm, transfer);
     }
 
-    void gather_W_to_master(CcsdState& state) const {
+    // Attaches the owner's W intermediates to the RMA window and sizes the
+    // buffers other ranks fetch their slices into (recorded in
+    // state.memory). Collective; call after allocate() (W buffers must not
+    // reallocate until release_W). A W_abef rebuilt from slabs is never
+    // stored, so it is not exposed.
+    void expose_W(CcsdState& state) {
+        release_W();
         if (mpi.size == 1) return;
-        send_4d(state.W_abef, state.W_abef.rank, rank_master_);
-        send_4d(state.W_mbej, state.W_mbej.rank, rank_master_);
-        send_4d(state.W_mnij, state.W_mnij.rank, rank_master_);
+        ccsd::mpi::RmaWindow& win = window();
+        if (!state.W_abef_from_slabs)
+            rma_W_abef_ = std::make_unique<ccsd::mpi::RmaTensor>(win, state.W_abef, state.W_abef.rank, mpi.comm);
+        rma_W_mbej_ = std::make_unique<ccsd::mpi::RmaTensor>(win, state.W_mbej, state.W_mbej.rank, mpi.comm);
+        rma_W_mnij_ = std::make_unique<ccsd::mpi::RmaTensor>(win, state.W_mnij, state.W_mnij.rank, mpi.comm);
+        if (owns_W()) return;
+        const auto o = static_cast<std::size_t>(n_occ_), v = static_cast<std::size_t>(n_virt_);
+        W_mbej_box_.assign(o * v * v * o, 0.0);
+        W_mnij_box_.assign(o * o * o * o, 0.0);
+        state.memory.record("W_mbej slice", W_mbej_box_.size() * sizeof(double));
+        state.memory.record("W_mnij slice", W_mnij_box_.size() * sizeof(double));
+        // One tile computing while the next is in flight.
+        if (rma_W_abef_) state.memory.record("W_abef planes", 2 * static_cast<std::size_t>(W_tile_pairs()) * v * v * sizeof(double));
+    }
+
+    // Detaches the W intermediates from the window. Collective; call before
+    // the exposed tensors are reallocated or freed.
+    void release_W() {
+        pending_W_.clear();
+        free_planes_.clear();
+        current_planes_ = {};
+        rma_W_abef_.reset();
+        rma_W_mbej_.reset();
+        rma_W_mnij_.reset();
+    }
+
+    // Creates the shared task counter on the master. Collective; call once.
+    // With a single rank tasks are counted locally and no window is used.
+    void expose_task_counter() {
+        tasks_.reset();
+        if (mpi.size > 1) tasks_ = std::make_unique<ccsd::mpi::TaskCounter>(window(), rank_master_, mpi.comm);
+    }
+
+    // Starts a new round of dynamically scheduled tasks: the next claim_task()
+    // on any rank returns 0. Collective over mpi.comm.
+    void begin_tasks() {
+        timing::ScopedTrace scope(trace, "task reset", timing::TraceCategory::comm);
+        local_next_task_ = 0;
+        if (tasks_) tasks_->reset();
+    }
+
+    // Next task index of the current round, unique across ranks. Callers stop
+    // at the first index past their task count.
+    [[nodiscard]] std::int64_t claim_task() {
+        timing::ScopedTrace scope(trace, "claim task", timing::TraceCategory::comm);
+        return tasks_ ? tasks_->next() : local_next_task_++;
+    }
+
+    // (a,b) pairs per W fetch tile: one row of fixed a, so the kernel still
+    // has a full row of pairs to thread over while the next row streams in.
+    [[nodiscard]] int W_tile_pairs() const noexcept { return std::max(n_virt_, 1); }
+
+    // Makes the owner's freshly computed W visible to the other ranks and
+    // starts this rank's fetches of the W_mbej / W_mnij slices (they land
+    // with the first tile). Collective over mpi.comm.
+    void begin_W_access() {
+        timing::ScopedTrace scope(trace, "W publish", timing::TraceCategory::comm);
+        if (!rma_W_mbej_) return;
+        if (rma_W_abef_) rma_W_abef_->publish();
+        rma_W_mbej_->publish();  rma_W_mnij_->publish();
+        MPI_Barrier(mpi.comm);
+        boxes_requested_ = false;
+    }
+
+    // Posts non-blocking fetches of everything compute_t2_tile needs for the
+    // pairs in `tile`: the W_abef(a,b,:,:) planes and, with the first tile
+    // of the iteration, the W_mbej (o,v,v,o) and W_mnij (o,o,o,o) boxes.
+    // Fetches complete in FIFO order through wait_W_tile(). No-op on the owner.
+    void prefetch_W_tile(TileRange tile) {
+        timing::ScopedTrace scope(trace, "rget W tile", timing::TraceCategory::comm);
+        auto& pending = pending_W_.emplace_back();
+        if (!rma_W_mbej_ || owns_W()) return;
+        const int o = n_occ_, v = n_virt_;
+        if (!boxes_requested_) {
+            rma_W_mbej_->rget({{0, o, o, 0}, {o, v, v, o}}, W_mbej_box_.data(), pending.reqs);
+            rma_W_mnij_->rget({{0, 0, 0, 0}, {o, o, o, o}}, W_mnij_box_.data(), pending.reqs);
+            boxes_requested_ = true;
+        }
+        if (!rma_W_abef_) return;
+        const auto nv2 = static_cast<std::size_t>(v) * static_cast<std::size_t>(v);
+        if (!free_planes_.empty()) {
+            pending.planes = std::move(free_planes_.back());
+            free_planes_.pop_back();
+        }
+        pending.planes.resize(static_cast<std::size_t>(tile.end - tile.begin) * nv2);
+        for (int pair = tile.begin; pair < tile.end; ++pair)
+            rma_W_abef_->rget({{o + pair / v, o + pair % v, o, o}, {1, 1, v, v}},
+                              pending.planes.data() + static_cast<std::size_t>(pair - tile.begin) * nv2, pending.reqs);
+    }
+
+    // Blocks until the oldest prefetched tile has landed. Returns the W
+    // slices to compute it from, or null where W is stored (read it from
+    // the state). Valid until the next call.
+    [[nodiscard]] const WSlices* wait_W_tile() {
+        timing::ScopedTrace scope(trace, "wait W tile", timing::TraceCategory::comm);
+        PendingTile front = std::move(pending_W_.front());
+        pending_W_.pop_front();
+        MPI_Waitall(static_cast<int>(front.reqs.size()), front.reqs.data(), MPI_STATUSES_IGNORE);
+        if (!rma_W_mbej_ || owns_W()) return nullptr;
+        if (!current_planes_.empty()) free_planes_.push_back(std::move(current_planes_));
+        current_planes_ = std::move(front.planes);
+        const int o = n_occ_, v = n_virt_;
+        slices_.W_mbej = TensorView<4>::row_major(W_mbej_box_.data(), {o, v, v, o});
+        slices_.W_mnij = TensorView<4>::row_major(W_mnij_box_.data(), {o, o, o, o});
+        slices_.W_abef = rma_W_abef_ ? current_planes_.data() : nullptr;
+        return &slices_;
+    }
+
+    // Ends the iteration's reads; the trailing barrier keeps the owner from
+    // overwriting W for the next iteration while other ranks still read it.
+    void end_W_access() {
+        timing::ScopedTrace scope(trace, "W reads done", timing::TraceCategory::comm);
+        pending_W_.clear();
+        if (!rma_W_mbej_) return;
+        MPI_Barrier(mpi.comm);
+    }
+
+    // Exchanges the locally computed amplitude tiles so every rank ends up with
+    // the full t1_next/t2_next. Only the vo / vvoo blocks travel, packed in
+    // tile loop order (v,i) and (pair,i,j).
+    void allgather_amplitudes(CcsdState& state) const {
+        timing::ScopedTrace scope(trace, "allgather t1/t2", timing::TraceCategory::comm);
+        allgather_t1(state);
+        const auto n_o = static_cast<std::size_t>(n_occ_);
+        const auto n_v = static_cast<std::size_t>(n_virt_);
+        std::vector<double> t2_local, t2_all(n_v * n_v * n_o * n_o);
+        for (int pair = t2_tile_.begin; pair < t2_tile_.end; ++pair)
+            for (int i = 0; i < n_occ_; ++i)
+                for (int j = 0; j < n_occ_; ++j)
+                    t2_local.push_back(state.t2_next(n_occ_ + pair / n_virt_,
+                                                     n_occ_ + pair % n_virt_, i, j));
+        ccsd::mpi::allgatherv(t2_local, t2_all, t2_counts_, t2_displs_, n_occ_ * n_occ_, mpi.comm);
+
+        unpack_t2(state, t2_all);
+    }
+
+    // allgather_amplitudes for dynamically claimed T2 tiles: `tiles` are the
+    // pair ranges this rank computed. The ranks first exchange their tile
+    // lists, then only the computed vvoo rows travel, n_occ^2 doubles per
+    // pair; every pair has exactly one writer.
+    void allgather_amplitudes(CcsdState& state, const std::vector<TileRange>& tiles) const {
+        timing::ScopedTrace scope(trace, "allgather t1/t2", timing::TraceCategory::comm);
+        allgather_t1(state);
+        std::vector<double> t2_local;
+        for (const TileRange& tile : tiles)
+            for (int pair = tile.begin; pair < tile.end; ++pair)
+                for (int i = 0; i < n_occ_; ++i)
+                    for (int j = 0; j < n_occ_; ++j)
+                        t2_local.push_back(state.t2_next(n_occ_ + pair / n_virt_, n_occ_ + pair % n_virt_, i, j));
+        std::vector<TileRange> all_tiles;
+        std::vector<double> t2_all;
+        allgather_ranges(tiles, t2_local, n_occ_ * n_occ_, all_tiles, t2_all);
+
+        state.t2_next.zeros();
+        std::size_t k = 0;
+        for (const TileRange& tile : all_tiles)
+            for (int pair = tile.begin; pair < tile.end; ++pair)
+                for (int i = 0; i < n_occ_; ++i)
+                    for (int j = 0; j < n_occ_; ++j)
+                        state.t2_next(n_occ_ + pair / n_virt_, n_occ_ + pair % n_virt_, i, j) = t2_all[k++];
     }
 
-    void broadcast_amplitudes(CcsdState& state) const {
-        ccsd::mpi::bcast(state.t2_next, rank_master_);
-        ccsd::mpi::bcast(state.t1_next, rank_master_);
+    // Splits the (T) triple index [0, n_triples) into one contiguous tile per rank.
+    [[nodiscard]] TileRange triples_tile(int n_triples) const noexcept {
+        return block_range(n_triples, mpi.rank);
+    }
+
+    // Collects every rank's per-triple energies into `all` (size n_triples),
+    // so each rank can sum them in triple order independent of np.
+    void allgather_triples(const std::vector<double>& local, std::vector<double>& all) const {
+        timing::ScopedTrace scope(trace, "allgather (T)", timing::TraceCategory::comm);
+        const auto n_triples = static_cast<int>(all.size());
+        std::vector<int> counts(static_cast<std::size_t>(mpi.size)), displs(counts.size());
+        for (int r = 0; r < mpi.size; ++r) {
+            const TileRange t = block_range(n_triples, r);
+            counts[static_cast<std::size_t>(r)] = t.end - t.begin;
+            displs[static_cast<std::size_t>(r)] = t.begin;
+        }
+        ccsd::mpi::allgatherv(local, all, counts, displs, 1, mpi.comm);
+    }
+
+    // allgather_triples for dynamically claimed chunks: `chunks` are the
+    // triple ranges this rank filled in `all`; the other entries are filled
+    // from the ranks that claimed them, as in allgather_amplitudes.
+    void allgather_triples(const std::vector<TileRange>& chunks, std::vector<double>& all) const {
+        timing::ScopedTrace scope(trace, "allgather (T)", timing::TraceCategory::comm);
+        if (mpi.size == 1) return;
+        std::vector<double> local;
+        for (const TileRange& c : chunks) local.insert(local.end(), all.begin() + c.begin, all.begin() + c.end);
+        std::vector<TileRange> all_chunks;
+        std::vector<double> values;
+        allgather_ranges(chunks, local, 1, all_chunks, values);
+        auto from = values.begin();
+        for (const TileRange& c : all_chunks) {
+            std::copy(from, from + (c.end - c.begin), all.begin() + c.begin);
+            from += c.end - c.begin;
+        }
     }
 
     void broadcast_scalar(double& value) const {
+        timing::ScopedTrace scope(trace, "bcast scalar", timing::TraceCategory::comm);
         // ccsd::mpi::bcast only handles Vector2D/4D; scalars go via raw MPI.
-        MPI_Bcast(&value, 1, MPI_DOUBLE, rank_master_, MPI_COMM_WORLD);
+        MPI_Bcast(&value, 1, MPI_DOUBLE, rank_master_, mpi.comm);
+    }
+
+    // Element-wise sum of `values` over the ranks, left on every rank.
+    void sum_values(std::vector<double>& values) const {
+        timing::ScopedTrace scope(trace, "allreduce values", timing::TraceCategory::comm);
+        MPI_Allreduce(MPI_IN_PLACE, values.data(), static_cast<int>(values.size()), MPI_DOUBLE, MPI_SUM, mpi.comm);
+    }
+
+    // Broadcasts `values` from `root`; every rank passes the same size.
+    void broadcast_values(std::vector<double>& values, int root) const {
+        timing::ScopedTrace scope(trace, "bcast values", timing::TraceCategory::comm);
+        MPI_Bcast(values.data(), static_cast<int>(values.size()), MPI_DOUBLE, root, mpi.comm);
     }
 
 private:
     int rank_master_ = 0;
     int rank_start_  = 0;
 
-    void send_2d(Vector2D& t, int src, int dst) const {
-        if (mpi.rank == src) ccsd::mpi::send(t, dst);
-        if (mpi.rank == dst) ccsd::mpi::recv(t, src);
+    int n_occ_       = 0;
+    int n_virt_      = 0;
+    TileRange t1_tile_{};
+    TileRange t2_tile_{};
+    std::vector<int> t1_counts_, t1_displs_;   // virtual rows (n_occ doubles) per rank
+    std::vector<int> t2_counts_, t2_displs_;   // (a,b) pairs (n_occ^2 doubles) per rank
+
+    // Declared before everything attached to it, so it is freed last.
+    std::unique_ptr<ccsd::mpi::RmaWindow> own_window_;   // opened when none was injected
+    ccsd::mpi::RmaWindow* window_ = nullptr;
+
+    std::unique_ptr<ccsd::mpi::TaskCounter> tasks_;   // null with one rank
+    std::int64_t local_next_task_ = 0;
+
+    struct PendingTile {
+        std::vector<MPI_Request> reqs;
+        std::vector<double>      planes;   // W_abef planes of the tile, pair order
+    };
+    std::unique_ptr<ccsd::mpi::RmaTensor> rma_W_abef_, rma_W_mbej_, rma_W_mnij_;
+    std::deque<PendingTile> pending_W_;           // one entry per prefetched tile
+    std::vector<std::vector<double>> free_planes_;
+    std::vector<double> current_planes_;          // the tile being computed
+    std::vector<double> W_mbej_box_, W_mnij_box_; // fetched slices, non-owners only
+    WSlices slices_;
+    bool boxes_requested_ = false;
+
+    ccsd::mpi::RmaWindow& window() {
+        if (!window_) {
+            own_window_ = std::make_unique<ccsd::mpi::RmaWindow>(mpi.comm);
+            window_ = own_window_.get();
+        }
+        return *window_;
+    }
+
+    void allgather_t1(CcsdState& state) const {
+        std::vector<double> t1_local, t1_all(static_cast<std::size_t>(n_virt_) * static_cast<std::size_t>(n_occ_));
+        for (int v = t1_tile_.begin; v < t1_tile_.end; ++v)
+            for (int i = 0; i < n_occ_; ++i)
+                t1_local.push_back(state.t1_next(n_occ_ + v, i));
+        ccsd::mpi::allgatherv(t1_local, t1_all, t1_counts_, t1_displs_, n_occ_, mpi.comm);
+
+        state.t1_next.zeros();
+        std::size_t k = 0;
+        for (int v = 0; v < n_virt_; ++v)
+            for (int i = 0; i < n_occ_; ++i)
+                state.t1_next(n_occ_ + v, i) = t1_all[k++];
+    }
+
+    // Gathers every rank's `ranges` (index ranges, any order) and `local`,
+    // their values packed in that order with `block` doubles per index, into
+    // `all_ranges` / `all_values` on every rank, rank by rank. Counts travel
+    // in ranges and in blocks, so they stay within int range.
+    void allgather_ranges(const std::vector<TileRange>& ranges, const std::vector<double>& local, int block,
+                          std::vector<TileRange>& all_ranges, std::vector<double>& all_values) const {
+        const auto n = static_cast<std::size_t>(mpi.size);
+        std::vector<int> n_ranges(n), range_counts(n), range_displs(n), counts(n, 0), displs(n, 0);
+        const auto mine = static_cast<int>(ranges.size());
+        MPI_Allgather(&mine, 1, MPI_INT, n_ranges.data(), 1, MPI_INT, mpi.comm);
+        for (std::size_t r = 0; r < n; ++r) {
+            range_counts[r] = 2 * n_ranges[r];
+            range_displs[r] = r == 0 ? 0 : range_displs[r - 1] + range_counts[r - 1];
+        }
+        std::vector<int> flat, all_flat(static_cast<std::size_t>(range_displs.back() + range_counts.back()));
+        for (const TileRange& t : ranges) { flat.push_back(t.begin); flat.push_back(t.end); }
+        MPI_Allgatherv(flat.data(), 2 * mine, MPI_INT, all_flat.data(), range_counts.data(), range_displs.data(),
+                       MPI_INT, mpi.comm);
+
+        all_ranges.clear();
+        std::size_t next = 0;
+        for (std::size_t r = 0; r < n; ++r) {
+            for (int k = 0; k < n_ranges[r]; ++k, next += 2) {
+                all_ranges.push_back({all_flat[next], all_flat[next + 1]});
+                counts[r] += all_flat[next + 1] - all_flat[next];
+            }
+            displs[r] = r == 0 ? 0 : displs[r - 1] + counts[r - 1];
+        }
+        all_values.assign(static_cast<std::size_t>(displs.back() + counts.back()) * static_cast<std::size_t>(block), 0.0);
+        ccsd::mpi::allgatherv(local, all_values, counts, displs, block, mpi.comm);
+    }
+
+    // Writes the packed (pair,i,j) vvoo block back into t2_next.
+    void unpack_t2(CcsdState& state, const std::vector<double>& t2_all) const {
+        state.t2_next.zeros();
+        std::size_t k = 0;
+        for (int pair = 0; pair < n_virt_ * n_virt_; ++pair)
+            for (int i = 0; i < n_occ_; ++i)
+                for (int j = 0; j < n_occ_; ++j)
+                    state.t2_next(n_occ_ + pair / n_virt_, n_occ_ + pair % n_virt_, i, j) = t2_all[k++];
     }
 
-    void send_4d(Vector4D& t, int src, int dst) const {
-        if (mpi.rank == src) ccsd::mpi::send(t, dst);
-        if (mpi.rank == dst) ccsd::mpi::recv(t, src);
+    // Contiguous block split of [0, n): the first n % size ranks take one extra.
+    [[nodiscard]] TileRange block_range(int n, int r) const noexcept {
+        const int base  = n / mpi.size;
+        const int extra = n % mpi.size;
+        const int begin = r * base + (r < extra ? r : extra);
+        return {begin, begin + base + (r < extra ? 1 : 0)};
     }
 };
 
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <mpi.h>
+#include <ccsd/mpi/rma_window.h>
+#include <util/tensors/vector_4d.h>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace ccsd::mpi {
+
+// Half-open 4-D box [lo, lo + extent) of a Vector4D.
+struct Box4D {
+    std::array<int, 4> lo{};
+    std::array<int, 4> extent{};
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        std::size_t n = 1;
+        for (int e : extent) n *= static_cast<std::size_t>(e > 0 ? e : 0);
+        return n;
+    }
+};
+
+// Exposes the owner rank's Vector4D through an RmaWindow. Only the owner
+// stores the tensor; other ranks pull the boxes they need with MPI_Rget into
+// compact row-major buffers of their own. The owner broadcasts the tensor's
+// address and strides, so a non-owner needs neither its storage nor its
+// layout. Construction and destruction are collective over `comm`; the
+// owner's buffer must not reallocate in between.
+class RmaTensor {
+public:
+    RmaTensor(RmaWindow& win, Vector4D& t, int owner, MPI_Comm comm)
+        : win_(win), comm_(comm), owner_(owner) {
+        MPI_Comm_rank(comm_, &rank_);
+        target_ = win_.target(comm_, owner_);
+        std::array<MPI_Aint, 5> meta{};   // address, then the four element strides
+        if (is_local()) {
+            base_ = t.raw();
+            meta[0] = win_.attach(base_, t.n_size() * sizeof(double));
+            const auto s = t.view().strides;
+            for (std::size_t d = 0; d < 4; ++d) meta[d + 1] = static_cast<MPI_Aint>(s[d]);
+        }
+        MPI_Bcast(meta.data(), static_cast<int>(meta.size()), MPI_AINT, owner_, comm_);
+        address_ = meta[0];
+        for (std::size_t d = 0; d < 4; ++d) strides_[d] = meta[d + 1];
+    }
+
+    // The barrier keeps the owner from detaching while a fetch is in flight.
+    ~RmaTensor() {
+        MPI_Barrier(comm_);
+        if (is_local()) win_.detach(base_);
+    }
+
+    RmaTensor(const RmaTensor&) = delete;
+    RmaTensor& operator=(const RmaTensor&) = delete;
+    RmaTensor(RmaTensor&&) = delete;
+    RmaTensor& operator=(RmaTensor&&) = delete;
+
+    [[nodiscard]] bool is_local() const noexcept { return rank_ == owner_; }
+
+    // Owner: makes its writes since the last call visible to remote reads.
+    // Callers barrier on `comm` afterwards, before the first rget.
+    void publish() {
+        if (is_local()) MPI_Win_sync(win_.get());
+    }
+
+    // Posts a non-blocking fetch of `box` into `dst` (box.size() doubles,
+    // last index fastest). No-op on the owner.
+    void rget(const Box4D& box, double* dst, std::vector<MPI_Request>& reqs) const {
+        if (is_local() || box.size() == 0) return;
+        MPI_Aint disp = address_;
+        for (std::size_t d = 0; d < 4; ++d)
+            disp = MPI_Aint_add(disp, static_cast<MPI_Aint>(box.lo[d]) * strides_[d] * static_cast<MPI_Aint>(sizeof(double)));
+        // One datatype on each side: no MPI count exceeds a single extent,
+        // however large the box.
+        MPI_Datatype origin = compact_type(box);
+        MPI_Datatype type   = box_type(box);
+        MPI_Request req = MPI_REQUEST_NULL;
+        MPI_Rget(dst, 1, origin, target_, disp, 1, type, win_.get(), &req);
+        MPI_Type_free(&origin);
+        MPI_Type_free(&type);
+        reqs.push_back(req);
+    }
+
+private:
+    RmaWindow& win_;
+    MPI_Comm   comm_;
+    int        owner_;
+    int        rank_   = 0;
+    int        target_ = 0;                 // owner's rank in the window
+    void*      base_   = nullptr;           // owner only
+    MPI_Aint   address_ = 0;
+    std::array<MPI_Aint, 4> strides_{};     // owner's layout, in elements
+
+    // The compact row-major buffer the box lands in: nested contiguous
+    // types, innermost dimension first.
+    [[nodiscard]] static MPI_Datatype compact_type(const Box4D& box) {
+        MPI_Datatype type = MPI_DATATYPE_NULL;
+        MPI_Type_contiguous(1, MPI_DOUBLE, &type);
+        for (std::size_t d = 4; d-- > 0;) {
+            if (box.extent[d] <= 1) continue;
+            MPI_Datatype next = MPI_DATATYPE_NULL;
+            MPI_Type_contiguous(box.extent[d], type, &next);
+            MPI_Type_free(&type);
+            type = next;
+        }
+        MPI_Type_commit(&type);
+        return type;
+    }
+
+    // Nested hvectors, innermost dimension first, so the box is read in the
+    // order it is written to the compact buffer.
+    [[nodiscard]] MPI_Datatype box_type(const Box4D& box) const {
+        MPI_Datatype type = MPI_DATATYPE_NULL;
+        MPI_Type_contiguous(1, MPI_DOUBLE, &type);
+        for (std::size_t d = 4; d-- > 0;) {
+            if (box.extent[d] <= 1) continue;
+            MPI_Datatype next = MPI_DATATYPE_NULL;
+            MPI_Type_create_hvector(box.extent[d], 1, strides_[d] * static_cast<MPI_Aint>(sizeof(double)), type, &next);
+            MPI_Type_free(&type);
+            type = next;
+        }
+        MPI_Type_commit(&type);
+        return type;
+    }
+};
+
+}  // namespace ccsd::mpi
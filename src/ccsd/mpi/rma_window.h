@@ -0,0 +1,74 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+
+namespace ccsd::mpi {
+
+// One dynamic MPI-3 window (MPI_Win_create_dynamic) that the RMA-exposed
+// tensors and counters of a solve attach their memory to. Every rank holds
+// a shared lock_all epoch for the window's whole lifetime, so the users
+// synchronize with MPI_Win_sync / flush and barriers on their own
+// communicator instead of opening epochs.
+//
+// Only construction and destruction are collective (over the window's
+// communicator); attach, detach and access are not. That lets concurrent
+// solves on sub-communicators share one window created over their parent
+// communicator: the window is created once, before the groups start.
+// Windows created separately on congruent sub-communicators at the same
+// time can collide (Open MPI 4.1's osc/rdma names its shared-memory
+// segment by communicator id only, and split sub-communicators share one).
+class RmaWindow {
+public:
+    // A single rank has nobody to expose memory to, so no window is created
+    // (Open MPI's osc components also refuse a dynamic window there).
+    explicit RmaWindow(MPI_Comm comm) {
+        int size = 0;
+        MPI_Comm_size(comm, &size);
+        if (size == 1) return;
+        MPI_Win_create_dynamic(MPI_INFO_NULL, comm, &win_);
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+    }
+
+    ~RmaWindow() {
+        if (win_ == MPI_WIN_NULL) return;
+        MPI_Win_unlock_all(win_);
+        MPI_Win_free(&win_);
+    }
+
+    RmaWindow(const RmaWindow&) = delete;
+    RmaWindow& operator=(const RmaWindow&) = delete;
+    RmaWindow(RmaWindow&&) = delete;
+    RmaWindow& operator=(RmaWindow&&) = delete;
+
+    [[nodiscard]] MPI_Win get() const noexcept { return win_; }
+
+    // Exposes [base, base + bytes) of this rank; returns the displacement
+    // other ranks address it by.
+    [[nodiscard]] MPI_Aint attach(void* base, std::size_t bytes) {
+        MPI_Win_attach(win_, base, static_cast<MPI_Aint>(bytes));
+        MPI_Aint address = 0;
+        MPI_Get_address(base, &address);
+        return address;
+    }
+    void detach(const void* base) { MPI_Win_detach(win_, base); }
+
+    // Window rank of rank `rank` of `comm` (a sub-communicator of the
+    // window's communicator, or the same one).
+    [[nodiscard]] int target(MPI_Comm comm, int rank) const {
+        MPI_Group from = MPI_GROUP_NULL, to = MPI_GROUP_NULL;
+        MPI_Comm_group(comm, &from);
+        MPI_Win_get_group(win_, &to);
+        int out = MPI_UNDEFINED;
+        MPI_Group_translate_ranks(from, 1, &rank, to, &out);
+        MPI_Group_free(&from);
+        MPI_Group_free(&to);
+        return out;
+    }
+
+private:
+    MPI_Win win_ = MPI_WIN_NULL;
+};
+
+}  // namespace ccsd::mpi
@@ -4,15 +4,25 @@
 
 namespace ccsd {
 
+// Owns the MPI lifetime unless MPI was already initialized by a host
+// application, in which case the session only observes MPI_COMM_WORLD and
+// leaves MPI_Finalize to the host.
 class MpiSession {
 public:
     MpiSession(int* argc, char*** argv) {
-        MPI_Init(argc, argv);
+        int initialized = 0;
+        MPI_Initialized(&initialized);
+        if (!initialized) {
+            MPI_Init(argc, argv);
+            owns_mpi_ = true;
+        }
         MPI_Comm_size(MPI_COMM_WORLD, &size_);
         MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
     }
 
-    ~MpiSession() { MPI_Finalize(); }
+    ~MpiSession() {
+        if (owns_mpi_) MPI_Finalize();
+    }
 
     MpiSession(const MpiSession&) = delete;
     MpiSession& operator=(const MpiSession&) = delete;
@@ -21,17 +31,21 @@ public:
 
     [[nodiscard]] int rank() const noexcept { return rank_; }
     [[nodiscard]] int size() const noexcept { return size_; }
+    [[nodiscard]] MPI_Comm comm() const noexcept { return MPI_COMM_WORLD; }
 
 private:
     int rank_ = 0;
     int size_ = 0;
+    bool owns_mpi_ = false;
 };
 
 }  // namespace ccsd
 
 // Backwards-compat POD used by CcsdSolver for rank/size bookkeeping.
+// `comm` is the communicator the solve runs on (world or a sub-communicator).
 class MpiClass {
 public:
     int size = 0;
     int rank = 0;
+    MPI_Comm comm = MPI_COMM_WORLD;
 };
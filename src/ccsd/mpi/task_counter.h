@@ -0,0 +1,66 @@
+#pragma once
+
+#include <mpi.h>
+#include <ccsd/mpi/rma_window.h>
+
+#include <cstdint>
+
+namespace ccsd::mpi {
+
+// Shared work counter for dynamic scheduling: one 64-bit integer on the
+// owner, attached to an RmaWindow and advanced with MPI_Fetch_and_op, so
+// each index 0, 1, 2, ... goes to exactly one rank in whatever order the
+// ranks ask. A rank that finishes its task early simply claims the next
+// one, which keeps fast and slow ranks busy until the work runs out.
+// Construction, destruction and reset() are collective over `comm`.
+class TaskCounter {
+public:
+    TaskCounter(RmaWindow& win, int owner, MPI_Comm comm) : win_(win), owner_(owner), comm_(comm) {
+        MPI_Comm_rank(comm_, &rank_);
+        target_ = win_.target(comm_, owner_);
+        if (rank_ == owner_) address_ = win_.attach(&count_, sizeof(count_));
+        MPI_Bcast(&address_, 1, MPI_AINT, owner_, comm_);
+        reset();
+    }
+
+    ~TaskCounter() {
+        MPI_Barrier(comm_);
+        if (rank_ == owner_) win_.detach(&count_);
+    }
+
+    TaskCounter(const TaskCounter&) = delete;
+    TaskCounter& operator=(const TaskCounter&) = delete;
+    TaskCounter(TaskCounter&&) = delete;
+    TaskCounter& operator=(TaskCounter&&) = delete;
+
+    // Rewinds to 0, atomically like every claim. The trailing barrier keeps
+    // any rank from claiming before the rewind has landed.
+    void reset() {
+        if (rank_ == owner_) {
+            const std::int64_t zero = 0;
+            MPI_Accumulate(&zero, 1, MPI_INT64_T, target_, address_, 1, MPI_INT64_T, MPI_REPLACE, win_.get());
+            MPI_Win_flush(target_, win_.get());
+        }
+        MPI_Barrier(comm_);
+    }
+
+    // Claims the next index (atomic across ranks).
+    [[nodiscard]] std::int64_t next() {
+        const std::int64_t one = 1;
+        std::int64_t claimed = 0;
+        MPI_Fetch_and_op(&one, &claimed, MPI_INT64_T, target_, address_, MPI_SUM, win_.get());
+        MPI_Win_flush(target_, win_.get());
+        return claimed;
+    }
+
+private:
+    RmaWindow&   win_;
+    int          owner_;
+    MPI_Comm     comm_;
+    int          rank_    = 0;
+    int          target_  = 0;     // owner's rank in the window
+    MPI_Aint     address_ = 0;
+    std::int64_t count_   = 0;     // the counter itself, used on the owner only
+};
+
+}  // namespace ccsd::mpi
@@ -5,26 +5,108 @@
 #include <util/tensors/vector_4d.h>
 #include <ccsd/kernels/ccsd_constants.h>
 
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <vector>
+
 namespace ccsd::mpi {
 
-inline void send(Vector2D& t, int dst) {
-    MPI_Send(t.raw(), t.n_size(), MPI_DOUBLE, dst, ccsd::constants::mpi_tag_2d, MPI_COMM_WORLD);
+// All transfers run on `comm`; the default keeps single-job callers unchanged.
+
+// Tensors are moved in chunks of at most chunk_doubles with up to
+// max_outstanding non-blocking requests in flight, so sizes beyond INT_MAX
+// are safe and large tensors are pipelined instead of sent as one message.
+struct TransferOptions {
+    std::size_t chunk_doubles   = ccsd::constants::mpi_chunk_doubles;
+    int         max_outstanding = ccsd::constants::mpi_max_outstanding;
+};
+
+namespace detail {
+
+// Posts post(offset, count, &request) for consecutive chunks of [0, n) and
+// waits for all of them, never keeping more than max_outstanding in flight.
+// Chunks are posted in the same order on every rank, which is what MPI's
+// non-overtaking rule (p2p) and collective ordering (Ibcast) rely on.
+template <class Post>
+void pipeline(std::size_t n, const TransferOptions& opt, Post post) {
+    const std::size_t chunk = std::clamp<std::size_t>(opt.chunk_doubles, 1, INT_MAX);
+    const auto window = static_cast<std::size_t>(std::max(opt.max_outstanding, 1));
+    std::vector<MPI_Request> inflight;
+    inflight.reserve(window);
+    for (std::size_t off = 0; off < n; off += chunk) {
+        if (inflight.size() == window) {
+            int done = 0;
+            MPI_Waitany(static_cast<int>(inflight.size()), inflight.data(), &done, MPI_STATUS_IGNORE);
+            inflight.erase(inflight.begin() + done);
+        }
+        MPI_Request req = MPI_REQUEST_NULL;
+        post(off, static_cast<int>(std::min(chunk, n - off)), &req);
+        inflight.push_back(req);
+    }
+    MPI_Waitall(static_cast<int>(inflight.size()), inflight.data(), MPI_STATUSES_IGNORE);
 }
-inline void recv(Vector2D& t, int src) {
-    MPI_Recv(t.raw(), t.n_size(), MPI_DOUBLE, src, ccsd::constants::mpi_tag_2d, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+inline void send(const double* p, std::size_t n, int dst, int tag, MPI_Comm comm,
+                 const TransferOptions& opt) {
+    pipeline(n, opt, [&](std::size_t off, int count, MPI_Request* req) {
+        MPI_Isend(p + off, count, MPI_DOUBLE, dst, tag, comm, req);
+    });
+}
+inline void recv(double* p, std::size_t n, int src, int tag, MPI_Comm comm,
+                 const TransferOptions& opt) {
+    pipeline(n, opt, [&](std::size_t off, int count, MPI_Request* req) {
+        MPI_Irecv(p + off, count, MPI_DOUBLE, src, tag, comm, req);
+    });
 }
-inline void bcast(Vector2D& t, int src) {
-    MPI_Bcast(t.raw(), t.n_size(), MPI_DOUBLE, src, MPI_COMM_WORLD);
+inline void bcast(double* p, std::size_t n, int src, MPI_Comm comm,
+                  const TransferOptions& opt) {
+    pipeline(n, opt, [&](std::size_t off, int count, MPI_Request* req) {
+        MPI_Ibcast(p + off, count, MPI_DOUBLE, src, comm, req);
+    });
 }
 
-inline void send(Vector4D& t, int dst) {
-    MPI_Send(t.raw(), t.n_size(), MPI_DOUBLE, dst, ccsd::constants::mpi_tag_4d, MPI_COMM_WORLD);
+}  // namespace detail
+
+inline void send(Vector2D& t, int dst, MPI_Comm comm = MPI_COMM_WORLD,
+                 const TransferOptions& opt = {}) {
+    detail::send(t.raw(), t.n_size(), dst, ccsd::constants::mpi_tag_2d, comm, opt);
 }
-inline void recv(Vector4D& t, int src) {
-    MPI_Recv(t.raw(), t.n_size(), MPI_DOUBLE, src, ccsd::constants::mpi_tag_4d, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+inline void recv(Vector2D& t, int src, MPI_Comm comm = MPI_COMM_WORLD,
+                 const TransferOptions& opt = {}) {
+    detail::recv(t.raw(), t.n_size(), src, ccsd::constants::mpi_tag_2d, comm, opt);
 }
-inline void bcast(Vector4D& t, int src) {
-    MPI_Bcast(t.raw(), t.n_size(), MPI_DOUBLE, src, MPI_COMM_WORLD);
+inline void bcast(Vector2D& t, int src, MPI_Comm comm = MPI_COMM_WORLD,
+                  const TransferOptions& opt = {}) {
+    detail::bcast(t.raw(), t.n_size(), src, comm, opt);
+}
+
+inline void send(Vector4D& t, int dst, MPI_Comm comm = MPI_COMM_WORLD,
+                 const TransferOptions& opt = {}) {
+    detail::send(t.raw(), t.n_size(), dst, ccsd::constants::mpi_tag_4d, comm, opt);
+}
+inline void recv(Vector4D& t, int src, MPI_Comm comm = MPI_COMM_WORLD,
+                 const TransferOptions& opt = {}) {
+    detail::recv(t.raw(), t.n_size(), src, ccsd::constants::mpi_tag_4d, comm, opt);
+}
+inline void bcast(Vector4D& t, int src, MPI_Comm comm = MPI_COMM_WORLD,
+                  const TransferOptions& opt = {}) {
+    detail::bcast(t.raw(), t.n_size(), src, comm, opt);
+}
+
+// Gathers variable-sized local slices into `all` on every rank. counts and
+// displs are in units of `block` contiguous doubles (e.g. one (a,b) pair of
+// n_occ^2 amplitudes) so they stay within int range for large tensors.
+inline void allgatherv(const std::vector<double>& local, std::vector<double>& all,
+                       const std::vector<int>& counts, const std::vector<int>& displs,
+                       int block = 1, MPI_Comm comm = MPI_COMM_WORLD) {
+    MPI_Datatype unit = MPI_DATATYPE_NULL;
+    MPI_Type_contiguous(block, MPI_DOUBLE, &unit);
+    MPI_Type_commit(&unit);
+    const auto n_local = static_cast<int>(local.size() / static_cast<std::size_t>(block));
+    MPI_Allgatherv(local.data(), n_local, unit,
+                   all.data(), counts.data(), displs.data(), unit, comm);
+    MPI_Type_free(&unit);
 }
 
 }  // namespace ccsd::mpi
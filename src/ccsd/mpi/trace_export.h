@@ -0,0 +1,64 @@
+#pragma once
+
+#include <mpi.h>
+#include <util/timing/trace.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ccsd::mpi {
+
+// Merges every rank's events into one Chrome trace / Perfetto JSON file at
+// `path` on `root` (open it in ui.perfetto.dev or chrome://tracing): one row
+// per rank, one track per recording thread. Clocks are aligned at a barrier,
+// which is accurate to the barrier's skew (microseconds), and time 0 is the
+// earliest event of any rank. Collective over `comm`; call once recording
+// has stopped.
+inline void write_chrome_trace(const timing::TraceRecorder& trace, const std::string& path,
+                               int root, MPI_Comm comm = MPI_COMM_WORLD) {
+    int rank = 0, size = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    MPI_Barrier(comm);
+    const std::int64_t sync = timing::TraceRecorder::ns(timing::TraceRecorder::clock::now());
+    const std::vector<timing::TraceEvent> events = trace.events();
+    // Earliest event relative to this rank's barrier exit, minimised over ranks.
+    long long first = std::numeric_limits<long long>::max();
+    for (const auto& e : events) first = std::min<long long>(first, e.begin_ns - sync);
+    MPI_Allreduce(MPI_IN_PLACE, &first, 1, MPI_LONG_LONG, MPI_MIN, comm);
+    if (first == std::numeric_limits<long long>::max()) first = 0;
+
+    const std::string local = timing::chrome_trace_events(events, rank, sync + first);
+    unsigned long long dropped = trace.dropped();
+    MPI_Reduce(rank == root ? MPI_IN_PLACE : &dropped, &dropped, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, root, comm);
+
+    int n = static_cast<int>(local.size());
+    std::vector<int> counts(rank == root ? static_cast<std::size_t>(size) : 0), displs(counts.size());
+    MPI_Gather(&n, 1, MPI_INT, counts.data(), 1, MPI_INT, root, comm);
+    std::string all;
+    if (rank == root) {
+        std::size_t total = 0;
+        for (std::size_t r = 0; r < counts.size(); ++r) {
+            displs[r] = static_cast<int>(total);
+            total += static_cast<std::size_t>(counts[r]);
+        }
+        all.resize(total);
+    }
+    MPI_Gatherv(local.data(), n, MPI_CHAR, all.data(), counts.data(), displs.data(), MPI_CHAR, root, comm);
+    if (rank != root) return;
+
+    if (all.size() >= 2) all.resize(all.size() - 2);   // trailing ",\n"
+    std::ofstream out(path);
+    out << "{\"traceEvents\": [\n" << all << "\n],\n"
+        << "\"displayTimeUnit\": \"ms\",\n"
+        << "\"otherData\": {\"ranks\": " << size << ", \"dropped_events\": " << dropped << "}}\n";
+    if (!out) throw std::runtime_error("trace: cannot write " + path);
+}
+
+}  // namespace ccsd::mpi
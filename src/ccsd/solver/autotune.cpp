@@ -0,0 +1,254 @@
+#include <ccsd/solver/autotune.h>
+#include <ccsd/kernels/ccsd_omp.h>
+#include <ccsd/mpi/config_bcast.h>
+#include <util/timing/phase_profile.h>
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <mpi.h>
+
+namespace ccsd {
+
+namespace {
+
+// Fixed-size form of an optional TuningChoice for one MPI_Bcast; status is
+// 1 (choice follows), 0 (none) or -1 (the master failed).
+constexpr std::size_t packed_size = 9;
+
+std::array<double, packed_size> pack(int status, const TuningChoice& c) {
+    return {static_cast<double>(status), static_cast<double>(c.threads),
+            static_cast<double>(c.W_abef_layout.order[0]), static_cast<double>(c.W_abef_layout.order[1]),
+            static_cast<double>(c.W_abef_layout.order[2]), static_cast<double>(c.W_abef_layout.order[3]),
+            static_cast<double>(c.chunk_doubles), static_cast<double>(c.max_outstanding), c.seconds};
+}
+
+TuningChoice unpack(const std::array<double, packed_size>& v) {
+    TuningChoice c;
+    c.threads = static_cast<int>(v[1]);
+    for (std::size_t d = 0; d < 4; ++d) c.W_abef_layout.order[d] = static_cast<int>(v[2 + d]);
+    c.chunk_doubles   = static_cast<std::size_t>(v[6]);
+    c.max_outstanding = static_cast<int>(v[7]);
+    c.seconds         = v[8];
+    return c;
+}
+
+std::string describe(const TuningChoice& c) {
+    std::string s = "threads=" + (c.threads > 0 ? std::to_string(c.threads) : std::string("default"));
+    s += " W_abef=";
+    if (c.W_abef_layout == Layout<4>::row_major())         s += "row-major";
+    else if (c.W_abef_layout == Layout<4>::column_major()) s += "column-major";
+    else for (int d : c.W_abef_layout.order) s += std::to_string(d);
+    s += " chunk=" + std::to_string(c.chunk_doubles) + " outstanding=" + std::to_string(c.max_outstanding);
+    return s;
+}
+
+// Time of one short solve with `c`: its iteration phases (every profiled
+// phase but setup, so loading and allocation do not drown the knobs),
+// summed per rank, maximum over the ranks of `base`.
+double time_trial(const CcsdSolver& base, const TuningChoice& c, int iterations) {
+    CcsdSolver trial;
+    trial.p                  = base.p;
+    trial.config_path        = base.config_path;
+    trial.frozen_core        = base.frozen_core;
+    trial.cholesky_path      = base.cholesky_path;
+    trial.cholesky_threshold = base.cholesky_threshold;
+    trial.fno_threshold      = base.fno_threshold;
+    trial.scratch_dir        = base.scratch_dir;
+    trial.distributed_W_abef = base.distributed_W_abef;
+    trial.dynamic_tiles      = base.dynamic_tiles;
+    trial.max_iterations     = iterations;
+    trial.verbose            = false;
+    const MpiClass& mpi = base.orchestrator.mpi;
+    trial.orchestrator.configure(mpi.size, mpi.rank, mpi.comm);
+    apply_tuning(c, trial);
+    timing::PhaseProfile profile(solver_phase_names());
+    trial.profile = &profile;
+
+    trial.run();
+    double seconds = 0.0;
+    for (std::size_t i = 0; i < profile.size(); ++i)
+        if (i != static_cast<std::size_t>(SolverPhase::setup)) seconds += profile.phase(i).total_seconds();
+    MPI_Allreduce(MPI_IN_PLACE, &seconds, 1, MPI_DOUBLE, MPI_MAX, mpi.comm);
+    return seconds;
+}
+
+}  // namespace
+
+void apply_tuning(const TuningChoice& c, CcsdSolver& solver) {
+    set_omp_threads(c.threads);
+    solver.W_abef_layout = c.W_abef_layout;
+    solver.orchestrator.transfer.chunk_doubles   = c.chunk_doubles;
+    solver.orchestrator.transfer.max_outstanding = c.max_outstanding;
+}
+
+std::string cpu_signature() {
+    std::string model = "unknown";
+    std::ifstream in("/proc/cpuinfo");
+    for (std::string line; std::getline(in, line);) {
+        if (line.rfind("model name", 0) != 0) continue;
+        const auto colon = line.find(':');
+        if (colon == std::string::npos) break;
+        model = line.substr(line.find_first_not_of(" \t", colon + 1));
+        break;
+    }
+    return model + " x" + std::to_string(std::thread::hardware_concurrency());
+}
+
+std::string tuning_key(int n_spatial_orbitals, int n_occupied, int ranks, const std::string& cpu) {
+    return "dim=" + std::to_string(n_spatial_orbitals) + " Nelec=" + std::to_string(n_occupied)
+         + " ranks=" + std::to_string(ranks) + " cpu=" + cpu;
+}
+
+//=============================================================================
+TuningCache::TuningCache(std::string path) : path_(std::move(path)) {
+    std::ifstream in(path_);
+    if (!in) return;
+    try {
+        entries_ = nlohmann::json::parse(in);
+    } catch (const nlohmann::json::exception& ex) {
+        throw std::runtime_error("tuning cache " + path_ + ": " + ex.what());
+    }
+    if (!entries_.is_object()) throw std::runtime_error("tuning cache " + path_ + ": top level must be an object");
+}
+
+std::optional<TuningChoice> TuningCache::find(const std::string& key) const {
+    const auto it = entries_.find(key);
+    if (it == entries_.end()) return std::nullopt;
+    try {
+        TuningChoice c;
+        c.threads         = it->at("threads").get<int>();
+        c.W_abef_layout.order = it->at("W_abef_order").get<std::array<int, 4>>();
+        c.chunk_doubles   = it->at("chunk_doubles").get<std::size_t>();
+        c.max_outstanding = it->at("max_outstanding").get<int>();
+        c.seconds         = it->value("seconds", 0.0);
+        return c;
+    } catch (const nlohmann::json::exception& ex) {
+        throw std::runtime_error("tuning cache " + path_ + ": entry \"" + key + "\": " + ex.what());
+    }
+}
+
+void TuningCache::store(const std::string& key, const TuningChoice& c) {
+    entries_[key] = {{"threads", c.threads},
+                     {"W_abef_order", c.W_abef_layout.order},
+                     {"chunk_doubles", c.chunk_doubles},
+                     {"max_outstanding", c.max_outstanding},
+                     {"seconds", c.seconds}};
+}
+
+void TuningCache::save() const {
+    std::ofstream out(path_);
+    out << entries_.dump(2) << '\n';
+    if (!out) throw std::runtime_error("tuning cache " + path_ + ": cannot write");
+}
+//=============================================================================
+
+std::vector<int> thread_candidates() {
+    const int max = omp_max_threads();
+    if (max <= 1) return {0};
+    std::vector<int> t;
+    for (int n = 1; n < max; n *= 2) t.push_back(n);
+    t.push_back(max);
+    return t;
+}
+
+std::vector<Layout<4>> layout_candidates() {
+    std::vector<Layout<4>> l{Layout<4>::row_major()};
+    if (Layout<4>::standard() != Layout<4>::row_major()) l.push_back(Layout<4>::standard());
+    return l;
+}
+
+std::vector<std::size_t> chunk_candidates() {
+    return {constants::mpi_chunk_doubles, constants::mpi_chunk_doubles / 16};
+}
+
+std::vector<int> outstanding_candidates() {
+    return {constants::mpi_max_outstanding, 1, 2 * constants::mpi_max_outstanding};
+}
+
+TuningChoice autotune(const CcsdSolver& base, int trial_iterations, std::ostream* log) {
+    const bool master = base.orchestrator.mpi.rank == base.orchestrator.master();
+    TuningChoice best;
+    best.threads = thread_candidates().back();
+    time_trial(base, best, 1);   // warm-up: page in the integrals, spin up the threads
+    best.seconds = time_trial(base, best, trial_iterations);
+
+    // One knob at a time, the others held at the best so far.
+    auto search = [&](const auto& candidates, auto set) {
+        for (const auto& value : candidates) {
+            TuningChoice c = best;
+            set(c, value);
+            if (c == best) continue;
+            c.seconds = time_trial(base, c, trial_iterations);
+            if (log && master) *log << "  trial " << describe(c) << ": " << c.seconds << " s\n";
+            if (c.seconds < 0.98 * best.seconds) best = c;   // ignore wins within timing noise
+        }
+    };
+    if (log && master) *log << "  trial " << describe(best) << ": " << best.seconds << " s\n";
+    search(thread_candidates(),      [](TuningChoice& c, int v) { c.threads = v; });
+    search(layout_candidates(),      [](TuningChoice& c, const Layout<4>& v) { c.W_abef_layout = v; });
+    search(chunk_candidates(),       [](TuningChoice& c, std::size_t v) { c.chunk_doubles = v; });
+    search(outstanding_candidates(), [](TuningChoice& c, int v) { c.max_outstanding = v; });
+    return best;
+}
+
+std::optional<TuningChoice> apply_cached_tuning(CcsdSolver& solver, const std::string& path, bool search) {
+    const MpiClass& mpi = solver.orchestrator.mpi;
+    const int master = solver.orchestrator.master();
+    if (solver.p.n_spatial_orbitals == 0)
+        mpi::load_and_broadcast_config(solver.p, solver.config_path, master, mpi.comm, solver.orchestrator.transfer);
+    const std::string key = tuning_key(solver.p.n_spatial_orbitals, solver.p.n_occupied, mpi.size);
+
+    // Only the master touches the file; the lookup result is broadcast.
+    std::optional<TuningCache> cache;
+    std::array<double, packed_size> packed = pack(0, {});
+    std::string error;
+    if (mpi.rank == master) {
+        try {
+            cache.emplace(path);
+            if (const auto hit = cache->find(key)) packed = pack(1, *hit);
+        } catch (const std::exception& ex) {
+            error = ex.what();
+            packed = pack(-1, {});
+        }
+    }
+    MPI_Bcast(packed.data(), static_cast<int>(packed_size), MPI_DOUBLE, master, mpi.comm);
+    if (packed[0] < 0) throw std::runtime_error(error.empty() ? "tuning cache " + path + ": unreadable on the master" : error);
+
+    const bool print = solver.verbose && mpi.rank == master;
+    TuningChoice choice;
+    if (packed[0] > 0) {
+        choice = unpack(packed);
+        if (print) std::cout << "Tuning (cached): " << describe(choice) << std::endl;
+    } else if (search) {
+        if (print) std::cout << "Autotuning " << key << std::endl;
+        choice = autotune(solver, 2, print ? &std::cout : nullptr);
+        // Saved by the master alone too; its outcome is broadcast so that a
+        // failed write throws on every rank rather than on the master only.
+        int saved = 1;
+        if (mpi.rank == master) {
+            try {
+                cache->store(key, choice);
+                cache->save();
+            } catch (const std::exception& ex) {
+                error = ex.what();
+                saved = 0;
+            }
+        }
+        MPI_Bcast(&saved, 1, MPI_INT, master, mpi.comm);
+        if (!saved) throw std::runtime_error(error.empty() ? "tuning cache " + path + ": cannot write on the master" : error);
+        if (print) std::cout << "Tuning (new): " << describe(choice) << " -> " << path << std::endl;
+    } else {
+        return std::nullopt;
+    }
+    apply_tuning(choice, solver);
+    return choice;
+}
+
+}  // namespace ccsd
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <ccsd/kernels/ccsd_constants.h>
+#include <ccsd/solver/ccsd_solver.h>
+#include <util/tensors/layout.h>
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace ccsd {
+
+// One runtime configuration of the hot path. None of these knobs changes
+// the result; they only move time between compute, memory and MPI.
+struct TuningChoice {
+    int threads = 0;                                          // OpenMP threads; 0 keeps the runtime default
+    Layout<4> W_abef_layout = Layout<4>::row_major();
+    std::size_t chunk_doubles = constants::mpi_chunk_doubles; // MpiOrchestrator::transfer
+    int max_outstanding = constants::mpi_max_outstanding;
+    double seconds = 0.0;                                     // trial time (slowest rank); 0 if never timed
+
+    [[nodiscard]] bool operator==(const TuningChoice&) const = default;
+};
+
+// Sets `c` on `solver` (and the process-wide OpenMP thread count).
+void apply_tuning(const TuningChoice& c, CcsdSolver& solver);
+
+// "model name" from /proc/cpuinfo plus the hardware thread count; tunings
+// measured on one machine are not reused on another.
+[[nodiscard]] std::string cpu_signature();
+
+// Cache key: the loaded shape, the rank count and the CPU.
+[[nodiscard]] std::string tuning_key(int n_spatial_orbitals, int n_occupied, int ranks,
+                                     const std::string& cpu = cpu_signature());
+
+// Winning choices per key, persisted as a JSON object in `path`:
+//   { "<key>": {"threads": 4, "W_abef_order": [0,1,2,3],
+//               "chunk_doubles": 1048576, "max_outstanding": 4, "seconds": 0.8} }
+// A missing file is an empty cache; a malformed one throws.
+class TuningCache {
+public:
+    explicit TuningCache(std::string path);
+
+    [[nodiscard]] std::optional<TuningChoice> find(const std::string& key) const;
+    void store(const std::string& key, const TuningChoice& c);
+    void save() const;   // throws if the file cannot be written
+
+private:
+    std::string path_;
+    nlohmann::json entries_ = nlohmann::json::object();
+};
+
+// Candidates per knob, in the order they are tried (the first is the default).
+[[nodiscard]] std::vector<int> thread_candidates();
+[[nodiscard]] std::vector<Layout<4>> layout_candidates();
+[[nodiscard]] std::vector<std::size_t> chunk_candidates();
+[[nodiscard]] std::vector<int> outstanding_candidates();
+
+// Times `trial_iterations` CCSD iterations of `base`'s problem per candidate
+// and returns the fastest choice. Knobs are searched one at a time, each
+// starting from the best of the previous ones, so the cost is the sum of the
+// candidate counts rather than their product. `base` must be attached and
+// its `p` loaded; it is not run. Collective over base's communicator; every
+// rank returns the same choice. `log` (master only) gets one line per trial.
+[[nodiscard]] TuningChoice autotune(const CcsdSolver& base, int trial_iterations = 2,
+                                    std::ostream* log = nullptr);
+
+// Loads solver.p if needed, then looks up its shape in the cache at `path`.
+// On a hit the stored choice is applied; on a miss with `search` the choice
+// is found with autotune(), saved to the cache by the master and applied.
+// Returns the applied choice. Collective over the solver's communicator.
+std::optional<TuningChoice> apply_cached_tuning(CcsdSolver& solver, const std::string& path, bool search);
+
+}  // namespace ccsd
@@ -1,79 +1,464 @@
 #include <ccsd/solver/ccsd_solver.h>
 #include <ccsd/kernels/ccsd_kernels.h>
 #include <ccsd/kernels/ccsd_constants.h>
+#include <ccsd/kernels/ccsd_flops.h>
+#include <ccsd/kernels/ccsd_triples.h>
+#include <ccsd/mpi/config_bcast.h>
 #include <util/timing/timer.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <numeric>
+#include <string>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 #include <mpi.h>
 
 namespace ccsd {
 
-void CcsdSolver::initialization(CcsdKernels& kernels) {
-    state_.allocate(2 * p.n_spatial_orbitals);
+void CcsdSolver::load_and_allocate() {
+    if (p.n_spatial_orbitals == 0)
+        mpi::load_and_broadcast_config(p, config_path, orchestrator.master(),
+                                       orchestrator.mpi.comm, orchestrator.transfer);
+    if (frozen_core >= 0) {
+        if (frozen_core < p.frozen_core)
+            throw std::runtime_error("frozen_core is below the count the config already froze");
+        p.freeze_core(frozen_core - p.frozen_core);
+    }
+    // Every rank holds p, so each truncates its own copy (deterministically).
+    fno_ = fno_threshold > 0.0 ? truncate_virtuals_fno(p, fno_threshold) : FnoResult{};
+    if (state_.cholesky.empty()) {
+        if (!cholesky_path.empty())
+            state_.cholesky = mpi::load_and_broadcast_cholesky(cholesky_path, orchestrator.master(),
+                                                               orchestrator.mpi.comm, orchestrator.transfer);
+        else if (cholesky_threshold > 0.0)
+            state_.cholesky = cholesky_decompose([&](int a, int b, int c, int d) { return p.eri(a, b, c, d); },
+                                                 p.n_spatial_orbitals, cholesky_threshold);
+        if (!state_.cholesky.empty()) {
+            if (state_.cholesky.n_orbitals() != p.n_spatial_orbitals)
+                throw std::runtime_error("cholesky vectors do not match the active orbital count");
+            p.two_electron_mos   = IntegralTable{};
+            p.external_integrals = IntegralView{};
+        }
+    }
+    const int n_spin = 2 * p.n_spatial_orbitals;
+    orchestrator.release_W();   // the exposed W buffers are about to be replaced
+    state_.W_abef_from_slabs = !scratch_dir.empty() || distributed_W_abef;
+    state_.W_abef_layout = W_abef_layout;
+    state_.W_remote = !orchestrator.owns_W();
+    state_.allocate(n_spin, SpinOrbitalSymmetry::labels(p.orbital_symmetry, n_spin));
     orchestrator.assign_tensor_owners(state_);
+    orchestrator.configure_amplitude_tiles(p.n_occupied, state_.n_spin_orbitals);
+    orchestrator.expose_W(state_);
+    orchestrator.expose_task_counter();
+}
+
+void CcsdSolver::initialization(CcsdKernels& kernels) {
 
     kernels.build_spin_integrals();
     kernels.build_fock_spin();
     kernels.guess_t2();
     kernels.build_denominators();
+    kernels.build_screening_norms();
+    // Only the CCSD and CCD doubles read <ab||ef>.
+    if (state_.W_abef_from_slabs && (method == Method::ccsd || method == Method::ccd)) {
+        write_vvvv_slabs(kernels);
+    } else {
+        vvvv_stream_.reset();   // slabs of an earlier run
+        vvvv_rows_ = {};
+    }
+    incremental_.reset();
+    since_rebuild_ = 0;
+    if (incremental_threshold > 0.0 && orchestrator.mpi.rank == state_.W_mbej.rank) {
+        incremental_ = std::make_unique<IncrementalIntermediates>(state_, p);
+        state_.memory.record("incremental t_ref", incremental_->bytes());
+    }
+}
+
+void CcsdSolver::write_vvvv_slabs(const CcsdKernels& kernels) {
+    // Slab k is pair t2.begin + k. Without a scratch directory the slabs
+    // stay in memory; otherwise one file per process (world rank), so
+    // concurrent groups sharing scratch_dir do not collide.
+    vvvv_stream_.reset();   // reads vvvv_file_, which is about to be replaced
+    vvvv_rows_ = {};
+    const TileRange t2 = orchestrator.t2_tile();
+    const auto n_virt  = static_cast<std::size_t>(state_.n_spin_orbitals - p.n_occupied);
+    if (scratch_dir.empty()) {
+        vvvv_rows_.resize(static_cast<std::size_t>(t2.end - t2.begin) * n_virt * n_virt);
+        for (int pair = t2.begin; pair < t2.end; ++pair)
+            kernels.build_vvvv_slab(pair, vvvv_rows_.data() + static_cast<std::size_t>(pair - t2.begin) * n_virt * n_virt);
+        state_.memory.record("vvvv rows", vvvv_rows_.size() * sizeof(double));
+        return;
+    }
+    int world_rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    vvvv_file_.create(scratch_dir + "/ccsd_vvvv." + std::to_string(world_rank) + ".bin", n_virt * n_virt);
+    std::vector<double> slab(n_virt * n_virt);
+    for (int pair = t2.begin; pair < t2.end; ++pair) {
+        kernels.build_vvvv_slab(pair, slab.data());
+        vvvv_file_.write(static_cast<std::size_t>(pair - t2.begin), 1, slab.data());
+    }
+    vvvv_stream_ = std::make_unique<SlabPrefetcher>(
+        vvvv_file_, static_cast<std::size_t>(orchestrator.W_tile_pairs()));
+    state_.memory.record("vvvv buffers", vvvv_stream_->bytes());
 }
 
 void CcsdSolver::compute_intermediates_distributed(CcsdKernels& kernels) {
-    if (orchestrator.mpi.rank == state_.F_ae.rank)   kernels.compute_F_ae();
-    if (orchestrator.mpi.rank == state_.F_mi.rank)   kernels.compute_F_mi();
-    if (orchestrator.mpi.rank == state_.F_me.rank)   kernels.compute_F_me();
-    if (orchestrator.mpi.rank == state_.W_mnij.rank) kernels.compute_W_mnij();
-    if (orchestrator.mpi.rank == state_.W_abef.rank) kernels.compute_W_abef();
-    if (orchestrator.mpi.rank == state_.W_mbej.rank) kernels.compute_W_mbej();
+    const int rank = orchestrator.mpi.rank;
+    const double o = p.n_occupied;
+    const double v = state_.n_spin_orbitals - p.n_occupied;
+    // CC2 needs only the F intermediates of the CCSD singles equation.
+    if (method == Method::cc2) {
+        if (rank == state_.F_ae.rank) { auto t = phase(SolverPhase::F_ae, flops::F_ae(o, v)); kernels.compute_F_ae(); }
+        if (rank == state_.F_mi.rank) { auto t = phase(SolverPhase::F_mi, flops::F_mi(o, v)); kernels.compute_F_mi(); }
+        if (rank == state_.F_me.rank) { auto t = phase(SolverPhase::F_me, flops::F_me(o, v)); kernels.compute_F_me(); }
+        return;
+    }
+    // All F/W share one owner; between full rebuilds it applies only the
+    // amplitude changes since the last update.
+    const bool incremental = incremental_threshold > 0.0;
+    if (incremental && since_rebuild_ > 0 && since_rebuild_ < full_rebuild_interval) {
+        ++since_rebuild_;
+        if (incremental_) {
+            auto t = phase(SolverPhase::delta);
+            incremental_->update(incremental_threshold);
+        }
+        return;
+    }
+    since_rebuild_ = incremental ? 1 : 0;
+    if (rank == state_.F_ae.rank)   { auto t = phase(SolverPhase::F_ae,   flops::F_ae(o, v));   kernels.compute_F_ae(); }
+    if (rank == state_.F_mi.rank)   { auto t = phase(SolverPhase::F_mi,   flops::F_mi(o, v));   kernels.compute_F_mi(); }
+    if (rank == state_.F_me.rank && kernels.singles()) { auto t = phase(SolverPhase::F_me, flops::F_me(o, v)); kernels.compute_F_me(); }
+    if (rank == state_.W_mnij.rank) { auto t = phase(SolverPhase::W_mnij, flops::W_mnij(o, v)); kernels.compute_W_mnij(); }
+    if (rank == state_.W_abef.rank && !state_.W_abef_from_slabs) { auto t = phase(SolverPhase::W_abef, flops::W_abef(o, v)); kernels.compute_W_abef(); }
+    if (rank == state_.W_mbej.rank) { auto t = phase(SolverPhase::W_mbej, flops::W_mbej(o, v)); kernels.compute_W_mbej(); }
+    if (incremental_) incremental_->mark_built();
+}
+
+void CcsdSolver::solve_amplitudes_distributed(CcsdKernels& kernels) {
+    // Every rank evaluates its share of T1/T2 (denominator applied locally),
+    // then the tiles are exchanged so each rank holds the full amplitudes.
+    const double o = p.n_occupied;
+    const double v = state_.n_spin_orbitals - p.n_occupied;
+    {
+        auto t = phase(SolverPhase::comm);
+        orchestrator.broadcast_F(state_);
+    }
+    if (kernels.singles()) {   // CCD: t1_next stays zero
+        const TileRange t1 = orchestrator.t1_tile();
+        auto t = phase(SolverPhase::t1, (t1.end - t1.begin) * flops::t1_row(o, v));
+        kernels.compute_t1_tile(t1.begin, t1.end);
+    }
+    if (method == Method::cc2) {
+        // The CC2 doubles depend on T1 alone, which every rank holds: each
+        // rank builds those of its static T2 tile, transforming only the
+        // integral rows the tile reads, and the tiles are all-gathered.
+        const TileRange t2 = orchestrator.t2_tile();
+        if (t2.begin < t2.end) {
+            const int n_virt = state_.n_spin_orbitals - p.n_occupied;
+            const double rows = (t2.end - 1) / n_virt - t2.begin / n_virt + 1;
+            auto t = phase(SolverPhase::t2, flops::cc2_doubles_tile(o, v, rows, t2.end - t2.begin));
+            kernels.compute_t2_cc2_tile(t2.begin, t2.end);
+        }
+        auto t = phase(SolverPhase::comm);
+        orchestrator.allgather_amplitudes(state_);
+        return;
+    }
+
+    // W intermediates are stored only on their owner: each T2 tile pulls
+    // the W slices it reads, one tile ahead of the kernel. Out of core, the tile's
+    // <ab||ef> slabs stream from scratch the same way (distributed, they are
+    // already in memory) and W_abef is rebuilt per pair inside the kernel.
+    // Tiles are rows of `step` pairs, walked through this rank's static
+    // range or claimed one at a time from the shared counter until none remain.
+    const bool slabs = state_.W_abef_from_slabs;
+    const bool dynamic = dynamic_tiles && !slabs;
+    const int step = orchestrator.W_tile_pairs();
+    const int n_virt = state_.n_spin_orbitals - p.n_occupied;
+    const TileRange t2 = dynamic ? TileRange{0, n_virt * n_virt} : orchestrator.t2_tile();
+    int next_begin = t2.begin;
+    auto claim = [&]() {
+        int begin = next_begin;
+        if (dynamic) {
+            const std::int64_t k = orchestrator.claim_task();
+            begin = k < (t2.end + step - 1) / step ? static_cast<int>(k) * step : t2.end;
+        } else {
+            next_begin += step;
+        }
+        return TileRange{std::min(begin, t2.end), std::min(begin + step, t2.end)};   // empty once exhausted
+    };
+    auto prefetch = [&](TileRange tile) {
+        orchestrator.prefetch_W_tile(tile);
+        if (vvvv_stream_)
+            vvvv_stream_->prefetch(static_cast<std::size_t>(tile.begin - t2.begin),
+                                   static_cast<std::size_t>(tile.end - tile.begin));
+    };
+    const double pair_work = flops::t2_pair(o, v) + (slabs ? flops::W_abef(o, v) / (v * v) : 0.0);
+
+    TileRange tile;
+    {
+        auto t = phase(SolverPhase::comm);
+        if (dynamic) orchestrator.begin_tasks();
+        orchestrator.begin_W_access();
+        tile = claim();
+        if (tile.begin < tile.end) prefetch(tile);
+    }
+    std::vector<TileRange> done;
+    bool prepared = false;   // τ planes and block norms, once per iteration
+    while (tile.begin < tile.end) {
+        TileRange next;
+        const WSlices* remote = nullptr;
+        {
+            auto t = phase(SolverPhase::comm);
+            next = claim();
+            if (next.begin < next.end) prefetch(next);
+            remote = orchestrator.wait_W_tile();
+        }
+        const double* vvvv = nullptr;
+        if (vvvv_stream_) {
+            auto t = phase(SolverPhase::io);
+            vvvv = vvvv_stream_->wait();
+        } else if (slabs) {
+            vvvv = vvvv_rows_.data() + static_cast<std::size_t>(tile.begin - t2.begin) * static_cast<std::size_t>(n_virt * n_virt);
+        }
+        if (!prepared) {
+            auto t = phase(SolverPhase::t2);
+            kernels.prepare_t2_tiles(remote);
+            prepared = true;
+        }
+        {
+            auto t = phase(SolverPhase::t2, (tile.end - tile.begin) * pair_work);
+            kernels.compute_t2_tile(tile.begin, tile.end, vvvv, remote);
+        }
+        done.push_back(tile);
+        tile = next;
+    }
+
+    auto t = phase(SolverPhase::comm);
+    orchestrator.end_W_access();
+    if (dynamic) orchestrator.allgather_amplitudes(state_, done);
+    else         orchestrator.allgather_amplitudes(state_);
+}
+
+double CcsdSolver::compute_triples_distributed() {
+    // Every rank holds the converged amplitudes; each evaluates its tile of
+    // i<j<k triples (or, dynamically, the chunks it claims), and the
+    // per-triple energies are combined and summed in triple order so E(T)
+    // does not depend on the rank or thread count.
+    const TriplesKernels triples(state_, p);
+    const int n = triples.n_triples();
+    const double o = p.n_occupied;
+    const double v = state_.n_spin_orbitals - p.n_occupied;
+    std::vector<double> all(static_cast<std::size_t>(n));
+    if (dynamic_tiles) {
+        // Several chunks per rank, so a slow rank holds up the others by at
+        // most one chunk.
+        const int chunk = std::max(n / (8 * orchestrator.mpi.size), 1);
+        std::vector<TileRange> claimed;
+        {
+            auto t = phase(SolverPhase::comm);
+            orchestrator.begin_tasks();
+        }
+        for (;;) {
+            std::int64_t k = 0;
+            {
+                auto t = phase(SolverPhase::comm);
+                k = orchestrator.claim_task();
+            }
+            if (k >= (n + chunk - 1) / chunk) break;
+            const int begin = static_cast<int>(k) * chunk;
+            const int end   = std::min(begin + chunk, n);
+            auto t = phase(SolverPhase::triples, (end - begin) * flops::triples_per_triple(o, v));
+            triples.compute_tile(begin, end, all.data() + begin);
+            claimed.push_back({begin, end});
+        }
+        auto t = phase(SolverPhase::comm);
+        orchestrator.allgather_triples(claimed, all);
+    } else {
+        const TileRange tile = orchestrator.triples_tile(n);
+        std::vector<double> local(static_cast<std::size_t>(tile.end - tile.begin));
+        {
+            auto t = phase(SolverPhase::triples, (tile.end - tile.begin) * flops::triples_per_triple(o, v));
+            triples.compute_tile(tile.begin, tile.end, local.data());
+        }
+        auto t = phase(SolverPhase::comm);
+        orchestrator.allgather_triples(local, all);
+    }
+    double e = 0.0;
+    for (double x : all) e += x;
+    return e;
 }
 
-void CcsdSolver::solve_amplitudes_on_master(CcsdKernels& kernels) {
-    // Gather F intermediates, then compute T1 on master.
-    orchestrator.gather_F_to_master(state_);
-    if (orchestrator.mpi.rank == orchestrator.master())
-        kernels.compute_t1();
+std::vector<EomRoot> CcsdSolver::compute_eom(CcsdKernels& kernels) {
+    // The intermediates' owner rebuilds F/W at the converged amplitudes
+    // (the loop left them one iterate behind) and runs the Davidson solve;
+    // the roots are then broadcast, flattened four values per root behind
+    // a status / iterations / converged header.
+    const int owner = state_.F_ae.rank;
+    constexpr std::size_t header = 3, per_root = 4;
+    std::vector<double> packed(header + per_root * static_cast<std::size_t>(eom_roots), 0.0);
+    std::string error;
+    if (orchestrator.mpi.rank == owner) {
+        auto t = phase(SolverPhase::eom);
+        try {
+            kernels.compute_F_ae();  kernels.compute_F_mi();  kernels.compute_F_me();
+            kernels.compute_W_mnij(); kernels.compute_W_abef(); kernels.compute_W_mbej();
+            const auto o = static_cast<std::size_t>(p.n_occupied);
+            const auto v = static_cast<std::size_t>(state_.n_spin_orbitals - p.n_occupied);
+            state_.memory.record("EOM blocks", EomKernels::block_bytes(o, v));
+            state_.memory.record("EOM scratch", EomKernels::scratch_bytes(o, v));
+            const EomResult r = EomKernels(state_, p, eom_irrep).solve(eom_roots);
+            packed[0] = 1.0;
+            packed[1] = r.iterations;
+            packed[2] = r.converged ? 1.0 : 0.0;
+            for (std::size_t k = 0; k < r.roots.size(); ++k) {
+                double* x = packed.data() + header + per_root * k;
+                x[0] = r.roots[k].excitation;
+                x[1] = r.roots[k].singles;
+                x[2] = r.roots[k].multiplicity;
+                x[3] = r.roots[k].residual;
+            }
+        } catch (const std::exception& ex) {
+            error = ex.what();
+            packed[0] = -1.0;
+        }
+    }
+    {
+        auto t = phase(SolverPhase::comm);
+        orchestrator.broadcast_values(packed, owner);
+    }
+    if (packed[0] < 0.0)
+        throw std::runtime_error(error.empty() ? "EOM-CCSD failed on rank " + std::to_string(owner) : error);
 
-    // Gather W intermediates, then compute T2 on master.
-    orchestrator.gather_W_to_master(state_);
-    if (orchestrator.mpi.rank == orchestrator.master())
-        kernels.compute_t2();
+    std::vector<EomRoot> roots(static_cast<std::size_t>(eom_roots));
+    for (std::size_t k = 0; k < roots.size(); ++k) {
+        const double* x = packed.data() + header + per_root * k;
+        roots[k] = {x[0], x[1], static_cast<int>(x[2]), x[3]};
+    }
+    if (verbose && orchestrator.mpi.rank == orchestrator.master() && packed[2] == 0.0)
+        std::cout << "  warning: EOM-CCSD not converged after " << static_cast<int>(packed[1])
+                  << " Davidson iterations" << std::endl;
+    return roots;
 }
 
 void CcsdSolver::run() {
     std::cout.precision(10);
+    if (profile) profile->begin_run();
+    orchestrator.trace = trace;
+    {
+        auto t = phase(SolverPhase::setup);
+        load_and_allocate();
+    }
+    if (eom_roots > 0 && state_.W_abef_from_slabs)
+        throw std::runtime_error("EOM-CCSD needs W_abef whole on one rank: drop the scratch directory and distributed_W_abef");
+    if (method != Method::ccsd && (perturbative_triples || eom_roots > 0))
+        throw std::runtime_error("(T) and EOM-CCSD need the CCSD amplitudes: use method ccsd");
+    // Constructed once p is loaded: the kernels index its orbital symmetry.
     CcsdKernels kernels(state_, p);
+    kernels.set_singles(method != Method::ccd);
+    kernels.set_screening(screening_threshold);
+    {
+        auto t = phase(SolverPhase::setup);
+        initialization(kernels);
+    }
 
-    initialization(kernels);
-
-    if (orchestrator.mpi.rank == orchestrator.master())
+    if (verbose && orchestrator.mpi.rank == orchestrator.master()) {
         std::cout << "CCSD in MpiC++" << std::endl;
+        if (method != Method::ccsd)
+            std::cout << "  method = " << method_name(method) << std::endl;
+        if (fno_.n_virtual > 0)
+            std::cout << "  FNO virtuals kept = " << fno_.n_virtual_kept << " of " << fno_.n_virtual << std::endl;
+    }
 
     double cc_en = 0.0, cc_en_pre = 0.0, cc_en_diff = 10.0;
+    int iterations = 0;
+    const double o = p.n_occupied;
+    const double v = state_.n_spin_orbitals - p.n_occupied;
 
-    // P13 audit: F/W intermediates scatter to per-rank workers, then gather to
-    // rank_master for T1/T2 computation, then broadcast. Point-to-point is used
-    // for the gather because only rank_master consumes the intermediates.
-    while (cc_en_diff > constants::convergence_threshold) {
+    // MP2 and MP3 are non-iterative: the first-order T2 from initialization
+    // gives both. E(3) rows are split over the ranks like the T1 tiles and
+    // summed in row order on every rank; the master adds the MP2 energy.
+    const bool iterative = method != Method::mp2 && method != Method::mp3;
+    if (method == Method::mp3) {
+        const TileRange rows = orchestrator.t1_tile();
+        std::vector<double> partial(static_cast<std::size_t>(v), 0.0);
+        {
+            auto t = phase(SolverPhase::energy, (rows.end - rows.begin) * flops::mp3_energy(o, v) / v);
+            kernels.compute_mp3_partials(rows.begin, rows.end, partial);
+        }
+        {
+            auto t = phase(SolverPhase::comm);
+            orchestrator.sum_values(partial);
+        }
+        cc_en = std::accumulate(partial.begin(), partial.end(), 0.0);
+    }
+    if (!iterative && orchestrator.mpi.rank == orchestrator.master()) {
+        auto t = phase(SolverPhase::energy, flops::energy(o, v));
+        cc_en += kernels.compute_energy();
+    }
+
+    // F/W intermediates are computed by their owner rank (F broadcast, W read
+    // through RMA windows); each rank then solves its (a,b) amplitude tile and
+    // the vvoo blocks are all-gathered, so no rank does the whole T2 update.
+    while (iterative && cc_en_diff > constants::convergence_threshold
+           && (max_iterations <= 0 || iterations < max_iterations)) {
         cc_en_pre = cc_en;
+        ++iterations;
 
         compute_intermediates_distributed(kernels);
-        solve_amplitudes_on_master(kernels);
+        solve_amplitudes_distributed(kernels);
 
-        orchestrator.broadcast_amplitudes(state_);
         state_.t2 = state_.t2_next;
         state_.t1 = state_.t1_next;
 
         if (orchestrator.mpi.rank == orchestrator.master()) {
+            auto t = phase(SolverPhase::energy, flops::energy(o, v));
             cc_en = kernels.compute_energy();
             cc_en_diff = std::abs(cc_en - cc_en_pre);
         }
+        auto t = phase(SolverPhase::comm);
         orchestrator.broadcast_scalar(cc_en_diff);
     }
+    const double e_t = perturbative_triples ? compute_triples_distributed() : 0.0;
+    std::vector<EomRoot> excited = eom_roots > 0 ? compute_eom(kernels) : std::vector<EomRoot>{};
+    orchestrator.release_W();   // nothing reads W remotely from here on
+    if (profile) profile->end_run();
+    orchestrator.broadcast_scalar(cc_en);   // only the master evaluated it
+    std::vector<double> screened{kernels.screening_stats().total, kernels.screening_stats().skipped};
+    if (screening_threshold > 0.0) orchestrator.sum_values(screened);
 
-    if (orchestrator.mpi.rank == orchestrator.master()) {
-        std::cout << "  E(corr,CCSD) = " << cc_en << std::endl;
-        std::cout << "  E(CCSD) = " << cc_en + p.nuclear_repulsion + p.hf_energy << std::endl;
+    // FNO: the MP2 estimate of the dropped virtuals is folded into every
+    // reported energy.
+    result_ = CcsdResult{};
+    result_.fno_correction = fno_.n_virtual > 0 ? fno_.correction() : 0.0;
+    result_.e_corr         = cc_en + result_.fno_correction;
+    result_.e_total        = result_.e_corr + p.nuclear_repulsion + p.hf_energy;
+    result_.e_triples      = e_t;
+    result_.iterations     = iterations;
+    result_.screening      = {screened[0], screened[1]};
+    result_.excited_states = std::move(excited);
+
+    if (verbose && orchestrator.mpi.rank == orchestrator.master()) {
+        if (fno_.n_virtual > 0)
+            std::cout << "  E(FNO MP2 correction) = " << result_.fno_correction << std::endl;
+        if (screening_threshold > 0.0)
+            std::cout << "  screening: skipped " << std::round(1000.0 * result_.screening.fraction()) / 10.0
+                      << "% of the screened work (threshold " << screening_threshold << ")" << std::endl;
+        std::cout << "  E(corr," << method_name(method) << ") = " << result_.e_corr << std::endl;
+        std::cout << "  E(" << method_name(method) << ") = " << result_.e_total << std::endl;
+        if (perturbative_triples) {
+            std::cout << "  E(T) = " << e_t << std::endl;
+            std::cout << "  E(CCSD(T)) = " << result_.e_total + e_t << std::endl;
+        }
+        for (std::size_t k = 0; k < result_.excited_states.size(); ++k) {
+            const EomRoot& r = result_.excited_states[k];
+            std::cout << "  EOM-CCSD root " << k + 1 << ": omega = " << r.excitation
+                      << " (" << (r.multiplicity == 3 ? "triplet" : "singlet")
+                      << ", singles " << std::lround(100.0 * r.singles) << "%)" << std::endl;
+        }
     }
 }
 
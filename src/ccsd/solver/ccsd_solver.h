@@ -1,31 +1,204 @@
 #pragma once
 
 #include <ccsd/kernels/ccsd_state.h>
+#include <ccsd/kernels/ccsd_eom.h>
+#include <ccsd/kernels/ccsd_incremental.h>
 #include <ccsd/kernels/ccsd_kernels.h>
 #include <ccsd/mpi/orchestrator.h>
 #include <ccsd/config/ccsd_config.h>
+#include <ccsd/config/fno.h>
+#include <util/tensors/slab_file.h>
+#include <util/timing/phase_profile.h>
+#include <util/timing/trace.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace ccsd {
 
+// Phases recorded into CcsdSolver::profile; the enum value is the phase index.
+// `comm` covers every MPI transfer and synchronization in the iteration loop;
+// `io` is time spent waiting on out-of-core slab reads; `delta` covers the
+// incremental F/W updates between full rebuilds; `eom` the excited states.
+enum class SolverPhase : std::size_t {
+    setup, F_ae, F_mi, F_me, W_mnij, W_abef, W_mbej, t1, t2, comm, energy, triples, io,
+    delta, eom, count
+};
+
+inline constexpr std::array<const char*, static_cast<std::size_t>(SolverPhase::count)> solver_phase_labels{
+    "setup", "F_ae", "F_mi", "F_me", "W_mnij", "W_abef", "W_mbej",
+    "t1", "t2", "comm", "energy", "triples", "io", "delta", "eom"};
+
+inline std::vector<std::string> solver_phase_names() {
+    return {solver_phase_labels.begin(), solver_phase_labels.end()};
+}
+
+// Correlation methods run() can solve for, cheapest first. All share
+// CcsdKernels: MP2 is the guess_t2 energy, MP3 adds E(3) from the same
+// amplitudes, CC2 iterates the CCSD singles with T1-dressed first-order
+// doubles, CCD iterates the doubles with T1 frozen at zero.
+enum class Method { mp2, mp3, cc2, ccd, ccsd };
+
+inline constexpr std::array<const char*, 5> method_labels{"MP2", "MP3", "CC2", "CCD", "CCSD"};
+
+inline const char* method_name(Method m) { return method_labels[static_cast<std::size_t>(m)]; }
+
+// Case-insensitive label ("mp2", "CCSD", ...) to Method.
+inline Method parse_method(const std::string& name) {
+    for (std::size_t k = 0; k < method_labels.size(); ++k) {
+        const std::string label = method_labels[k];
+        if (std::equal(name.begin(), name.end(), label.begin(), label.end(),
+                       [](char x, char y) { return std::toupper(static_cast<unsigned char>(x)) == y; }))
+            return static_cast<Method>(k);
+    }
+    throw std::invalid_argument("unknown method '" + name + "' (mp2, mp3, cc2, ccd or ccsd)");
+}
+
+// A solver phase as seen by the profile and, when set, the trace.
+struct SolverScope {
+    timing::ScopedPhase phase;
+    timing::ScopedTrace trace;
+};
+
+// Energies of a finished run(), identical on every rank. With FNO the MP2
+// correction for the dropped virtuals is already included in e_corr.
+struct CcsdResult {
+    double e_corr         = 0.0;   // correlation energy of CcsdSolver::method
+    double e_total        = 0.0;   // e_corr + nuclear repulsion + HF energy
+    double e_triples      = 0.0;   // (T); 0 unless perturbative_triples
+    double fno_correction = 0.0;
+    int iterations        = 0;
+    ScreeningStats screening;              // summed over ranks; empty unless screening_threshold > 0
+    std::vector<EomRoot> excited_states;   // EOM-CCSD roots; empty unless eom_roots > 0
+};
+
 // Coordinates initialization, MPI rank assignment, the CCSD iteration loop,
 // and convergence checking. Owns CcsdState, CcsdKernels, and MpiOrchestrator.
 class CcsdSolver {
 public:
-    ParameterClass p;
+    // Loaded by run() from config_path on the master rank and broadcast,
+    // unless the caller filled it in beforehand (n_spatial_orbitals > 0).
+    ParameterClass p{ParameterClass::direct_init{}};
+    std::string config_path = "./config.json";
+    // Method solved for; (T) and EOM need CCSD. The cheaper methods skip
+    // the work they do not use: no iterations for MP2/MP3, no W
+    // intermediates for CC2, no T1 terms for CCD.
+    Method method = Method::ccsd;
+    bool perturbative_triples = false;         // add the (T) correction after convergence
+    // EOM-EE-CCSD after convergence: the eom_roots lowest excited states
+    // whose excitation transforms as eom_irrep (0-based, 0 = totally
+    // symmetric). Needs the whole W_abef (no scratch_dir or
+    // distributed_W_abef); runs on the intermediates' owner.
+    int eom_roots = 0;
+    int eom_irrep = 0;
+    int frozen_core = -1;                      // total frozen core orbitals; -1 keeps the config's
+    // Cholesky integral backend: vectors read from cholesky_path, else built
+    // from the config's integrals to cholesky_threshold (> 0). Either way
+    // spin_integrals is never allocated and the integral table is released.
+    std::string cholesky_path;
+    double cholesky_threshold = 0.0;
+    // Frozen natural orbitals (> 0): virtuals whose MP2 natural occupation is
+    // at or below fno_threshold are dropped after freezing the core, and the
+    // MP2 estimate of their contribution is added to the reported energies.
+    double fno_threshold = 0.0;
+    // Out-of-core W_abef: each rank writes the <ab||ef> slabs of its T2 tile
+    // to a scratch file in scratch_dir once, then streams them back every
+    // iteration on an I/O thread, one row of pairs ahead of the T2 kernel.
+    // W_abef itself is never stored. Empty keeps everything in memory.
+    std::string scratch_dir;
+    // Distributed W_abef: as above, but each rank keeps the <ab||ef> slabs
+    // of its T2 tile in memory (about v⁴ / ranks doubles) instead of a file,
+    // so no rank stores the whole v⁴ W_abef. W_mnij and W_mbej still live
+    // whole on the first worker rank (MpiOrchestrator::owns_W).
+    bool distributed_W_abef = false;
+    // Incremental intermediates (> 0): between full rebuilds every
+    // full_rebuild_interval iterations, F/W are updated from the amplitude
+    // changes larger than incremental_threshold (IncrementalIntermediates).
+    double incremental_threshold = 0.0;
+    int full_rebuild_interval = 8;
+    // Dynamic scheduling: ranks claim T2 rows and (T) chunks from a shared
+    // counter (MpiOrchestrator::claim_task) instead of owning one fixed tile,
+    // so faster ranks take more of the work. Results are bitwise the same
+    // either way. The out-of-core and distributed W_abef paths keep their
+    // static tiles: each rank only has the <ab||ef> slabs of its own.
+    bool dynamic_tiles = true;
+    // Integral/amplitude screening (> 0): contraction blocks whose product of
+    // block max norms is below this are skipped (CcsdKernels::set_screening).
+    // The skipped fraction of the screened work is reported; the energy
+    // error against an unscreened run is what ccsd_bench --screening shows.
+    double screening_threshold = 0.0;
+    // Storage order of W_abef (see CcsdState::W_abef_layout); a tuning knob.
+    Layout<4> W_abef_layout = Layout<4>::row_major();
+    // Stop after this many iterations even if not converged (0 = no limit):
+    // the autotuner's trial runs time a fixed number of iterations.
+    int max_iterations = 0;
+    bool verbose = true;                       // master prints the energies
     MpiOrchestrator orchestrator;
+    timing::PhaseProfile* profile = nullptr;   // optional; one run = one sample per phase
+    // Optional timeline: every phase and orchestrator transfer of this rank
+    // (see ccsd::mpi::write_chrome_trace). Null records nothing.
+    timing::TraceRecorder* trace = nullptr;
 
     void attach(const MpiSession& session) {
-        orchestrator.configure(session.size(), session.rank());
+        orchestrator.configure(session.size(), session.rank(), session.comm());
+    }
+
+    // Runs the solve on an injected communicator (e.g. a sub-communicator
+    // from ccsd::mpi::split_groups) instead of MPI_COMM_WORLD. Solves that
+    // run side by side on sub-communicators should share one `window`
+    // created over their parent beforehand (see ccsd::mpi::RmaWindow);
+    // without one the solver opens its own over `comm`.
+    void attach(MPI_Comm comm, mpi::RmaWindow* window = nullptr) {
+        int size = 0, rank = 0;
+        MPI_Comm_size(comm, &size);
+        MPI_Comm_rank(comm, &rank);
+        orchestrator.configure(size, rank, comm, window);
     }
 
     void run();
 
+    // Bytes per tensor on this rank, filled by run() at allocation.
+    [[nodiscard]] const memory::MemoryRegistry& memory() const noexcept { return state_.memory; }
+
+    [[nodiscard]] const CcsdResult& result() const noexcept { return result_; }
+    // Converged amplitudes on every rank, indexed by spin orbital (occupied
+    // first, even = alpha), as t1(a,i) and t2(a,b,i,j). Views into solver
+    // storage: valid until the next run() or the solver's destruction.
+    [[nodiscard]] TensorView<2> t1() const noexcept { return state_.t1.view(); }
+    [[nodiscard]] TensorView<4> t2() const noexcept { return state_.t2.view(); }
+
 private:
     CcsdState state_;
+    CcsdResult result_;
+    FnoResult fno_;                                 // n_virtual == 0 when FNO is off
+    SlabFile vvvv_file_;                            // out-of-core <ab||ef> slabs of this rank's T2 tile
+    std::unique_ptr<SlabPrefetcher> vvvv_stream_;   // reads vvvv_file_; null when in core
+    std::vector<double> vvvv_rows_;                 // distributed_W_abef: the same slabs in memory
+    std::unique_ptr<IncrementalIntermediates> incremental_;   // intermediates' owner only
+    int since_rebuild_ = 0;                                   // incremental updates since the last full build
 
+    void load_and_allocate();
     void initialization(CcsdKernels& kernels);
+    void write_vvvv_slabs(const CcsdKernels& kernels);
     void compute_intermediates_distributed(CcsdKernels& kernels);
-    void solve_amplitudes_on_master(CcsdKernels& kernels);
+    void solve_amplitudes_distributed(CcsdKernels& kernels);
+    [[nodiscard]] double compute_triples_distributed();
+    [[nodiscard]] std::vector<EomRoot> compute_eom(CcsdKernels& kernels);
+
+    // `work`: analytic flops of the scope (ccsd/kernels/ccsd_flops.h).
+    [[nodiscard]] SolverScope phase(SolverPhase ph, double work = 0.0) {
+        const auto i = static_cast<std::size_t>(ph);
+        const timing::TraceCategory cat = ph == SolverPhase::comm ? timing::TraceCategory::comm
+                                        : ph == SolverPhase::io   ? timing::TraceCategory::io
+                                                                  : timing::TraceCategory::compute;
+        return {{profile, i, work}, {trace, solver_phase_labels[i], cat}};
+    }
 };
 
 }  // namespace ccsd
@@ -0,0 +1,63 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <ccsd/solver/autotune.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+TEST_CASE("tuning_key separates shapes, rank counts and CPUs", "[autotune]") {
+    const std::string k = ccsd::tuning_key(2, 2, 4, "cpu A");
+    REQUIRE(k == "dim=2 Nelec=2 ranks=4 cpu=cpu A");
+    REQUIRE(k != ccsd::tuning_key(3, 2, 4, "cpu A"));
+    REQUIRE(k != ccsd::tuning_key(2, 2, 2, "cpu A"));
+    REQUIRE(k != ccsd::tuning_key(2, 2, 4, "cpu B"));
+    REQUIRE_FALSE(ccsd::cpu_signature().empty());
+}
+
+TEST_CASE("TuningCache round-trips choices through its file", "[autotune]") {
+    const std::string path = "test_autotune_cache.json";
+    std::remove(path.c_str());
+
+    ccsd::TuningChoice c;
+    c.threads         = 3;
+    c.W_abef_layout   = ccsd::Layout<4>::column_major();
+    c.chunk_doubles   = 4096;
+    c.max_outstanding = 1;
+    c.seconds         = 0.25;
+    {
+        ccsd::TuningCache cache(path);   // no file yet: empty
+        REQUIRE_FALSE(cache.find("k").has_value());
+        cache.store("k", c);
+        cache.save();
+    }
+    const ccsd::TuningCache reread(path);
+    const auto hit = reread.find("k");
+    REQUIRE(hit.has_value());
+    REQUIRE(*hit == c);
+    REQUIRE_FALSE(reread.find("other").has_value());
+    std::remove(path.c_str());
+}
+
+TEST_CASE("TuningCache rejects a malformed file", "[autotune]") {
+    const std::string path = "test_autotune_bad.json";
+    {
+        std::ofstream out(path);
+        out << "[1, 2";
+    }
+    REQUIRE_THROWS(ccsd::TuningCache(path));
+    {
+        std::ofstream out(path);
+        out << R"({"k": {"threads": 2}})";
+    }
+    const ccsd::TuningCache partial(path);
+    REQUIRE_THROWS(partial.find("k"));
+    std::remove(path.c_str());
+}
+
+TEST_CASE("tuning candidates start from the defaults", "[autotune]") {
+    REQUIRE(ccsd::layout_candidates().front() == ccsd::Layout<4>::row_major());
+    REQUIRE(ccsd::chunk_candidates().front() == ccsd::constants::mpi_chunk_doubles);
+    REQUIRE(ccsd::outstanding_candidates().front() == ccsd::constants::mpi_max_outstanding);
+    REQUIRE_FALSE(ccsd::thread_candidates().empty());
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <util/linalg/general_eigen.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace ccsd::linalg {
+
+struct DavidsonOptions {
+    int    roots          = 1;
+    double tolerance      = 1e-6;   // residual 2-norm at which a root counts as converged
+    int    max_iterations = 100;
+    int    max_subspace   = 0;      // collapse to the Ritz vectors past this size; 0 = 10 per guess
+};
+
+struct DavidsonResult {
+    std::vector<double>              values;      // lowest `roots` by real part, ascending
+    std::vector<std::vector<double>> vectors;     // unit-norm right eigenvectors
+    std::vector<double>              residuals;   // final residual norms
+    int  iterations = 0;
+    bool converged  = false;
+};
+
+namespace detail {
+
+inline double dot(const std::vector<double>& x, const std::vector<double>& y) {
+    return std::inner_product(x.begin(), x.end(), y.begin(), 0.0);
+}
+
+// Gram-Schmidt of x against the orthonormal vectors of `basis` and `more`
+// (two passes), then normalizes it. False when x is (numerically) inside
+// their span already.
+inline bool orthonormalize(const std::vector<std::vector<double>>& basis, std::vector<double>& x,
+                           const std::vector<std::vector<double>>& more = {}) {
+    const double before = std::sqrt(dot(x, x));
+    if (before == 0.0) return false;
+    for (int pass = 0; pass < 2; ++pass)
+        for (const auto* set : {&basis, &more})
+            for (const auto& b : *set) {
+                const double c = dot(b, x);
+                for (std::size_t i = 0; i < x.size(); ++i) x[i] -= c * b[i];
+            }
+    const double after = std::sqrt(dot(x, x));
+    if (after < 1e-8 * before) return false;
+    for (double& v : x) v /= after;
+    return true;
+}
+
+// Σ_j y[j] · v[j].
+inline std::vector<double> combine(const std::vector<std::vector<double>>& v, const std::vector<double>& y) {
+    std::vector<double> x(v.front().size(), 0.0);
+    for (std::size_t j = 0; j < v.size(); ++j)
+        for (std::size_t i = 0; i < x.size(); ++i) x[i] += y[j] * v[j][i];
+    return x;
+}
+
+}  // namespace detail
+
+// Block Davidson for the lowest eigenpairs of a real, not necessarily
+// symmetric operator A that is only available through products.
+//
+//   sigma(V, S)            S[k] = A V[k] for every vector of the batch V;
+//                          called once per iteration with all new
+//                          directions, so an implementation can share work
+//                          across them.
+//   precondition(r, value) overwrites r with an approximation of
+//                          (value - A)^-1 r (typically a diagonal solve).
+//
+// The subspace is orthonormal; its projection V^T A V is diagonalized with
+// general_eigenvalues and the lowest `roots` by real part are followed.
+// Complex pairs (a sign of near-degenerate roots) are followed by their
+// real part. Every unconverged root adds its preconditioned residual; when
+// the subspace would exceed max_subspace it collapses to the current Ritz
+// vectors. `guesses` must hold at least `roots` linearly independent vectors.
+template <class Sigma, class Precondition>
+DavidsonResult davidson(std::vector<std::vector<double>> guesses, Sigma&& sigma, Precondition&& precondition,
+                        const DavidsonOptions& opt) {
+    const auto roots = static_cast<std::size_t>(opt.roots);
+    if (roots == 0 || guesses.size() < roots) throw std::runtime_error("davidson: fewer guesses than roots");
+    const std::size_t max_subspace = opt.max_subspace > 0 ? static_cast<std::size_t>(opt.max_subspace)
+                                                          : 10 * guesses.size();
+
+    std::vector<std::vector<double>> V, S, fresh;
+    for (auto& g : guesses)
+        if (detail::orthonormalize(fresh, g)) fresh.push_back(std::move(g));
+    if (fresh.size() < roots) throw std::runtime_error("davidson: guesses are linearly dependent");
+
+    std::vector<double> G;   // V^T S, row-major m x m
+    DavidsonResult r;
+    for (r.iterations = 1; r.iterations <= opt.max_iterations; ++r.iterations) {
+        std::vector<std::vector<double>> fresh_sigma(fresh.size());
+        sigma(fresh, fresh_sigma);
+
+        // Grow G by the new rows and columns.
+        const std::size_t m0 = V.size();
+        for (std::size_t k = 0; k < fresh.size(); ++k) {
+            V.push_back(std::move(fresh[k]));
+            S.push_back(std::move(fresh_sigma[k]));
+        }
+        fresh.clear();
+        const std::size_t m = V.size();
+        std::vector<double> grown(m * m);
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t j = 0; j < m; ++j)
+                grown[i * m + j] = i < m0 && j < m0 ? G[i * m0 + j] : detail::dot(V[i], S[j]);
+        G = std::move(grown);
+
+        const GeneralEigenvalues ev = general_eigenvalues(G, static_cast<int>(m));
+        std::vector<std::size_t> order(m);
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::stable_sort(order.begin(), order.end(),
+                         [&](std::size_t a, std::size_t b) { return ev.real[a] < ev.real[b]; });
+
+        r.values.assign(roots, 0.0);
+        r.residuals.assign(roots, 0.0);
+        std::vector<std::vector<double>> ritz_coeff(roots), residual(roots);
+        r.vectors.assign(roots, {});
+        for (std::size_t k = 0; k < roots; ++k) {
+            const double value = ev.real[order[k]];
+            std::vector<double> y = general_eigenvector(G, static_cast<int>(m), value, static_cast<int>(k));
+            // A degenerate root must not repeat an earlier Ritz vector: keep
+            // only the part orthogonal to the roots it is degenerate with.
+            std::vector<std::vector<double>> same;
+            for (std::size_t j = 0; j < k; ++j)
+                if (std::abs(r.values[j] - value) <= 1e-10 * std::max(std::abs(value), 1.0)) same.push_back(ritz_coeff[j]);
+            if (!same.empty()) detail::orthonormalize(same, y);
+            r.values[k]  = value;
+            r.vectors[k] = detail::combine(V, y);
+            std::vector<double> res = detail::combine(S, y);
+            for (std::size_t i = 0; i < res.size(); ++i) res[i] -= value * r.vectors[k][i];
+            r.residuals[k] = std::sqrt(detail::dot(res, res));
+            ritz_coeff[k]  = std::move(y);
+            residual[k]    = std::move(res);
+        }
+        r.converged = std::all_of(r.residuals.begin(), r.residuals.end(),
+                                  [&](double x) { return x < opt.tolerance; });
+        if (r.converged) return r;
+
+        std::size_t unconverged = 0;
+        for (double x : r.residuals) unconverged += x < opt.tolerance ? 0 : 1;
+        if (m + unconverged > max_subspace) {
+            // Restart from the Ritz vectors, orthonormalized in coefficient
+            // space so A V follows from S without new products.
+            std::vector<std::vector<double>> Q;
+            for (auto y : ritz_coeff)
+                if (detail::orthonormalize(Q, y)) Q.push_back(std::move(y));
+            std::vector<std::vector<double>> V2, S2;
+            for (const auto& y : Q) {
+                V2.push_back(detail::combine(V, y));
+                S2.push_back(detail::combine(S, y));
+            }
+            const std::size_t m2 = Q.size();
+            std::vector<double> G2(m2 * m2);
+            for (std::size_t i = 0; i < m2; ++i)
+                for (std::size_t j = 0; j < m2; ++j) G2[i * m2 + j] = detail::dot(V2[i], S2[j]);
+            V = std::move(V2);
+            S = std::move(S2);
+            G = std::move(G2);
+        }
+
+        for (std::size_t k = 0; k < roots; ++k) {
+            if (r.residuals[k] < opt.tolerance) continue;
+            std::vector<double>& d = residual[k];
+            precondition(d, r.values[k]);
+            if (detail::orthonormalize(V, d, fresh)) fresh.push_back(std::move(d));
+        }
+        if (fresh.empty()) break;   // stagnated: nothing new to add
+    }
+    r.iterations = std::min(r.iterations, opt.max_iterations);
+    return r;
+}
+
+}  // namespace ccsd::linalg
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ccsd::linalg {
+
+// C[m x n] += alpha · A[m x k] · B[k x n], all row-major with leading
+// dimensions lda / ldb / ldc (elements). Cache-blocked, i-k-j order so the
+// innermost loop streams a row of B into a row of C at unit stride and
+// vectorizes; not a tuned BLAS, but within a small factor of one for the
+// block sizes CCSD intermediates have.
+inline void gemm(std::size_t m, std::size_t n, std::size_t k, double alpha,
+                 const double* A, std::size_t lda, const double* B, std::size_t ldb,
+                 double* C, std::size_t ldc) {
+    constexpr std::size_t bm = 64, bn = 256, bk = 128;
+    for (std::size_t i0 = 0; i0 < m; i0 += bm) {
+        const std::size_t i1 = std::min(i0 + bm, m);
+        for (std::size_t k0 = 0; k0 < k; k0 += bk) {
+            const std::size_t k1 = std::min(k0 + bk, k);
+            for (std::size_t j0 = 0; j0 < n; j0 += bn) {
+                const std::size_t j1 = std::min(j0 + bn, n);
+                for (std::size_t i = i0; i < i1; ++i) {
+                    double* c = C + i * ldc;
+                    for (std::size_t p = k0; p < k1; ++p) {
+                        const double a = alpha * A[i * lda + p];
+                        if (a == 0.0) continue;
+                        const double* b = B + p * ldb;
+                        for (std::size_t j = j0; j < j1; ++j) c[j] += a * b[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+}  // namespace ccsd::linalg
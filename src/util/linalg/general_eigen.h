@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ccsd::linalg {
+
+// Eigenvalues of a real, not necessarily symmetric matrix.
+struct GeneralEigenvalues {
+    std::vector<double> real;   // unsorted; complex pairs are adjacent
+    std::vector<double> imag;
+};
+
+// Reduction to upper Hessenberg form by stabilized elementary similarity
+// transforms, then the shifted (Francis double-shift) QR iteration
+// (Numerical Recipes §11.5-11.6). For the small projected matrices of
+// iterative eigensolvers; `a` is the row-major n x n matrix.
+inline GeneralEigenvalues general_eigenvalues(std::vector<double> a, int n) {
+    const auto N = static_cast<std::size_t>(n);
+    if (a.size() != N * N) throw std::runtime_error("general_eigenvalues: matrix is not n x n");
+    // 1-based accessor: the iteration below is written in the book's indices.
+    auto A = [&](int i, int j) -> double& {
+        return a[static_cast<std::size_t>(i - 1) * N + static_cast<std::size_t>(j - 1)];
+    };
+
+    for (int m = 2; m < n; ++m) {
+        double x = 0.0;
+        int i = m;
+        for (int j = m; j <= n; ++j)
+            if (std::abs(A(j, m - 1)) > std::abs(x)) { x = A(j, m - 1); i = j; }
+        if (i != m) {
+            for (int j = m - 1; j <= n; ++j) std::swap(A(i, j), A(m, j));
+            for (int j = 1; j <= n; ++j)     std::swap(A(j, i), A(j, m));
+        }
+        if (x != 0.0) {
+            for (i = m + 1; i <= n; ++i) {
+                double y = A(i, m - 1);
+                if (y == 0.0) continue;
+                y /= x;
+                A(i, m - 1) = y;
+                for (int j = m; j <= n; ++j) A(i, j) -= y * A(m, j);
+                for (int j = 1; j <= n; ++j) A(j, m) += y * A(j, i);
+            }
+        }
+    }
+    for (int i = 3; i <= n; ++i)
+        for (int j = 1; j < i - 1; ++j) A(i, j) = 0.0;
+
+    GeneralEigenvalues r;
+    r.real.assign(N, 0.0);
+    r.imag.assign(N, 0.0);
+    auto wr = [&](int i) -> double& { return r.real[static_cast<std::size_t>(i - 1)]; };
+    auto wi = [&](int i) -> double& { return r.imag[static_cast<std::size_t>(i - 1)]; };
+
+    double anorm = 0.0;
+    for (int i = 1; i <= n; ++i)
+        for (int j = std::max(i - 1, 1); j <= n; ++j) anorm += std::abs(A(i, j));
+    int nn = n;
+    double t = 0.0;
+    double p = 0.0, q = 0.0, rr = 0.0, s = 0.0, w = 0.0, x = 0.0, y = 0.0, z = 0.0;
+    while (nn >= 1) {
+        int its = 0;
+        int l = 0;
+        do {
+            for (l = nn; l >= 2; --l) {
+                s = std::abs(A(l - 1, l - 1)) + std::abs(A(l, l));
+                if (s == 0.0) s = anorm;
+                if (std::abs(A(l, l - 1)) + s == s) {
+                    A(l, l - 1) = 0.0;
+                    break;
+                }
+            }
+            x = A(nn, nn);
+            if (l == nn) {                     // one root found
+                wr(nn) = x + t;
+                wi(nn) = 0.0;
+                --nn;
+            } else {
+                y = A(nn - 1, nn - 1);
+                w = A(nn, nn - 1) * A(nn - 1, nn);
+                if (l == nn - 1) {             // two roots found
+                    p = 0.5 * (y - x);
+                    q = p * p + w;
+                    z = std::sqrt(std::abs(q));
+                    x += t;
+                    if (q >= 0.0) {
+                        z = p + std::copysign(z, p);
+                        wr(nn - 1) = wr(nn) = x + z;
+                        if (z != 0.0) wr(nn) = x - w / z;
+                        wi(nn - 1) = wi(nn) = 0.0;
+                    } else {
+                        wr(nn - 1) = wr(nn) = x + p;
+                        wi(nn) = z;
+                        wi(nn - 1) = -z;
+                    }
+                    nn -= 2;
+                } else {
+                    if (its == 60) throw std::runtime_error("general_eigenvalues: QR iteration did not converge");
+                    if (its == 10 || its == 20) {   // exceptional shift
+                        t += x;
+                        for (int i = 1; i <= nn; ++i) A(i, i) -= x;
+                        s = std::abs(A(nn, nn - 1)) + std::abs(A(nn - 1, nn - 2));
+                        y = x = 0.75 * s;
+                        w = -0.4375 * s * s;
+                    }
+                    ++its;
+                    int m = nn - 2;
+                    for (; m >= l; --m) {
+                        z = A(m, m);
+                        rr = x - z;
+                        s = y - z;
+                        p = (rr * s - w) / A(m + 1, m) + A(m, m + 1);
+                        q = A(m + 1, m + 1) - z - rr - s;
+                        rr = A(m + 2, m + 1);
+                        s = std::abs(p) + std::abs(q) + std::abs(rr);
+                        p /= s;
+                        q /= s;
+                        rr /= s;
+                        if (m == l) break;
+                        const double u = std::abs(A(m, m - 1)) * (std::abs(q) + std::abs(rr));
+                        const double v = std::abs(p) * (std::abs(A(m - 1, m - 1)) + std::abs(z) + std::abs(A(m + 1, m + 1)));
+                        if (u + v == v) break;
+                    }
+                    for (int i = m + 2; i <= nn; ++i) {
+                        A(i, i - 2) = 0.0;
+                        if (i != m + 2) A(i, i - 3) = 0.0;
+                    }
+                    for (int k = m; k <= nn - 1; ++k) {
+                        if (k != m) {
+                            p = A(k, k - 1);
+                            q = A(k + 1, k - 1);
+                            rr = 0.0;
+                            if (k != nn - 1) rr = A(k + 2, k - 1);
+                            if ((x = std::abs(p) + std::abs(q) + std::abs(rr)) != 0.0) {
+                                p /= x;
+                                q /= x;
+                                rr /= x;
+                            }
+                        }
+                        if ((s = std::copysign(std::sqrt(p * p + q * q + rr * rr), p)) != 0.0) {
+                            if (k == m) {
+                                if (l != m) A(k, k - 1) = -A(k, k - 1);
+                            } else {
+                                A(k, k - 1) = -s * x;
+                            }
+                            p += s;
+                            x = p / s;
+                            y = q / s;
+                            z = rr / s;
+                            q /= p;
+                            rr /= p;
+                            for (int j = k; j <= nn; ++j) {
+                                p = A(k, j) + q * A(k + 1, j);
+                                if (k != nn - 1) {
+                                    p += rr * A(k + 2, j);
+                                    A(k + 2, j) -= p * z;
+                                }
+                                A(k + 1, j) -= p * y;
+                                A(k, j) -= p * x;
+                            }
+                            const int mmin = nn < k + 3 ? nn : k + 3;
+                            for (int i = l; i <= mmin; ++i) {
+                                p = x * A(i, k) + y * A(i, k + 1);
+                                if (k != nn - 1) {
+                                    p += z * A(i, k + 2);
+                                    A(i, k + 2) -= p * rr;
+                                }
+                                A(i, k + 1) -= p * q;
+                                A(i, k) -= p;
+                            }
+                        }
+                    }
+                }
+            }
+        } while (nn >= 1 && l < nn - 1);
+    }
+    return r;
+}
+
+// Unit-norm right eigenvector of the row-major n x n `a` for the real
+// eigenvalue `lambda`, by inverse iteration: a few solves with
+// (a - lambda) shifted off exact singularity, LU with partial pivoting.
+// `seed` varies the start vector, so repeated calls for a degenerate
+// eigenvalue can reach different vectors of its eigenspace.
+inline std::vector<double> general_eigenvector(const std::vector<double>& a, int n, double lambda,
+                                               int seed = 0) {
+    const auto N = static_cast<std::size_t>(n);
+    if (a.size() != N * N) throw std::runtime_error("general_eigenvector: matrix is not n x n");
+    double norm = 0.0;
+    for (double v : a) norm = std::max(norm, std::abs(v));
+    const double shift = lambda + 1e-10 * std::max(norm, 1.0);
+
+    std::vector<double> lu(a);
+    for (std::size_t i = 0; i < N; ++i) lu[i * N + i] -= shift;
+    std::vector<std::size_t> piv(N);
+    for (std::size_t k = 0; k < N; ++k) {
+        std::size_t best = k;
+        for (std::size_t i = k + 1; i < N; ++i)
+            if (std::abs(lu[i * N + k]) > std::abs(lu[best * N + k])) best = i;
+        piv[k] = best;
+        if (best != k)
+            for (std::size_t j = 0; j < N; ++j) std::swap(lu[k * N + j], lu[best * N + j]);
+        if (lu[k * N + k] == 0.0) lu[k * N + k] = 1e-300;   // exactly singular: any large solution will do
+        for (std::size_t i = k + 1; i < N; ++i) {
+            const double f = lu[i * N + k] /= lu[k * N + k];
+            for (std::size_t j = k + 1; j < N; ++j) lu[i * N + j] -= f * lu[k * N + j];
+        }
+    }
+
+    std::vector<double> x(N);
+    for (std::size_t i = 0; i < N; ++i) x[i] = 1.0 + 0.5 * std::sin(static_cast<double>((i + 1) * static_cast<std::size_t>(seed + 1)));
+    for (int it = 0; it < 3; ++it) {
+        for (std::size_t k = 0; k < N; ++k) std::swap(x[k], x[piv[k]]);
+        for (std::size_t i = 0; i < N; ++i)
+            for (std::size_t j = 0; j < i; ++j) x[i] -= lu[i * N + j] * x[j];
+        for (std::size_t i = N; i-- > 0;) {
+            for (std::size_t j = i + 1; j < N; ++j) x[i] -= lu[i * N + j] * x[j];
+            x[i] /= lu[i * N + i];
+        }
+        double s = 0.0;
+        for (double v : x) s += v * v;
+        s = std::sqrt(s);
+        for (double& v : x) v /= s;
+    }
+    return x;
+}
+
+}  // namespace ccsd::linalg
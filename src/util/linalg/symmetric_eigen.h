@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace ccsd::linalg {
+
+// Eigen-decomposition of a real symmetric matrix.
+struct SymmetricEigen {
+    std::vector<double> values;    // ascending
+    std::vector<double> vectors;   // row-major n x n; column k belongs to values[k]
+};
+
+// Cyclic Jacobi rotations on the row-major n x n symmetric `a` (only its
+// values are read). Accurate to round-off for the small, dense matrices the
+// orbital transforms need (n up to a few hundred); not meant for large n.
+inline SymmetricEigen symmetric_eigen(std::vector<double> a, int n) {
+    const auto N = static_cast<std::size_t>(n);
+    if (a.size() != N * N) throw std::runtime_error("symmetric_eigen: matrix is not n x n");
+    auto at = [&](std::vector<double>& m, std::size_t i, std::size_t j) -> double& { return m[i * N + j]; };
+
+    std::vector<double> v(N * N, 0.0);
+    for (std::size_t i = 0; i < N; ++i) at(v, i, i) = 1.0;
+
+    double norm = 0.0;
+    for (double x : a) norm += x * x;
+    for (int sweep = 0; sweep < 100; ++sweep) {
+        double off = 0.0;
+        for (std::size_t p = 0; p < N; ++p)
+            for (std::size_t q = p + 1; q < N; ++q) off += at(a, p, q) * at(a, p, q);
+        if (off <= 1e-30 * norm || off == 0.0) break;
+
+        for (std::size_t p = 0; p < N; ++p) {
+            for (std::size_t q = p + 1; q < N; ++q) {
+                const double apq = at(a, p, q);
+                if (apq == 0.0) continue;
+                // Rotation angle that zeroes a(p,q) (Numerical Recipes §11.1).
+                const double theta = (at(a, q, q) - at(a, p, p)) / (2.0 * apq);
+                const double t = std::copysign(1.0, theta) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0);
+                const double s = t * c;
+                for (std::size_t k = 0; k < N; ++k) {   // columns p, q
+                    const double akp = at(a, k, p), akq = at(a, k, q);
+                    at(a, k, p) = c * akp - s * akq;
+                    at(a, k, q) = s * akp + c * akq;
+                }
+                for (std::size_t k = 0; k < N; ++k) {   // rows p, q
+                    const double apk = at(a, p, k), aqk = at(a, q, k);
+                    at(a, p, k) = c * apk - s * aqk;
+                    at(a, q, k) = s * apk + c * aqk;
+                }
+                for (std::size_t k = 0; k < N; ++k) {
+                    const double vkp = at(v, k, p), vkq = at(v, k, q);
+                    at(v, k, p) = c * vkp - s * vkq;
+                    at(v, k, q) = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    std::vector<std::size_t> order(N);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::size_t x, std::size_t y) { return at(a, x, x) < at(a, y, y); });
+    SymmetricEigen r;
+    r.values.resize(N);
+    r.vectors.resize(N * N);
+    for (std::size_t k = 0; k < N; ++k) {
+        r.values[k] = at(a, order[k], order[k]);
+        for (std::size_t i = 0; i < N; ++i) r.vectors[i * N + k] = at(v, i, order[k]);
+    }
+    return r;
+}
+
+}  // namespace ccsd::linalg
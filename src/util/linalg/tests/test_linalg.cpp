@@ -0,0 +1,145 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <util/linalg/davidson.h>
+#include <util/linalg/gemm.h>
+#include <util/linalg/general_eigen.h>
+#include <util/linalg/symmetric_eigen.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using Catch::Approx;
+
+TEST_CASE("symmetric_eigen diagonalizes a 2x2 matrix", "[linalg][eigen]") {
+    const auto r = ccsd::linalg::symmetric_eigen({2.0, 1.0, 1.0, 2.0}, 2);
+    REQUIRE(r.values[0] == Approx(1.0));
+    REQUIRE(r.values[1] == Approx(3.0));
+    REQUIRE(std::abs(r.vectors[0 * 2 + 1]) == Approx(std::sqrt(0.5)));
+    REQUIRE(r.vectors[0 * 2 + 1] == Approx(r.vectors[1 * 2 + 1]));   // (1,1)/√2 for 3
+}
+
+TEST_CASE("symmetric_eigen returns an orthonormal basis that reproduces the matrix", "[linalg][eigen]") {
+    const int n = 7;
+    const auto N = static_cast<std::size_t>(n);
+    std::vector<double> a(N * N);
+    for (std::size_t i = 0; i < N; ++i)
+        for (std::size_t j = 0; j <= i; ++j)
+            a[i * N + j] = a[j * N + i] = std::sin(1.7 * static_cast<double>(i * N + j)) + (i == j ? 2.0 : 0.0);
+
+    const auto r = ccsd::linalg::symmetric_eigen(a, n);
+    for (std::size_t k = 1; k < N; ++k) REQUIRE(r.values[k - 1] <= r.values[k]);
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            double vtv = 0.0, vdv = 0.0;
+            for (std::size_t k = 0; k < N; ++k) {
+                vtv += r.vectors[k * N + i] * r.vectors[k * N + j];
+                vdv += r.vectors[i * N + k] * r.values[k] * r.vectors[j * N + k];
+            }
+            REQUIRE(vtv == Approx(i == j ? 1.0 : 0.0).margin(1e-12));
+            REQUIRE(vdv == Approx(a[i * N + j]).margin(1e-12));
+        }
+    }
+}
+
+TEST_CASE("symmetric_eigen rejects a non-square input", "[linalg][eigen]") {
+    REQUIRE_THROWS(ccsd::linalg::symmetric_eigen({1.0, 2.0, 3.0}, 2));
+}
+
+TEST_CASE("gemm accumulates alpha A B across block boundaries", "[linalg][gemm]") {
+    // Sizes straddle the 64 / 256 / 128 blocks; leading dimensions are padded.
+    const std::size_t m = 70, n = 260, k = 130, lda = k + 3, ldb = n + 1, ldc = n + 2;
+    std::vector<double> A(m * lda), B(k * ldb), C(m * ldc, 1.0);
+    for (std::size_t i = 0; i < A.size(); ++i) A[i] = std::sin(0.37 * static_cast<double>(i));
+    for (std::size_t i = 0; i < B.size(); ++i) B[i] = std::cos(0.11 * static_cast<double>(i));
+
+    ccsd::linalg::gemm(m, n, k, -0.5, A.data(), lda, B.data(), ldb, C.data(), ldc);
+    for (std::size_t i = 0; i < m; i += 3) {
+        for (std::size_t j = 0; j < n; j += 7) {
+            double ref = 0.0;
+            for (std::size_t p = 0; p < k; ++p) ref += A[i * lda + p] * B[p * ldb + j];
+            REQUIRE(C[i * ldc + j] == Approx(1.0 - 0.5 * ref).margin(1e-12));
+        }
+    }
+    REQUIRE(C[0 * ldc + n] == 1.0);   // padding untouched
+}
+
+TEST_CASE("general_eigenvalues finds real and complex eigenvalues", "[linalg][eigen]") {
+    // S diag(1, 2, 5) S^-1 with S = [[1,1,0],[0,1,1],[1,0,1]] (det 2), plus a
+    // 2x2 rotation-scaling block with eigenvalues 3 ± 2i.
+    const std::vector<double> a{
+         1.5, 0.5, -0.5, 0.0, 0.0,
+        -1.5, 3.5,  1.5, 0.0, 0.0,
+        -2.0, 2.0,  3.0, 0.0, 0.0,
+        0.0,  0.0,  0.0, 3.0, -2.0,
+        0.0,  0.0,  0.0, 2.0, 3.0};
+    const auto ev = ccsd::linalg::general_eigenvalues(a, 5);
+    std::vector<double> real_roots, complex_re, complex_im;
+    for (std::size_t k = 0; k < 5; ++k) {
+        if (ev.imag[k] == 0.0) real_roots.push_back(ev.real[k]);
+        else { complex_re.push_back(ev.real[k]); complex_im.push_back(std::abs(ev.imag[k])); }
+    }
+    std::sort(real_roots.begin(), real_roots.end());
+    REQUIRE(real_roots.size() == 3);
+    REQUIRE(real_roots[0] == Approx(1.0));
+    REQUIRE(real_roots[1] == Approx(2.0));
+    REQUIRE(real_roots[2] == Approx(5.0));
+    REQUIRE(complex_re.size() == 2);
+    REQUIRE(complex_re[0] == Approx(3.0));
+    REQUIRE(complex_im[0] == Approx(2.0));
+
+    // The eigenvector of 2 is S's second column, (1, 1, 0).
+    const auto x = ccsd::linalg::general_eigenvector(a, 5, 2.0);
+    REQUIRE(std::abs(x[0]) == Approx(std::sqrt(0.5)));
+    REQUIRE(x[1] == Approx(x[0]));
+    REQUIRE(x[2] == Approx(0.0).margin(1e-10));
+    REQUIRE(x[3] == Approx(0.0).margin(1e-10));
+}
+
+TEST_CASE("davidson finds the lowest eigenpairs of a nonsymmetric matrix", "[linalg][davidson]") {
+    // Diagonally dominant, nonsymmetric; checked against the dense solver.
+    const int n = 120;
+    const auto N = static_cast<std::size_t>(n);
+    std::vector<double> a(N * N);
+    for (std::size_t i = 0; i < N; ++i)
+        for (std::size_t j = 0; j < N; ++j)
+            a[i * N + j] = i == j ? 1.0 + 0.5 * static_cast<double>(i)
+                                  : 0.05 * std::sin(0.7 * static_cast<double>(i) + 1.3 * static_cast<double>(j))
+                                    + (j > i ? 0.02 : 0.0);
+    auto dense = ccsd::linalg::general_eigenvalues(a, n).real;
+    std::sort(dense.begin(), dense.end());
+
+    int batches = 0;
+    auto sigma = [&](const std::vector<std::vector<double>>& V, std::vector<std::vector<double>>& S) {
+        ++batches;
+        for (std::size_t k = 0; k < V.size(); ++k) {
+            S[k].assign(N, 0.0);
+            for (std::size_t i = 0; i < N; ++i)
+                for (std::size_t j = 0; j < N; ++j) S[k][i] += a[i * N + j] * V[k][j];
+        }
+    };
+    auto precondition = [&](std::vector<double>& r, double value) {
+        for (std::size_t i = 0; i < N; ++i) {
+            const double d = value - a[i * N + i];
+            r[i] /= std::abs(d) > 1e-6 ? d : 1e-6;
+        }
+    };
+    std::vector<std::vector<double>> guesses(4, std::vector<double>(N, 0.0));
+    for (std::size_t k = 0; k < guesses.size(); ++k) guesses[k][k] = 1.0;
+
+    ccsd::linalg::DavidsonOptions opt;
+    opt.roots = 3;
+    opt.tolerance = 1e-9;
+    opt.max_subspace = 12;   // forces at least one collapse
+    const auto r = ccsd::linalg::davidson(guesses, sigma, precondition, opt);
+    REQUIRE(r.converged);
+    REQUIRE(batches == r.iterations);
+    for (std::size_t k = 0; k < 3; ++k) {
+        REQUIRE(r.values[k] == Approx(dense[k]).epsilon(1e-10));
+        std::vector<std::vector<double>> ax(1);
+        sigma({r.vectors[k]}, ax);
+        for (std::size_t i = 0; i < N; ++i) REQUIRE(ax[0][i] == Approx(r.values[k] * r.vectors[k][i]).margin(1e-8));
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+namespace ccsd::memory {
+
+// Named byte counts of the large buffers one rank holds. Filled either from
+// live tensors (after allocation) or analytically (a dry-run plan).
+class MemoryRegistry {
+public:
+    struct Entry {
+        std::string name;
+        std::size_t bytes = 0;
+    };
+
+    void record(std::string name, std::size_t bytes) {
+        for (auto& e : entries_) {
+            if (e.name == name) { e.bytes = bytes; return; }
+        }
+        entries_.push_back({std::move(name), bytes});
+    }
+
+    void clear() { entries_.clear(); }
+
+    [[nodiscard]] const std::vector<Entry>& entries() const noexcept { return entries_; }
+
+    [[nodiscard]] std::size_t total_bytes() const noexcept {
+        std::size_t sum = 0;
+        for (const auto& e : entries_) sum += e.bytes;
+        return sum;
+    }
+
+private:
+    std::vector<Entry> entries_;
+};
+
+// Process high-water mark (peak resident set) in bytes; 0 where unsupported.
+inline std::size_t peak_rss_bytes() {
+#ifdef __linux__
+    rusage ru{};
+    if (getrusage(RUSAGE_SELF, &ru) == 0)
+        return static_cast<std::size_t>(ru.ru_maxrss) * 1024;   // ru_maxrss is KiB on Linux
+#endif
+    return 0;
+}
+
+// Human-readable size with binary prefixes, e.g. "1.50 GiB".
+inline std::string format_bytes(std::size_t bytes) {
+    static constexpr const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB", "PiB"};
+    auto v = static_cast<double>(bytes);
+    std::size_t u = 0;
+    while (v >= 1024.0 && u + 1 < std::size(units)) { v /= 1024.0; ++u; }
+    char buf[32];
+    if (u == 0) std::snprintf(buf, sizeof(buf), "%zu B", bytes);
+    else        std::snprintf(buf, sizeof(buf), "%.2f %s", v, units[u]);
+    return buf;
+}
+
+// One line per entry plus the total, names padded to a common width.
+inline void write_table(std::ostream& os, const MemoryRegistry& reg) {
+    std::size_t width = 5;
+    for (const auto& e : reg.entries()) width = std::max(width, e.name.size());
+    for (const auto& e : reg.entries())
+        os << "  " << e.name << std::string(width - e.name.size() + 2, ' ')
+           << format_bytes(e.bytes) << "\n";
+    os << "  total" << std::string(width - 5 + 2, ' ') << format_bytes(reg.total_bytes()) << "\n";
+}
+
+}  // namespace ccsd::memory
@@ -0,0 +1,28 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <util/memory/memory_registry.h>
+
+TEST_CASE("MemoryRegistry sums entries and overwrites by name", "[memory]") {
+    ccsd::memory::MemoryRegistry reg;
+    reg.record("a", 100);
+    reg.record("b", 28);
+    REQUIRE(reg.total_bytes() == 128);
+
+    reg.record("a", 10);
+    REQUIRE(reg.entries().size() == 2);
+    REQUIRE(reg.total_bytes() == 38);
+}
+
+TEST_CASE("format_bytes uses binary prefixes", "[memory]") {
+    REQUIRE(ccsd::memory::format_bytes(512) == "512 B");
+    REQUIRE(ccsd::memory::format_bytes(1536) == "1.50 KiB");
+    REQUIRE(ccsd::memory::format_bytes(std::size_t{3} << 30) == "3.00 GiB");
+}
+
+TEST_CASE("peak_rss_bytes reports a nonzero high-water mark on Linux", "[memory]") {
+#ifdef __linux__
+    REQUIRE(ccsd::memory::peak_rss_bytes() > 0);
+#else
+    SUCCEED();
+#endif
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace ccsd {
+
+// Rank-4 tensor over one index space whose entries carry labels of an Abelian
+// group with XOR as its product (irreps of D2h and its subgroups, optionally
+// combined with Sz). Only blocks with label(i)^label(j)^label(k)^label(l) == 0
+// are stored; reading any other element returns 0. Each stored block is
+// row-major over the positions of its indices within their label.
+// With no labels every index has label 0 and the tensor is dense.
+class BlockSparse4D {
+public:
+    int rank = 0;
+
+    BlockSparse4D() = default;
+
+    // Element count initialization(dim, labels) will allocate.
+    [[nodiscard]] static std::size_t elements_for(int dim, const std::vector<int>& labels = {}) {
+        BlockSparse4D t;
+        t.layout(dim, labels);
+        return t.n_size_;
+    }
+
+    void initialization(int dim, const std::vector<int>& labels = {}) {
+        layout(dim, labels);
+        data_.assign(n_size_, 0.0);
+    }
+
+    void zeros() { std::fill(data_.begin(), data_.end(), 0.0); }
+
+    [[nodiscard]] bool allowed(int i, int j, int k, int l) const noexcept {
+        return (label(i) ^ label(j) ^ label(k) ^ label(l)) == 0;
+    }
+
+    [[nodiscard]] double operator()(int i, int j, int k, int l) const {
+        assert(in_range(i, j, k, l));
+        return allowed(i, j, k, l) ? data_[index(i, j, k, l)] : 0.0;
+    }
+    // Only symmetry-allowed elements may be written.
+    [[nodiscard]] double& operator()(int i, int j, int k, int l) {
+        assert(in_range(i, j, k, l) && allowed(i, j, k, l));
+        return data_[index(i, j, k, l)];
+    }
+
+    [[nodiscard]] int n_labels() const noexcept { return h_; }
+    [[nodiscard]] std::size_t n_size() const noexcept { return n_size_; }
+    [[nodiscard]] double* raw() noexcept { return data_.data(); }
+    [[nodiscard]] const double* raw() const noexcept { return data_.data(); }
+
+private:
+    void layout(int dim, const std::vector<int>& labels) {
+        assert(labels.empty() || static_cast<int>(labels.size()) == dim);
+        n_ = dim;
+        label_ = labels.empty() ? std::vector<int>(static_cast<std::size_t>(dim), 0) : labels;
+        const int max_label = label_.empty() ? 0 : *std::max_element(label_.begin(), label_.end());
+        h_ = static_cast<int>(std::bit_ceil(static_cast<unsigned>(max_label) + 1u));
+
+        const auto h = static_cast<std::size_t>(h_);
+        count_.assign(h, 0);
+        pos_.assign(label_.size(), 0);
+        for (std::size_t p = 0; p < label_.size(); ++p)
+            pos_[p] = count_[static_cast<std::size_t>(label_[p])]++;
+
+        block_.assign(h * h * h, 0);
+        n_size_ = 0;
+        for (std::size_t a = 0; a < h; ++a)
+            for (std::size_t b = 0; b < h; ++b)
+                for (std::size_t c = 0; c < h; ++c) {
+                    block_[(a * h + b) * h + c] = n_size_;
+                    n_size_ += count_[a] * count_[b] * count_[c] * count_[a ^ b ^ c];
+                }
+    }
+
+    [[nodiscard]] int label(int p) const noexcept { return label_[static_cast<std::size_t>(p)]; }
+
+    [[nodiscard]] bool in_range(int i, int j, int k, int l) const noexcept {
+        return i >= 0 && i < n_ && j >= 0 && j < n_ && k >= 0 && k < n_ && l >= 0 && l < n_;
+    }
+
+    [[nodiscard]] std::size_t index(int i, int j, int k, int l) const noexcept {
+        const auto h  = static_cast<std::size_t>(h_);
+        const auto gi = static_cast<std::size_t>(label(i));
+        const auto gj = static_cast<std::size_t>(label(j));
+        const auto gk = static_cast<std::size_t>(label(k));
+        const auto gl = static_cast<std::size_t>(label(l));
+        const auto u  = [&](int p) { return pos_[static_cast<std::size_t>(p)]; };
+        return block_[(gi * h + gj) * h + gk]
+             + ((u(i) * count_[gj] + u(j)) * count_[gk] + u(k)) * count_[gl] + u(l);
+    }
+
+    int n_ = 0;
+    int h_ = 1;
+    std::vector<int> label_;
+    std::vector<std::size_t> pos_;     // position of each index within its label
+    std::vector<std::size_t> count_;   // indices per label
+    std::vector<std::size_t> block_;   // offset of block (label i, label j, label k)
+    std::size_t n_size_ = 0;
+    std::vector<double> data_;
+};
+
+}  // namespace ccsd
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace ccsd {
+
+// Storage order of a dense Rank-dimensional tensor: `order` lists the
+// dimensions from slowest- to fastest-varying, so row-major 4-D is
+// {0,1,2,3} and column-major is {3,2,1,0}. Chosen per tensor, so each one
+// can be stored the way its hottest loop reads it.
+template <std::size_t Rank>
+struct Layout {
+    std::array<int, Rank> order{};
+
+    [[nodiscard]] static constexpr Layout row_major() noexcept {
+        Layout l;
+        for (std::size_t d = 0; d < Rank; ++d) l.order[d] = static_cast<int>(d);
+        return l;
+    }
+    [[nodiscard]] static constexpr Layout column_major() noexcept {
+        Layout l;
+        for (std::size_t d = 0; d < Rank; ++d) l.order[d] = static_cast<int>(Rank - 1 - d);
+        return l;
+    }
+    // Default for Vector2D / Vector4D: the build-wide CCSD_LAYOUT_ROW_MAJOR choice.
+    [[nodiscard]] static constexpr Layout standard() noexcept {
+#ifdef CCSD_LAYOUT_ROW_MAJOR
+        return row_major();
+#else
+        return column_major();
+#endif
+    }
+
+    // Element strides of each dimension for the given extents.
+    [[nodiscard]] constexpr std::array<std::ptrdiff_t, Rank> strides(const std::array<int, Rank>& extents) const noexcept {
+        std::array<std::ptrdiff_t, Rank> s{};
+        std::ptrdiff_t step = 1;
+        for (std::size_t k = Rank; k-- > 0;) {
+            const auto d = static_cast<std::size_t>(order[k]);
+            s[d] = step;
+            step *= extents[d];
+        }
+        return s;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const Layout&) const noexcept = default;
+};
+
+}  // namespace ccsd
@@ -5,32 +5,35 @@
 #include <util/tensors/vector_2d.h>
 #include <util/tensors/vector_4d.h>
 
-namespace ccsd {
-
-}  // namespace ccsd
+#include <array>
+#include <cstddef>
 #include <experimental/mdspan>
+
 namespace ccsd {
 
-// View the existing column-major storage (j*n1 + i) as a 2-D mdspan.
+namespace detail {
+
+// layout_stride mdspan over a tensor's own extents and strides, so each
+// tensor is viewed in whatever layout it was initialized or relaid out in.
+template <std::size_t Rank, class Ext>
+auto strided_mdspan(double* data, const TensorView<Rank>& v) {
+    using mapping = typename std::experimental::layout_stride::template mapping<Ext>;
+    std::array<int, Rank> strides{};
+    for (std::size_t d = 0; d < Rank; ++d) strides[d] = static_cast<int>(v.strides[d]);
+    return std::experimental::mdspan<double, Ext, std::experimental::layout_stride>(
+        data, mapping(Ext(v.extents), strides));
+}
+
+}  // namespace detail
+
 inline auto as_mdspan(Vector2D& v) {
-    using ext = std::experimental::extents<int,
-        std::experimental::dynamic_extent,
-        std::experimental::dynamic_extent>;
-    return std::experimental::mdspan<double, ext, std::experimental::layout_left>(
-        v.raw(), v.n1(), v.n2());
+    using ext = std::experimental::dextents<int, 2>;
+    return detail::strided_mdspan<2, ext>(v.raw(), v.view());
 }
 
-// 4-D, column-major: index(i,j,k,l) = ((l*N3 + k)*N2 + j)*N1 + i.
 inline auto as_mdspan(Vector4D& v) {
-    using ext = std::experimental::extents<int,
-        std::experimental::dynamic_extent,
-        std::experimental::dynamic_extent,
-        std::experimental::dynamic_extent,
-        std::experimental::dynamic_extent>;
-    int n = v.n_size();  int dim = 0;
-    for (int d = 1; (d * d * d * d) <= n; ++d) dim = d;
-    return std::experimental::mdspan<double, ext, std::experimental::layout_left>(
-        v.raw(), dim, dim, dim, dim);
+    using ext = std::experimental::dextents<int, 4>;
+    return detail::strided_mdspan<4, ext>(v.raw(), v.view());
 }
 
 }  // namespace ccsd
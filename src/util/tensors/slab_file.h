@@ -0,0 +1,192 @@
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <sys/types.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ccsd {
+
+// Scratch file of fixed-size slabs of doubles, for tensors that do not fit in
+// memory. Slab s occupies bytes [s, s+1) · slab_elements · 8; reads and writes
+// are positioned (pread/pwrite), so concurrent reads of different slabs are
+// safe. The file is unlinked when the SlabFile is destroyed.
+class SlabFile {
+public:
+    SlabFile() = default;
+    SlabFile(const std::string& path, std::size_t slab_elements) { create(path, slab_elements); }
+    ~SlabFile() { close(); }
+
+    SlabFile(const SlabFile&) = delete;
+    SlabFile& operator=(const SlabFile&) = delete;
+    SlabFile(SlabFile&& o) noexcept { *this = std::move(o); }
+    SlabFile& operator=(SlabFile&& o) noexcept {
+        if (this != &o) {
+            close();
+            path_     = std::exchange(o.path_, {});
+            fd_       = std::exchange(o.fd_, -1);
+            elements_ = std::exchange(o.elements_, 0);
+        }
+        return *this;
+    }
+
+    // Creates (or truncates) `path`.
+    void create(const std::string& path, std::size_t slab_elements) {
+        close();
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (fd_ < 0) throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+        path_     = path;
+        elements_ = slab_elements;
+    }
+
+    [[nodiscard]] bool is_open() const noexcept { return fd_ >= 0; }
+    [[nodiscard]] std::size_t slab_elements() const noexcept { return elements_; }
+    [[nodiscard]] const std::string& path() const noexcept { return path_; }
+
+    // Slabs [first, first + count) from / into contiguous memory.
+    void write(std::size_t first, std::size_t count, const double* src) {
+        transfer(first, count, const_cast<double*>(src), true);   // pwrite only reads it
+    }
+    void read(std::size_t first, std::size_t count, double* dst) const {
+        transfer(first, count, dst, false);
+    }
+
+private:
+    std::string path_;
+    int fd_ = -1;
+    std::size_t elements_ = 0;
+
+    void close() noexcept {
+        if (fd_ < 0) return;
+        ::close(fd_);
+        ::unlink(path_.c_str());
+        fd_ = -1;
+    }
+
+    void transfer(std::size_t first, std::size_t count, double* buf, bool out) const {
+        auto* p        = reinterpret_cast<char*>(buf);
+        std::size_t n  = count * elements_ * sizeof(double);
+        auto offset    = static_cast<off_t>(first * elements_ * sizeof(double));
+        while (n > 0) {
+            const ssize_t done = out ? ::pwrite(fd_, p, n, offset) : ::pread(fd_, p, n, offset);
+            if (done < 0 && errno == EINTR) continue;
+            if (done <= 0)
+                throw std::runtime_error(path_ + (out ? ": write failed" : ": read past end of file"));
+            p      += done;
+            n      -= static_cast<std::size_t>(done);
+            offset += done;
+        }
+    }
+};
+
+// Double-buffered reader over a SlabFile: a local I/O thread fills one buffer
+// while the caller computes on the other. Ranges are delivered in the order
+// they were requested; at most two may be outstanding (one being read, one
+// handed out by wait()).
+class SlabPrefetcher {
+public:
+    // `max_slabs`: largest range a single prefetch() may request.
+    SlabPrefetcher(const SlabFile& file, std::size_t max_slabs) : file_(file) {
+        for (auto& b : buffers_) b.resize(max_slabs * file.slab_elements());
+        worker_ = std::thread([this] { serve(); });
+    }
+    ~SlabPrefetcher() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        worker_.join();
+    }
+
+    SlabPrefetcher(const SlabPrefetcher&) = delete;
+    SlabPrefetcher& operator=(const SlabPrefetcher&) = delete;
+
+    [[nodiscard]] std::size_t bytes() const noexcept {
+        return 2 * buffers_[0].size() * sizeof(double);
+    }
+
+    // Queues slabs [first, first + count) into the next free buffer. Reusing
+    // that buffer invalidates the range returned by the wait() before last.
+    void prefetch(std::size_t first, std::size_t count) {
+        if (count * file_.slab_elements() > buffers_[0].size())
+            throw std::runtime_error("SlabPrefetcher: range exceeds the buffer");
+        {
+            std::lock_guard lock(mutex_);
+            queue_.push_back({first, count, next_buffer_, false});
+            next_buffer_ ^= 1;
+        }
+        cv_.notify_all();
+    }
+
+    // Blocks until the oldest queued range is in memory and returns it; it
+    // stays valid until the second prefetch() after this call.
+    const double* wait() {
+        std::unique_lock lock(mutex_);
+        cv_.wait(lock, [&] { return error_ || (!queue_.empty() && queue_.front().done); });
+        if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+        const std::size_t b = queue_.front().buffer;
+        queue_.pop_front();
+        cv_.notify_all();
+        return buffers_[b].data();
+    }
+
+private:
+    struct Request {
+        std::size_t first, count, buffer;
+        bool done;
+    };
+
+    const SlabFile& file_;
+    std::array<std::vector<double>, 2> buffers_;
+    std::deque<Request> queue_;
+    std::size_t next_buffer_ = 0;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::exception_ptr error_;
+    bool stop_ = false;
+    std::thread worker_;
+
+    void serve() {
+        std::unique_lock lock(mutex_);
+        for (;;) {
+            Request* r = nullptr;
+            cv_.wait(lock, [&] { return stop_ || (r = pending()) != nullptr; });
+            if (stop_ || r == nullptr) return;
+            const Request job = *r;
+            lock.unlock();
+            std::exception_ptr err;
+            try {
+                file_.read(job.first, job.count, buffers_[job.buffer].data());
+            } catch (...) {
+                err = std::current_exception();
+            }
+            lock.lock();
+            r->done = true;   // deque elements stay put while queued
+            if (err) error_ = err;
+            cv_.notify_all();
+        }
+    }
+
+    // Oldest request not read yet, or nullptr.
+    Request* pending() {
+        for (auto& r : queue_)
+            if (!r.done) return &r;
+        return nullptr;
+    }
+};
+
+}  // namespace ccsd
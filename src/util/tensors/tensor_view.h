@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <util/tensors/layout.h>
+
+namespace ccsd {
+
+// Non-owning, read-only view of a dense Rank-dimensional array of doubles
+// with arbitrary element strides (row-major, column-major, or any
+// permutation of either). Used to hand caller-owned buffers to the solver
+// and to expose solver-owned tensors without copying; the viewed memory must
+// outlive the view.
+template <std::size_t Rank>
+struct TensorView {
+    const double* data = nullptr;
+    std::array<int, Rank> extents{};
+    std::array<std::ptrdiff_t, Rank> strides{};   // in elements
+
+    [[nodiscard]] bool empty() const noexcept { return data == nullptr; }
+
+    template <class... I>
+    [[nodiscard]] double operator()(I... idx) const noexcept {
+        static_assert(sizeof...(I) == Rank, "one index per dimension");
+        const std::array<std::ptrdiff_t, Rank> i{static_cast<std::ptrdiff_t>(idx)...};
+        std::ptrdiff_t off = 0;
+        for (std::size_t d = 0; d < Rank; ++d) off += i[d] * strides[d];
+        return data[off];
+    }
+
+    // Strided sub-view of the box [lo, lo + extents); shares the data.
+    [[nodiscard]] TensorView sub(const std::array<int, Rank>& lo, const std::array<int, Rank>& sub_extents) const noexcept {
+        std::ptrdiff_t off = 0;
+        for (std::size_t d = 0; d < Rank; ++d) off += lo[d] * strides[d];
+        return {data + off, sub_extents, strides};
+    }
+
+    [[nodiscard]] static TensorView with_layout(const double* data, std::array<int, Rank> extents,
+                                                const Layout<Rank>& layout) noexcept {
+        return {data, extents, layout.strides(extents)};
+    }
+    // Last index fastest (C order).
+    [[nodiscard]] static TensorView row_major(const double* data, std::array<int, Rank> extents) noexcept {
+        return with_layout(data, extents, Layout<Rank>::row_major());
+    }
+    // First index fastest (Fortran order).
+    [[nodiscard]] static TensorView column_major(const double* data, std::array<int, Rank> extents) noexcept {
+        return with_layout(data, extents, Layout<Rank>::column_major());
+    }
+};
+
+}  // namespace ccsd
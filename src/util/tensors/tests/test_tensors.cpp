@@ -2,8 +2,20 @@
 
 #include <util/tensors/vector_2d.h>
 #include <util/tensors/vector_4d.h>
+#include <util/tensors/block_sparse_4d.h>
+#include <util/tensors/slab_file.h>
+#include <util/tensors/transpose.h>
 #include <experimental/mdspan>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #ifndef CCSD_LAYOUT_ROW_MAJOR
 TEST_CASE("Vector2D index encoding matches legacy layout", "[tensor][2d]") {
     ccsd::Vector2D v;
@@ -103,3 +115,153 @@ TEST_CASE("mdspan reference impl is available", "[mdspan][smoke]") {
     REQUIRE(view.extent(0) == 3);
     REQUIRE(view.extent(1) == 4);
 }
+
+TEST_CASE("n_size is a 64-bit element count", "[tensor][size]") {
+    ccsd::Vector4D t;
+    t.initialization(5);
+    static_assert(std::is_same_v<decltype(t.n_size()), std::size_t>);
+    REQUIRE(t.n_size() == std::size_t{625});
+
+    ccsd::Vector2D v;
+    v.initialization(7);
+    static_assert(std::is_same_v<decltype(v.n_size()), std::size_t>);
+    REQUIRE(v.n_size() == std::size_t{49});
+}
+
+TEST_CASE("Layout strides follow the slow-to-fast dimension order", "[tensor][layout]") {
+    using L4 = ccsd::Layout<4>;
+    const std::array<int, 4> ext = {2, 3, 4, 5};
+    REQUIRE(L4::row_major().strides(ext) == std::array<std::ptrdiff_t, 4>{60, 20, 5, 1});
+    REQUIRE(L4::column_major().strides(ext) == std::array<std::ptrdiff_t, 4>{1, 2, 6, 24});
+    REQUIRE(L4{{2, 0, 3, 1}}.strides(ext) == std::array<std::ptrdiff_t, 4>{15, 1, 30, 3});
+}
+
+TEST_CASE("Per-tensor layouts address the same elements and relayout preserves them", "[tensor][layout]") {
+    ccsd::Vector4D a, b;
+    a.initialization(5);
+    b.initialization(5, ccsd::Layout<4>{{2, 0, 3, 1}});
+    for (int i = 0; i < 5; ++i)
+        for (int j = 0; j < 5; ++j)
+            for (int k = 0; k < 5; ++k)
+                for (int l = 0; l < 5; ++l)
+                    a(i, j, k, l) = b(i, j, k, l) = ((i * 7 + j) * 11 + k) * 13 + l;
+    REQUIRE(b.offset(0, 1, 0, 0) == 1);   // dimension 1 is fastest
+
+    b.relayout(ccsd::Layout<4>::standard());
+    REQUIRE(std::equal(a.raw(), a.raw() + a.n_size(), b.raw()));
+    a.relayout(ccsd::Layout<4>{{3, 1, 2, 0}});
+    REQUIRE(a.offset(1, 0, 0, 0) == 1);
+    REQUIRE(std::as_const(a)(4, 3, 2, 1) == ((4 * 7 + 3) * 11 + 2) * 13 + 1);
+
+    ccsd::Vector2D m;
+    m.initialization(3, ccsd::Layout<2>::row_major());
+    m(1, 2) = 5.0;
+    m.relayout(ccsd::Layout<2>::column_major());
+    REQUIRE(m.raw()[2 * 3 + 1] == 5.0);
+    REQUIRE(std::as_const(m)(1, 2) == 5.0);
+}
+
+TEST_CASE("Strided sub-views address the parent's elements", "[tensor][layout]") {
+    ccsd::Vector4D t;
+    t.initialization(4);
+    t(3, 2, 1, 2) = 9.0;
+    const auto box = t.view().sub({2, 1, 0, 1}, {2, 2, 2, 2});
+    REQUIRE(box.extents == std::array<int, 4>{2, 2, 2, 2});
+    REQUIRE(box(1, 1, 1, 1) == 9.0);
+    REQUIRE(box(0, 0, 0, 0) == 0.0);
+}
+
+TEST_CASE("Blocked transpose matches an element-wise permutation", "[tensor][transpose]") {
+    // Larger than one block, odd extents, source itself a strided sub-view.
+    const std::array<int, 4> full = {9, 8, 13, 11};
+    std::vector<double> src(9 * 8 * 13 * 11);
+    for (std::size_t x = 0; x < src.size(); ++x) src[x] = static_cast<double>(x);
+    const auto view = ccsd::TensorView<4>::row_major(src.data(), full).sub({1, 0, 2, 1}, {7, 8, 10, 9});
+
+    for (const ccsd::Layout<4>& layout : {ccsd::Layout<4>::row_major(), ccsd::Layout<4>::column_major(),
+                                         ccsd::Layout<4>{{3, 0, 2, 1}}}) {
+        const std::vector<double> out = ccsd::transpose(view, layout);
+        const auto dst = ccsd::TensorView<4>::with_layout(out.data(), view.extents, layout);
+        std::size_t mismatches = 0;
+        for (int i = 0; i < 7; ++i)
+            for (int j = 0; j < 8; ++j)
+                for (int k = 0; k < 10; ++k)
+                    for (int l = 0; l < 9; ++l)
+                        if (dst(i, j, k, l) != view(i, j, k, l)) ++mismatches;
+        REQUIRE(mismatches == 0);
+    }
+}
+
+TEST_CASE("BlockSparse4D stores only label-conserving blocks", "[tensor][block_sparse]") {
+    // Labels 0,1,0,1,2: counts {2,2,1,0}; the allowed fraction is well below n^4.
+    const std::vector<int> labels = {0, 1, 0, 1, 2};
+    ccsd::BlockSparse4D t;
+    t.initialization(5, labels);
+    REQUIRE(t.n_labels() == 4);
+    REQUIRE(t.n_size() == ccsd::BlockSparse4D::elements_for(5, labels));
+
+    std::size_t allowed = 0;
+    for (int i = 0; i < 5; ++i)
+        for (int j = 0; j < 5; ++j)
+            for (int k = 0; k < 5; ++k)
+                for (int l = 0; l < 5; ++l)
+                    if (t.allowed(i, j, k, l)) t(i, j, k, l) = static_cast<double>(++allowed);
+    REQUIRE(t.n_size() == allowed);
+    REQUIRE(allowed < std::size_t{625});
+
+    // Every allowed element has its own slot; forbidden ones read as zero.
+    std::size_t n = 0;
+    for (int i = 0; i < 5; ++i)
+        for (int j = 0; j < 5; ++j)
+            for (int k = 0; k < 5; ++k)
+                for (int l = 0; l < 5; ++l) {
+                    const ccsd::BlockSparse4D& c = t;
+                    if (t.allowed(i, j, k, l)) REQUIRE(c(i, j, k, l) == static_cast<double>(++n));
+                    else                      REQUIRE(c(i, j, k, l) == 0.0);
+                }
+}
+
+TEST_CASE("BlockSparse4D without labels is dense", "[tensor][block_sparse]") {
+    ccsd::BlockSparse4D t;
+    t.initialization(3);
+    REQUIRE(t.n_labels() == 1);
+    REQUIRE(t.n_size() == ccsd::Vector4D::elements_for(3));
+    t(2, 1, 0, 2) = 4.0;
+    REQUIRE(std::as_const(t)(2, 1, 0, 2) == 4.0);
+    t.zeros();
+    REQUIRE(std::as_const(t)(2, 1, 0, 2) == 0.0);
+}
+
+TEST_CASE("SlabFile round-trips slabs and SlabPrefetcher delivers them in order", "[tensor][slab_file]") {
+    const std::size_t n = 5, n_slabs = 7;
+    ccsd::SlabFile f("test_tensors_slabs.bin", n);
+    std::vector<double> all(n * n_slabs);
+    for (std::size_t k = 0; k < all.size(); ++k) all[k] = static_cast<double>(k) * 0.5;
+    f.write(0, 3, all.data());
+    f.write(3, n_slabs - 3, all.data() + 3 * n);
+
+    std::vector<double> back(n * 2);
+    f.read(4, 2, back.data());
+    REQUIRE(std::vector<double>(all.begin() + 4 * n, all.begin() + 6 * n) == back);
+
+    // Ranges of two slabs, always one ahead of the consumer.
+    ccsd::SlabPrefetcher stream(f, 2);
+    REQUIRE(stream.bytes() == 2 * 2 * n * sizeof(double));
+    stream.prefetch(0, 2);
+    for (std::size_t first = 0; first < n_slabs; first += 2) {
+        if (first + 2 < n_slabs) stream.prefetch(first + 2, std::min<std::size_t>(2, n_slabs - first - 2));
+        const double* got = stream.wait();
+        for (std::size_t k = 0; k < n * std::min<std::size_t>(2, n_slabs - first); ++k)
+            REQUIRE(got[k] == all[first * n + k]);
+    }
+    REQUIRE_THROWS_AS(stream.prefetch(0, 3), std::runtime_error);
+}
+
+TEST_CASE("SlabPrefetcher reports reads past the end of the file", "[tensor][slab_file]") {
+    ccsd::SlabFile f("test_tensors_short.bin", 4);
+    const std::vector<double> one(4, 1.0);
+    f.write(0, 1, one.data());
+    ccsd::SlabPrefetcher stream(f, 2);
+    stream.prefetch(0, 2);
+    REQUIRE_THROWS_WITH(stream.wait(), "test_tensors_short.bin: read past end of file");
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+
+#include <util/tensors/layout.h>
+#include <util/tensors/tensor_view.h>
+
+namespace ccsd {
+
+namespace detail {
+
+// Boxes at or below this many elements are copied directly: source and
+// destination lines of such a box stay in L1 together.
+inline constexpr std::ptrdiff_t transpose_block = 1024;
+
+// `put(t, s)` stores source element s into destination element t.
+template <std::size_t Rank, class Put>
+void transpose_box(const TensorView<Rank>& src, double* dst, const std::array<std::ptrdiff_t, Rank>& dst_strides,
+                   std::array<int, Rank> lo, std::array<int, Rank> hi, const Put& put) {
+    std::ptrdiff_t volume = 1;
+    std::size_t widest = 0;
+    for (std::size_t d = 0; d < Rank; ++d) {
+        volume *= hi[d] - lo[d];
+        if (hi[d] - lo[d] > hi[widest] - lo[widest]) widest = d;
+    }
+    if (volume == 0) return;
+    if (volume > transpose_block && hi[widest] - lo[widest] > 1) {
+        // Halve the longest edge: every level of the recursion fits some
+        // cache level, whatever the strides on either side.
+        const int mid = lo[widest] + (hi[widest] - lo[widest]) / 2;
+        auto hi_left = hi, lo_right = lo;
+        hi_left[widest]  = mid;
+        lo_right[widest] = mid;
+        transpose_box(src, dst, dst_strides, lo, hi_left, put);
+        transpose_box(src, dst, dst_strides, lo_right, hi, put);
+        return;
+    }
+
+    // Destination's unit-stride dimension innermost, the rest as an odometer.
+    std::size_t inner = 0;
+    for (std::size_t d = 1; d < Rank; ++d)
+        if (std::abs(dst_strides[d]) < std::abs(dst_strides[inner])) inner = d;
+    const std::ptrdiff_t s_in = src.strides[inner], d_in = dst_strides[inner];
+    const int n_in = hi[inner] - lo[inner];
+    std::array<int, Rank> idx = lo;
+    for (;;) {
+        std::ptrdiff_t s_off = 0, d_off = 0;
+        for (std::size_t d = 0; d < Rank; ++d) {
+            s_off += idx[d] * src.strides[d];
+            d_off += idx[d] * dst_strides[d];
+        }
+        const double* s = src.data + s_off;
+        double* t = dst + d_off;
+        for (int x = 0; x < n_in; ++x) put(t[x * d_in], s[x * s_in]);
+
+        std::size_t d = 0;
+        for (; d < Rank; ++d) {
+            if (d == inner) continue;
+            if (++idx[d] < hi[d]) break;
+            idx[d] = lo[d];
+        }
+        if (d == Rank) return;
+    }
+}
+
+}  // namespace detail
+
+// Copies every element of `src` into `dst`, addressed with dst_strides
+// (elements, relative to dst): a general index permutation / relayout.
+// Cache-oblivious: the index box is halved along its longest edge until a
+// block fits in L1, so neither side is walked at a large stride for long.
+template <std::size_t Rank>
+void transpose(const TensorView<Rank>& src, double* dst, const std::array<std::ptrdiff_t, Rank>& dst_strides) {
+    detail::transpose_box(src, dst, dst_strides, std::array<int, Rank>{}, src.extents,
+                          [](double& t, double s) { t = s; });
+}
+
+// The same, accumulating: dst += alpha · src.
+template <std::size_t Rank>
+void transpose_add(const TensorView<Rank>& src, double alpha, double* dst,
+                   const std::array<std::ptrdiff_t, Rank>& dst_strides) {
+    detail::transpose_box(src, dst, dst_strides, std::array<int, Rank>{}, src.extents,
+                          [alpha](double& t, double s) { t += alpha * s; });
+}
+
+// `src` repacked densely in `layout`.
+template <std::size_t Rank>
+std::vector<double> transpose(const TensorView<Rank>& src, const Layout<Rank>& layout) {
+    std::size_t n = 1;
+    for (int e : src.extents) n *= static_cast<std::size_t>(e);
+    std::vector<double> out(n);
+    transpose(src, out.data(), layout.strides(src.extents));
+    return out;
+}
+
+}  // namespace ccsd
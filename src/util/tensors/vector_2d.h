@@ -6,6 +6,10 @@
 #include <iostream>
 #include <vector>
 
+#include <util/tensors/layout.h>
+#include <util/tensors/tensor_view.h>
+#include <util/tensors/transpose.h>
+
 namespace ccsd {
 
 class Vector2D {
@@ -14,11 +18,29 @@ public:
 
     Vector2D() = default;
 
-    void initialization(int dim2) {
+    // Element count initialization(dim2) will allocate.
+    [[nodiscard]] static std::size_t elements_for(int dim2) {
+        return static_cast<std::size_t>(dim2) * static_cast<std::size_t>(dim2);
+    }
+
+    // `layout` defaults to the build-wide order (Layout<2>::standard()).
+    void initialization(int dim2, const Layout<2>& layout = Layout<2>::standard()) {
         n1_ = dim2;
         n2_ = dim2;
-        n_size_ = n1_ * n2_;
-        data_.assign(static_cast<std::size_t>(n_size_), 0.0);
+        n_size_ = elements_for(dim2);
+        set_strides(layout);
+        data_.assign(n_size_, 0.0);
+    }
+
+    [[nodiscard]] const Layout<2>& layout() const noexcept { return layout_; }
+
+    // Re-stores the current contents in `layout` (one blocked transpose).
+    void relayout(const Layout<2>& layout) {
+        if (layout == layout_) return;
+        std::vector<double> next(n_size_);
+        transpose(view(), next.data(), layout.strides({n1_, n2_}));
+        data_.swap(next);
+        set_strides(layout);
     }
 
     void zeros() { std::fill(data_.begin(), data_.end(), 0.0); }
@@ -42,10 +64,16 @@ public:
 
     [[nodiscard]] int n1() const noexcept { return n1_; }
     [[nodiscard]] int n2() const noexcept { return n2_; }
-    [[nodiscard]] int n_size() const noexcept { return n_size_; }
+    [[nodiscard]] std::size_t n_size() const noexcept { return n_size_; }
     [[nodiscard]] double* raw() noexcept { return data_.data(); }
     [[nodiscard]] const double* raw() const noexcept { return data_.data(); }
 
+    // Read-only view in this tensor's layout; valid until the next
+    // initialization() or relayout().
+    [[nodiscard]] TensorView<2> view() const noexcept {
+        return {data_.data(), {n1_, n2_}, {s1_, s2_}};
+    }
+
     friend std::ostream& operator<<(std::ostream& os, const Vector2D& v) {
         os << "[\n";
         for (int i = 0; i < v.n1_; ++i) {
@@ -58,17 +86,21 @@ public:
     }
 
 private:
+    // Runtime strides for every layout (see Vector4D::index).
     [[nodiscard]] std::size_t index(int i, int j) const noexcept {
-#ifdef CCSD_LAYOUT_ROW_MAJOR
-        return static_cast<std::size_t>(i) * static_cast<std::size_t>(n2_)
-             + static_cast<std::size_t>(j);
-#else
-        return static_cast<std::size_t>(j) * static_cast<std::size_t>(n1_)
-             + static_cast<std::size_t>(i);
-#endif
+        return static_cast<std::size_t>(i * s1_ + j * s2_);
+    }
+
+    void set_strides(const Layout<2>& layout) noexcept {
+        layout_ = layout;
+        const auto s = layout.strides({n1_, n2_});
+        s1_ = s[0]; s2_ = s[1];
     }
 
-    int n1_ = 0, n2_ = 0, n_size_ = 0;
+    int n1_ = 0, n2_ = 0;
+    std::ptrdiff_t s1_ = 0, s2_ = 0;
+    Layout<2> layout_ = Layout<2>::standard();
+    std::size_t n_size_ = 0;
     std::vector<double> data_;
 };
 
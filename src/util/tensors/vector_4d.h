@@ -5,6 +5,10 @@
 #include <cstddef>
 #include <vector>
 
+#include <util/tensors/layout.h>
+#include <util/tensors/tensor_view.h>
+#include <util/tensors/transpose.h>
+
 namespace ccsd {
 
 class Vector4D {
@@ -13,10 +17,30 @@ public:
 
     Vector4D() = default;
 
-    void initialization(int dim2) {
+    // Element count initialization(dim2) will allocate. 64-bit product: n^4
+    // overflows int once n passes ~215.
+    [[nodiscard]] static std::size_t elements_for(int dim2) {
+        const auto n = static_cast<std::size_t>(dim2);
+        return n * n * n * n;
+    }
+
+    // `layout` defaults to the build-wide order (Layout<4>::standard()).
+    void initialization(int dim2, const Layout<4>& layout = Layout<4>::standard()) {
         n1_ = n2_ = n3_ = n4_ = dim2;
-        n_size_ = n1_ * n2_ * n3_ * n4_;
-        data_.assign(static_cast<std::size_t>(n_size_), 0.0);
+        n_size_ = elements_for(dim2);
+        set_strides(layout);
+        data_.assign(n_size_, 0.0);
+    }
+
+    [[nodiscard]] const Layout<4>& layout() const noexcept { return layout_; }
+
+    // Re-stores the current contents in `layout` (one blocked transpose).
+    void relayout(const Layout<4>& layout) {
+        if (layout == layout_) return;
+        std::vector<double> next(n_size_);
+        transpose(view(), next.data(), layout.strides({n1_, n2_, n3_, n4_}));
+        data_.swap(next);
+        set_strides(layout);
     }
 
     void zeros() { std::fill(data_.begin(), data_.end(), 0.0); }
@@ -30,30 +54,38 @@ public:
         return data_[index(i, j, k, l)];
     }
 
-    [[nodiscard]] int n_size() const noexcept { return n_size_; }
+    [[nodiscard]] std::size_t n_size() const noexcept { return n_size_; }
+    // Flat storage offset of (i,j,k,l) under this tensor's layout.
+    [[nodiscard]] std::size_t offset(int i, int j, int k, int l) const noexcept {
+        return index(i, j, k, l);
+    }
     [[nodiscard]] double* raw() noexcept { return data_.data(); }
     [[nodiscard]] const double* raw() const noexcept { return data_.data(); }
 
+    // Read-only view in this tensor's layout; valid until the next
+    // initialization() or relayout(). view().sub(...) gives strided sub-views.
+    [[nodiscard]] TensorView<4> view() const noexcept {
+        return {data_.data(), {n1_, n2_, n3_, n4_}, {s1_, s2_, s3_, s4_}};
+    }
+
 private:
+    // Runtime strides for every layout: measured as fast as the former
+    // compile-time row/column-major index on the CCSD kernels, while a
+    // per-access branch between the two was slower than either.
     [[nodiscard]] std::size_t index(int i, int j, int k, int l) const noexcept {
-        [[maybe_unused]] const auto N1 = static_cast<std::size_t>(n1_);
-        const auto N2 = static_cast<std::size_t>(n2_);
-        const auto N3 = static_cast<std::size_t>(n3_);
-        [[maybe_unused]] const auto N4 = static_cast<std::size_t>(n4_);
-#ifdef CCSD_LAYOUT_ROW_MAJOR
-        return ((static_cast<std::size_t>(i) * N2
-               + static_cast<std::size_t>(j)) * N3
-               + static_cast<std::size_t>(k)) * N4
-               + static_cast<std::size_t>(l);
-#else
-        return static_cast<std::size_t>(l) * N1 * N2 * N3
-             + static_cast<std::size_t>(k) * N1 * N2
-             + static_cast<std::size_t>(j) * N1
-             + static_cast<std::size_t>(i);
-#endif
+        return static_cast<std::size_t>(i * s1_ + j * s2_ + k * s3_ + l * s4_);
+    }
+
+    void set_strides(const Layout<4>& layout) noexcept {
+        layout_ = layout;
+        const auto s = layout.strides({n1_, n2_, n3_, n4_});
+        s1_ = s[0]; s2_ = s[1]; s3_ = s[2]; s4_ = s[3];
     }
 
-    int n1_ = 0, n2_ = 0, n3_ = 0, n4_ = 0, n_size_ = 0;
+    int n1_ = 0, n2_ = 0, n3_ = 0, n4_ = 0;
+    std::ptrdiff_t s1_ = 0, s2_ = 0, s3_ = 0, s4_ = 0;
+    Layout<4> layout_ = Layout<4>::standard();
+    std::size_t n_size_ = 0;
     std::vector<double> data_;
 };
 
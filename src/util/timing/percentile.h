@@ -1,5 +1,7 @@
 #pragma once
 
+#include <util/timing/stats.h>
+
 #include <algorithm>
 #include <chrono>
 #include <cmath>
@@ -22,12 +24,22 @@ public:
 
     void start() { t0_ = clock::now(); }
 
+    // Samples are stored in microseconds but measured at nanosecond
+    // resolution, so sub-microsecond phases are not truncated to zero.
     void stop() {
         auto t1 = clock::now();
-        auto us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0_).count();
-        samples_.push_back(static_cast<double>(us));
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0_).count();
+        samples_.push_back(static_cast<double>(ns) / 1.0e3);
     }
 
+    // Records an externally measured duration (microseconds).
+    void record(double us) { samples_.push_back(us); }
+
+    [[nodiscard]] const std::vector<double>& samples() const noexcept { return samples_; }
+    [[nodiscard]] std::vector<double>& samples() noexcept { return samples_; }
+
+    [[nodiscard]] SampleStats summary() const { return summarize(samples_); }
+
     [[nodiscard]] std::size_t count() const noexcept { return samples_.size(); }
 
     [[nodiscard]] double mean() const {
@@ -67,11 +79,7 @@ public:
 
 private:
     static double percentile_of_sorted(const std::vector<double>& sorted, double p) {
-        // Nearest-rank percentile: idx = ceil(p * n) - 1, clamped to [0, n-1].
-        auto idx = static_cast<std::size_t>(std::ceil(p * static_cast<double>(sorted.size())));
-        if (idx > 0) --idx;
-        if (idx >= sorted.size()) idx = sorted.size() - 1;
-        return sorted[idx];
+        return nearest_rank(sorted, p);
     }
 
     time_point          t0_{};
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#ifdef __linux__
+#include <filesystem>
+#include <system_error>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ccsd::timing {
+
+// Hardware counter readings (deltas or totals). fp_ops is only populated when
+// a raw FP event is configured; it has no portable generic perf event.
+struct PerfSample {
+    std::uint64_t cycles       = 0;
+    std::uint64_t instructions = 0;
+    std::uint64_t llc_misses   = 0;
+    std::uint64_t fp_ops       = 0;
+
+    PerfSample& operator+=(const PerfSample& o) {
+        cycles += o.cycles;  instructions += o.instructions;
+        llc_misses += o.llc_misses;  fp_ops += o.fp_ops;
+        return *this;
+    }
+    friend PerfSample operator-(PerfSample a, const PerfSample& b) {
+        a.cycles -= b.cycles;  a.instructions -= b.instructions;
+        a.llc_misses -= b.llc_misses;  a.fp_ops -= b.fp_ops;
+        return a;
+    }
+};
+
+// Per-process counters via perf_event_open(2), user space only. Counted
+// threads: every thread of the process alive when the counters are opened
+// (one counter set per thread, listed from /proc/self/task), plus every
+// thread those create afterwards (inherited). So an OpenMP pool is counted
+// whether it was started before the counters (e.g. by a warmup run) or
+// after; read() sums over all of them. Opening fails quietly when the
+// kernel forbids it (perf_event_paranoid, containers, non-Linux);
+// available() then reports false and read() returns zeros.
+//
+// FP ops: set CCSD_PERF_FP_EVENT to a raw PMU event code (hex), e.g. 0x01c7
+// for FP_ARITH_INST_RETIRED.SCALAR_DOUBLE on Skylake and later.
+class PerfCounters {
+public:
+    PerfCounters() {
+#ifdef __linux__
+        const char* raw = std::getenv("CCSD_PERF_FP_EVENT");
+        for (const pid_t tid : threads()) {
+            Fds& fds = fds_.emplace_back();
+            fds.fill(-1);
+            fds[0] = open(tid, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+            fds[1] = open(tid, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+            fds[2] = open(tid, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+            if (raw) fds[3] = open(tid, PERF_TYPE_RAW, std::strtoull(raw, nullptr, 16));
+            for (int fd : fds)
+                if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (const Fds& fds : fds_)
+            for (int fd : fds)
+                if (fd >= 0) close(fd);
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    PerfCounters(PerfCounters&&) = delete;
+    PerfCounters& operator=(PerfCounters&&) = delete;
+
+    // True once the calling thread's cycle counter is open (the first set
+    // is the caller's own, see threads()).
+    [[nodiscard]] bool available() const noexcept { return !fds_.empty() && fds_.front()[0] >= 0; }
+    [[nodiscard]] bool has_fp_ops() const noexcept { return !fds_.empty() && fds_.front()[3] >= 0; }
+
+    [[nodiscard]] PerfSample read() const {
+        PerfSample s;
+        for (const Fds& fds : fds_) {
+            s.cycles       += value(fds[0]);
+            s.instructions += value(fds[1]);
+            s.llc_misses   += value(fds[2]);
+            s.fp_ops       += value(fds[3]);
+        }
+        return s;
+    }
+
+private:
+    using Fds = std::array<int, 4>;   // cycles, instructions, LLC misses, FP ops
+    std::vector<Fds> fds_;            // one set per thread counted at open
+
+#ifdef __linux__
+    // The calling thread first, then every other live thread of the process.
+    static std::vector<pid_t> threads() {
+        const auto self = static_cast<pid_t>(syscall(SYS_gettid));
+        std::vector<pid_t> tids{self};
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+            const auto tid = static_cast<pid_t>(std::strtol(entry.path().filename().c_str(), nullptr, 10));
+            if (tid > 0 && tid != self) tids.push_back(tid);
+        }
+        return tids;
+    }
+
+    static int open(pid_t tid, std::uint32_t type, std::uint64_t config) {
+        perf_event_attr attr{};
+        attr.size           = sizeof(attr);
+        attr.type           = type;
+        attr.config         = config;
+        attr.disabled       = 1;
+        attr.inherit        = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0));
+    }
+#endif
+
+    static std::uint64_t value([[maybe_unused]] int fd) {
+        std::uint64_t v = 0;
+#ifdef __linux__
+        if (fd >= 0 && ::read(fd, &v, sizeof(v)) != static_cast<ssize_t>(sizeof(v))) v = 0;
+#endif
+        return v;
+    }
+};
+
+}  // namespace ccsd::timing
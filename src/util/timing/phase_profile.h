@@ -0,0 +1,98 @@
+#pragma once
+
+#include <util/timing/percentile.h>
+#include <util/timing/perf_counters.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ccsd::timing {
+
+// Per-phase wall time over repeated runs. Within one run (begin_run ..
+// end_run) every ScopedPhase adds into the phase's running total; end_run
+// then records one sample (microseconds) per phase.
+//
+// Optionally, hardware counters (enable_counters) and analytic flop counts
+// (ScopedPhase's `work`) are accumulated per phase over all runs.
+class PhaseProfile {
+public:
+    explicit PhaseProfile(std::vector<std::string> names)
+        : names_(std::move(names)), run_ns_(names_.size(), 0), phases_(names_.size()),
+          hw_(names_.size()), work_(names_.size(), 0.0) {}
+
+    // Opens the perf counters; returns false (and stays timing-only) when the
+    // kernel does not grant access.
+    bool enable_counters() {
+        counters_ = std::make_unique<PerfCounters>();
+        if (!counters_->available()) counters_.reset();
+        return counters_ != nullptr;
+    }
+    [[nodiscard]] const PerfCounters* counters() const noexcept { return counters_.get(); }
+
+    void begin_run() { std::fill(run_ns_.begin(), run_ns_.end(), 0); }
+
+    void add(std::size_t phase, std::chrono::nanoseconds d) { run_ns_[phase] += d.count(); }
+    void add_counters(std::size_t phase, const PerfSample& delta) { hw_[phase] += delta; }
+    void add_work(std::size_t phase, double flops) { work_[phase] += flops; }
+
+    void end_run() {
+        for (std::size_t i = 0; i < phases_.size(); ++i)
+            phases_[i].record(static_cast<double>(run_ns_[i]) / 1.0e3);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return names_.size(); }
+    [[nodiscard]] const std::string& name(std::size_t i) const { return names_[i]; }
+    [[nodiscard]] const PercentileAccumulator& phase(std::size_t i) const { return phases_[i]; }
+    [[nodiscard]] PercentileAccumulator& phase(std::size_t i) { return phases_[i]; }
+    [[nodiscard]] const PerfSample& hw(std::size_t i) const { return hw_[i]; }
+    [[nodiscard]] double work(std::size_t i) const { return work_[i]; }
+
+private:
+    std::vector<std::string>           names_;
+    std::vector<long long>             run_ns_;
+    std::vector<PercentileAccumulator> phases_;
+    std::vector<PerfSample>            hw_;
+    std::vector<double>                work_;
+    std::unique_ptr<PerfCounters>      counters_;
+};
+
+// RAII: adds the scope's duration, counter deltas, and `work` flops to
+// `phase` of `profile`. A null profile makes this a no-op, so instrumented
+// code costs nothing when not profiled.
+class ScopedPhase {
+public:
+    using clock = std::chrono::steady_clock;
+
+    ScopedPhase(PhaseProfile* profile, std::size_t phase, double work = 0.0)
+        : profile_(profile), phase_(phase), work_(work) {
+        if (!profile_) return;
+        if (const auto* pc = profile_->counters()) hw0_ = pc->read();
+        t0_ = clock::now();
+    }
+
+    ~ScopedPhase() {
+        if (!profile_) return;
+        profile_->add(phase_, std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0_));
+        if (const auto* pc = profile_->counters()) profile_->add_counters(phase_, pc->read() - hw0_);
+        profile_->add_work(phase_, work_);
+    }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+    ScopedPhase(ScopedPhase&&) = delete;
+    ScopedPhase& operator=(ScopedPhase&&) = delete;
+
+private:
+    PhaseProfile*     profile_;
+    std::size_t       phase_;
+    double            work_;
+    PerfSample        hw0_{};
+    clock::time_point t0_{};
+};
+
+}  // namespace ccsd::timing
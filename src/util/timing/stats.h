@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace ccsd::timing {
+
+// Robust summary of a timing sample. The median CI is distribution-free
+// (binomial order statistics), so it holds for the skewed, heavy-tailed
+// distributions that wall-clock samples usually have.
+struct SampleStats {
+    std::size_t count    = 0;
+    double      mean     = 0.0;
+    double      stddev   = 0.0;   // sample standard deviation (n-1)
+    double      min      = 0.0;
+    double      max      = 0.0;
+    double      p50      = 0.0;
+    double      p99      = 0.0;
+    double      ci95_lo  = 0.0;   // 95% confidence interval of the median
+    double      ci95_hi  = 0.0;
+    std::size_t outliers = 0;     // outside Tukey fences [Q1 - 1.5 IQR, Q3 + 1.5 IQR]
+};
+
+// Nearest-rank percentile of an ascending sample: idx = ceil(p * n) - 1.
+inline double nearest_rank(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    auto idx = static_cast<std::size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    if (idx > 0) --idx;
+    if (idx >= sorted.size()) idx = sorted.size() - 1;
+    return sorted[idx];
+}
+
+inline SampleStats summarize(std::vector<double> samples) {
+    SampleStats s{};
+    s.count = samples.size();
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    const auto n = static_cast<double>(samples.size());
+
+    double sum = 0.0;
+    for (double v : samples) sum += v;
+    s.mean = sum / n;
+    double sq = 0.0;
+    for (double v : samples) sq += (v - s.mean) * (v - s.mean);
+    s.stddev = samples.size() > 1 ? std::sqrt(sq / (n - 1.0)) : 0.0;
+
+    s.min = samples.front();
+    s.max = samples.back();
+    s.p50 = nearest_rank(samples, 0.50);
+    s.p99 = nearest_rank(samples, 0.99);
+
+    // Ranks n/2 ∓ 1.96·√n/2 (normal approximation to Binomial(n, 1/2)).
+    const double half = 1.96 * std::sqrt(n) / 2.0;
+    const auto lo = static_cast<std::ptrdiff_t>(std::floor(n / 2.0 - half));
+    const auto hi = static_cast<std::ptrdiff_t>(std::ceil(n / 2.0 + half));
+    const auto last = static_cast<std::ptrdiff_t>(samples.size()) - 1;
+    s.ci95_lo = samples[static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(lo, 0, last))];
+    s.ci95_hi = samples[static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(hi, 0, last))];
+
+    const double q1  = nearest_rank(samples, 0.25);
+    const double q3  = nearest_rank(samples, 0.75);
+    const double iqr = q3 - q1;
+    for (double v : samples)
+        if (v < q1 - 1.5 * iqr || v > q3 + 1.5 * iqr) ++s.outliers;
+    return s;
+}
+
+}  // namespace ccsd::timing
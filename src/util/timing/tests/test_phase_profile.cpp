@@ -0,0 +1,41 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <util/timing/phase_profile.h>
+
+TEST_CASE("ScopedPhase accumulates time and work into one sample per run", "[timing]") {
+    ccsd::timing::PhaseProfile prof({"a", "b"});
+    prof.begin_run();
+    { ccsd::timing::ScopedPhase t(&prof, 0, 10.0); }
+    { ccsd::timing::ScopedPhase t(&prof, 0, 5.0); }
+    { ccsd::timing::ScopedPhase t(&prof, 1); }
+    prof.end_run();
+
+    REQUIRE(prof.phase(0).samples().size() == 1);
+    REQUIRE(prof.phase(1).samples().size() == 1);
+    REQUIRE(prof.work(0) == 15.0);
+    REQUIRE(prof.work(1) == 0.0);
+}
+
+TEST_CASE("ScopedPhase with a null profile is a no-op", "[timing]") {
+    ccsd::timing::ScopedPhase t(nullptr, 3, 1.0);
+    SUCCEED();
+}
+
+TEST_CASE("enable_counters degrades to timing-only when perf is unavailable", "[timing]") {
+    ccsd::timing::PhaseProfile prof({"a"});
+    const bool on = prof.enable_counters();
+    REQUIRE(on == (prof.counters() != nullptr));
+
+    prof.begin_run();
+    {
+        ccsd::timing::ScopedPhase t(&prof, 0);
+        volatile double x = 0.0;
+        for (int i = 0; i < 100000; ++i) x = x + 1.0;
+    }
+    prof.end_run();
+    if (on) {
+        REQUIRE(prof.hw(0).instructions > 0);
+    } else {
+        REQUIRE(prof.hw(0).cycles == 0);
+    }
+}
@@ -0,0 +1,60 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <util/timing/phase_profile.h>
+#include <util/timing/stats.h>
+
+#include <chrono>
+#include <vector>
+
+using Catch::Approx;
+
+TEST_CASE("summarize of an empty sample is all zeros", "[stats]") {
+    auto s = ccsd::timing::summarize({});
+    REQUIRE(s.count == 0);
+    REQUIRE(s.p50 == 0.0);
+    REQUIRE(s.outliers == 0);
+}
+
+TEST_CASE("summarize computes mean, stddev and median", "[stats]") {
+    auto s = ccsd::timing::summarize({4.0, 1.0, 3.0, 2.0, 5.0});
+    REQUIRE(s.count == 5);
+    REQUIRE(s.mean == Approx(3.0));
+    REQUIRE(s.stddev == Approx(1.5811388301));
+    REQUIRE(s.p50 == 3.0);
+    REQUIRE(s.min == 1.0);
+    REQUIRE(s.max == 5.0);
+}
+
+TEST_CASE("median CI brackets the median and narrows with more samples", "[stats]") {
+    std::vector<double> small, large;
+    for (int i = 0; i < 20; ++i)   small.push_back(static_cast<double>(i % 10));
+    for (int i = 0; i < 2000; ++i) large.push_back(static_cast<double>(i % 10));
+    auto a = ccsd::timing::summarize(small);
+    auto b = ccsd::timing::summarize(large);
+    REQUIRE(a.ci95_lo <= a.p50);
+    REQUIRE(a.ci95_hi >= a.p50);
+    REQUIRE(b.ci95_hi - b.ci95_lo <= a.ci95_hi - a.ci95_lo);
+}
+
+TEST_CASE("Tukey fences flag a single far outlier", "[stats]") {
+    std::vector<double> v(50, 10.0);
+    for (std::size_t i = 0; i < v.size(); ++i) v[i] += static_cast<double>(i % 5) * 0.1;
+    v.push_back(1000.0);
+    REQUIRE(ccsd::timing::summarize(v).outliers == 1);
+}
+
+TEST_CASE("PhaseProfile records one summed sample per phase per run", "[stats][phase]") {
+    ccsd::timing::PhaseProfile profile({"a", "b"});
+    for (int run = 0; run < 3; ++run) {
+        profile.begin_run();
+        profile.add(0, std::chrono::microseconds(2));
+        profile.add(0, std::chrono::microseconds(3));
+        { ccsd::timing::ScopedPhase t(&profile, 1); }
+        profile.end_run();
+    }
+    REQUIRE(profile.phase(0).count() == 3);
+    REQUIRE(profile.phase(0).samples()[2] == Approx(5.0));
+    REQUIRE(profile.phase(1).count() == 3);
+    REQUIRE(profile.phase(1).samples()[0] >= 0.0);
+}
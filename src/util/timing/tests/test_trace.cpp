@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <util/timing/trace.h>
+
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ccsd::timing::ScopedTrace;
+using ccsd::timing::TraceCategory;
+using ccsd::timing::TraceRecorder;
+
+TEST_CASE("ScopedTrace records one event per scope, oldest first", "[trace]") {
+    TraceRecorder rec(8);
+    { ScopedTrace t(&rec, "a"); }
+    { ScopedTrace t(&rec, "b", TraceCategory::comm); }
+
+    const auto ev = rec.events();
+    REQUIRE(ev.size() == 2);
+    REQUIRE(std::string(ev[0].name) == "a");
+    REQUIRE(ev[1].category == TraceCategory::comm);
+    REQUIRE(ev[0].begin_ns <= ev[0].end_ns);
+    REQUIRE(ev[0].end_ns <= ev[1].begin_ns);
+    REQUIRE(rec.dropped() == 0);
+}
+
+TEST_CASE("ScopedTrace with a null recorder is a no-op", "[trace]") {
+    ScopedTrace t(nullptr, "x");
+    SUCCEED();
+}
+
+TEST_CASE("TraceRecorder keeps the newest events once the ring wraps", "[trace]") {
+    static const char* names[] = {"0", "1", "2", "3", "4", "5"};
+    TraceRecorder rec(4);
+    for (const char* n : names) { ScopedTrace t(&rec, n); }
+
+    const auto ev = rec.events();
+    REQUIRE(ev.size() == 4);
+    REQUIRE(std::string(ev.front().name) == "2");
+    REQUIRE(std::string(ev.back().name) == "5");
+    REQUIRE(rec.dropped() == 2);
+    rec.clear();
+    REQUIRE(rec.events().empty());
+}
+
+TEST_CASE("TraceRecorder takes events from several threads without a lock", "[trace]") {
+    TraceRecorder rec(4096);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&] { for (int i = 0; i < 500; ++i) { ScopedTrace s(&rec, "w"); } });
+    for (auto& t : threads) t.join();
+
+    const auto ev = rec.events();
+    REQUIRE(ev.size() == 2000);
+    std::set<unsigned> tids;
+    for (const auto& e : ev) tids.insert(e.thread);
+    REQUIRE(tids.size() == 4);
+}
+
+TEST_CASE("chrome_trace_events writes complete events in microseconds", "[trace]") {
+    const std::vector<ccsd::timing::TraceEvent> ev{{"t2", TraceCategory::compute, 1, 3000, 5500}};
+    const std::string s = ccsd::timing::chrome_trace_events(ev, 2, 1000);
+    REQUIRE(s.find("\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 2") != std::string::npos);
+    REQUIRE(s.find("{\"name\": \"t2\", \"cat\": \"compute\", \"ph\": \"X\", \"pid\": 2, \"tid\": 1, "
+                   "\"ts\": 2.000, \"dur\": 2.500},\n") != std::string::npos);
+}
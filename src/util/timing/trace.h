@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace ccsd::timing {
+
+enum class TraceCategory : std::uint8_t { compute, comm, io };
+
+inline const char* category_name(TraceCategory c) noexcept {
+    switch (c) {
+        case TraceCategory::compute: return "compute";
+        case TraceCategory::comm:    return "comm";
+        case TraceCategory::io:      return "io";
+    }
+    return "?";
+}
+
+// One timed scope. `name` must have static storage (a literal or a name
+// table): only the pointer is recorded.
+struct TraceEvent {
+    const char*   name     = nullptr;
+    TraceCategory category = TraceCategory::compute;
+    std::uint32_t thread   = 0;
+    std::int64_t  begin_ns = 0;   // TraceRecorder::ns: steady_clock, in ns
+    std::int64_t  end_ns   = 0;
+};
+
+// Fixed-capacity event log for one rank. record() is wait-free: a writer
+// claims its slot with a single fetch_add and fills it, so the solver thread,
+// OpenMP workers and the I/O thread can all record without a lock. Past
+// `capacity` events the oldest are overwritten (dropped() counts them), so
+// memory stays bounded on long runs. events() reads the ring and must only
+// be called while nobody is recording (after the run).
+class TraceRecorder {
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit TraceRecorder(std::size_t capacity = std::size_t{1} << 16)
+        : ring_(std::max<std::size_t>(capacity, 1)) {}
+
+    void record(const char* name, TraceCategory category,
+                clock::time_point begin, clock::time_point end) noexcept {
+        const std::uint64_t n = next_.fetch_add(1, std::memory_order_relaxed);
+        TraceEvent& e = ring_[static_cast<std::size_t>(n % ring_.size())];
+        e.name     = name;
+        e.category = category;
+        e.thread   = thread_index();
+        e.begin_ns = ns(begin);
+        e.end_ns   = ns(end);
+    }
+
+    // Recorded events, oldest first.
+    [[nodiscard]] std::vector<TraceEvent> events() const {
+        const std::uint64_t n = next_.load(std::memory_order_acquire);
+        const std::uint64_t cap = ring_.size();
+        std::vector<TraceEvent> out;
+        out.reserve(static_cast<std::size_t>(std::min(n, cap)));
+        for (std::uint64_t k = n > cap ? n - cap : 0; k < n; ++k)
+            out.push_back(ring_[static_cast<std::size_t>(k % cap)]);
+        return out;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return ring_.size(); }
+    [[nodiscard]] std::size_t dropped() const noexcept {
+        const std::uint64_t n = next_.load(std::memory_order_acquire);
+        return n > ring_.size() ? static_cast<std::size_t>(n - ring_.size()) : 0;
+    }
+    void clear() noexcept { next_.store(0, std::memory_order_release); }
+
+    [[nodiscard]] static std::int64_t ns(clock::time_point t) noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    }
+
+    // Small per-thread id (0 for the first thread that records, ...).
+    [[nodiscard]] static std::uint32_t thread_index() noexcept {
+        static std::atomic<std::uint32_t> next_thread{0};
+        thread_local const std::uint32_t id = next_thread.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+private:
+    std::vector<TraceEvent>    ring_;
+    std::atomic<std::uint64_t> next_{0};
+};
+
+// RAII: records the scope into `trace`; a null recorder makes it a no-op.
+class ScopedTrace {
+public:
+    ScopedTrace(TraceRecorder* trace, const char* name, TraceCategory category = TraceCategory::compute)
+        : trace_(trace), name_(name), category_(category) {
+        if (trace_) t0_ = TraceRecorder::clock::now();
+    }
+    ~ScopedTrace() {
+        if (trace_) trace_->record(name_, category_, t0_, TraceRecorder::clock::now());
+    }
+
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+    ScopedTrace(ScopedTrace&&) = delete;
+    ScopedTrace& operator=(ScopedTrace&&) = delete;
+
+private:
+    TraceRecorder*                trace_;
+    const char*                   name_;
+    TraceCategory                 category_;
+    TraceRecorder::clock::time_point t0_{};
+};
+
+// Chrome trace / Perfetto "complete" events for `events`, one JSON object
+// per line, each followed by ",\n": pid = `pid` (the rank), tid = recording
+// thread, ts/dur in microseconds from `origin_ns` (TraceRecorder::ns).
+// Preceded by a process_name record so viewers label the row "rank <pid>".
+inline std::string chrome_trace_events(const std::vector<TraceEvent>& events, int pid, std::int64_t origin_ns) {
+    std::string out;
+    char line[256];
+    std::snprintf(line, sizeof line,
+                  "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %d, \"args\": {\"name\": \"rank %d\"}},\n",
+                  pid, pid);
+    out += line;
+    for (const TraceEvent& e : events) {
+        std::snprintf(line, sizeof line,
+                      "{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"pid\": %d, \"tid\": %u, "
+                      "\"ts\": %.3f, \"dur\": %.3f},\n",
+                      e.name ? e.name : "?", category_name(e.category), pid, e.thread,
+                      static_cast<double>(e.begin_ns - origin_ns) / 1.0e3,
+                      static_cast<double>(e.end_ns - e.begin_ns) / 1.0e3);
+        out += line;
+    }
+    return out;
+}
+
+}  // namespace ccsd::timing